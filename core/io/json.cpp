@@ -32,6 +32,7 @@
 
 #include "core/config/engine.h"
 #include "core/string/print_string.h"
+#include "core/string/string_builder.h"
 
 const char *JSON::tk_name[TK_MAX] = {
 	"'{'",
@@ -46,38 +47,42 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-String JSON::_make_indent(const String &p_indent, int p_size) {
-	return p_indent.repeat(p_size);
+void JSON::_append_indent(StringBuilder &r_builder, const String &p_indent, int p_size) {
+	for (int i = 0; i < p_size; i++) {
+		r_builder.append(p_indent);
+	}
 }
 
-String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
-	ERR_FAIL_COND_V_MSG(p_cur_indent > Variant::MAX_RECURSION_DEPTH, "...", "JSON structure is too deep. Bailing.");
-
-	String colon = ":";
-	String end_statement = "";
-
-	if (!p_indent.is_empty()) {
-		colon += " ";
-		end_statement += "\n";
+void JSON::_stringify(StringBuilder &r_builder, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
+	if (p_cur_indent > Variant::MAX_RECURSION_DEPTH) {
+		r_builder.append("...");
+		ERR_FAIL_MSG("JSON structure is too deep. Bailing.");
 	}
 
+	const char *colon = p_indent.is_empty() ? ":" : ": ";
+	const char *end_statement = p_indent.is_empty() ? "" : "\n";
+
 	switch (p_var.get_type()) {
 		case Variant::NIL:
-			return "null";
+			r_builder.append("null");
+			return;
 		case Variant::BOOL:
-			return p_var.operator bool() ? "true" : "false";
+			r_builder.append(p_var.operator bool() ? "true" : "false");
+			return;
 		case Variant::INT:
-			return itos(p_var);
+			r_builder.append(itos(p_var));
+			return;
 		case Variant::FLOAT: {
 			double num = p_var;
 			if (p_full_precision) {
 				// Store unreliable digits (17) instead of just reliable
 				// digits (14) so that the value can be decoded exactly.
-				return String::num(num, 17 - (int)floor(log10(num)));
+				r_builder.append(String::num(num, 17 - (int)floor(log10(num))));
 			} else {
 				// Store only reliable digits (14) by default.
-				return String::num(num, 14 - (int)floor(log10(num)));
+				r_builder.append(String::num(num, 14 - (int)floor(log10(num))));
 			}
+			return;
 		}
 		case Variant::PACKED_INT32_ARRAY:
 		case Variant::PACKED_INT64_ARRAY:
@@ -87,33 +92,45 @@ String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_
 		case Variant::ARRAY: {
 			Array a = p_var;
 			if (a.size() == 0) {
-				return "[]";
+				r_builder.append("[]");
+				return;
 			}
-			String s = "[";
-			s += end_statement;
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(a.id()), "\"[...]\"", "Converting circular structure to JSON.");
+			if (p_markers.has(a.id())) {
+				r_builder.append("\"[...]\"");
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
 			p_markers.insert(a.id());
 
+			r_builder.append("[");
+			r_builder.append(end_statement);
+
 			for (int i = 0; i < a.size(); i++) {
 				if (i > 0) {
-					s += ",";
-					s += end_statement;
+					r_builder.append(",");
+					r_builder.append(end_statement);
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _stringify(a[i], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				_append_indent(r_builder, p_indent, p_cur_indent + 1);
+				_stringify(r_builder, a[i], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
 			}
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "]";
+			r_builder.append(end_statement);
+			_append_indent(r_builder, p_indent, p_cur_indent);
+			r_builder.append("]");
 			p_markers.erase(a.id());
-			return s;
+			return;
 		}
 		case Variant::DICTIONARY: {
-			String s = "{";
-			s += end_statement;
 			Dictionary d = p_var;
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(d.id()), "\"{...}\"", "Converting circular structure to JSON.");
+			if (p_markers.has(d.id())) {
+				r_builder.append("\"{...}\"");
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
 			p_markers.insert(d.id());
 
+			r_builder.append("{");
+			r_builder.append(end_statement);
+
 			List<Variant> keys;
 			d.get_key_list(&keys);
 
@@ -126,20 +143,26 @@ String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_
 				if (first_key) {
 					first_key = false;
 				} else {
-					s += ",";
-					s += end_statement;
+					r_builder.append(",");
+					r_builder.append(end_statement);
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _stringify(String(E), p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
-				s += colon;
-				s += _stringify(d[E], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				_append_indent(r_builder, p_indent, p_cur_indent + 1);
+				_stringify(r_builder, String(E), p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				r_builder.append(colon);
+				_stringify(r_builder, d[E], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
 			}
 
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "}";
+			r_builder.append(end_statement);
+			_append_indent(r_builder, p_indent, p_cur_indent);
+			r_builder.append("}");
 			p_markers.erase(d.id());
-			return s;
+			return;
 		}
 		default:
-			return "\"" + String(p_var).json_escape() + "\"";
+			r_builder.append("\"");
+			r_builder.append(String(p_var).json_escape());
+			r_builder.append("\"");
+			return;
 	}
 }
 
@@ -563,7 +586,9 @@ String JSON::stringify(const Variant &p_var, const String &p_indent, bool p_sort
 	Ref<JSON> jason;
 	jason.instantiate();
 	HashSet<const void *> markers;
-	return jason->_stringify(p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	StringBuilder builder;
+	jason->_stringify(builder, p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	return builder.as_string();
 }
 
 Variant JSON::parse_string(const String &p_json_string) {
@@ -205,6 +205,21 @@ public:
 		}
 	}
 
+	// Moves several items while taking the lock only once.
+	void move_batch(const uint32_t *p_handles, const BOUNDS *p_aabbs, uint32_t p_count) {
+		BVH_LOCKED_FUNCTION
+		for (uint32_t i = 0; i < p_count; i++) {
+			BVHHandle h;
+			h.set(p_handles[i]);
+			DEV_ASSERT(!h.is_invalid());
+			if (tree.item_move(h, p_aabbs[i])) {
+				if (USE_PAIRS) {
+					_add_changed_item(h, p_aabbs[i]);
+				}
+			}
+		}
+	}
+
 	void recheck_pairs(BVHHandle p_handle) {
 		DEV_ASSERT(!p_handle.is_invalid());
 		force_collision_check(p_handle);
@@ -312,6 +327,18 @@ public:
 		_check_for_collisions();
 	}
 
+	// expensive, rebuilds a whole tree with a better layout (see BVH_Tree::rebuild_tree)
+	void rebuild_tree(uint32_t p_tree_id, const LocalVector<BVHBuildSplit> *p_splits = nullptr, LocalVector<BVHBuildSplit> *r_splits = nullptr) {
+		BVH_LOCKED_FUNCTION
+		tree.rebuild_tree(p_tree_id, p_splits, r_splits);
+	}
+
+	// items in frozen trees are not reinserted by the trickle optimize
+	void set_tree_frozen(uint32_t p_tree_id, bool p_frozen) {
+		BVH_LOCKED_FUNCTION
+		tree.tree_set_frozen(p_tree_id, p_frozen);
+	}
+
 	// prefer calling this directly as type safe
 	void set_tree(const BVHHandle &p_handle, uint32_t p_tree_id, uint32_t p_tree_collision_mask, bool p_force_collision_check = true) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -347,19 +374,27 @@ public:
 	// cull tests
 	int cull_aabb(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
 		BVH_LOCKED_FUNCTION
-		typename BVHTREE_CLASS::CullParams params;
-
-		params.result_count_overall = 0;
-		params.result_max = p_result_max;
-		params.result_array = p_result_array;
-		params.subindex_array = p_subindex_array;
-		params.tree_collision_mask = p_tree_collision_mask;
-		params.abb.from(p_aabb);
-		params.tester = p_tester;
+		return _cull_aabb(p_aabb, p_result_array, p_result_max, p_tester, p_tree_collision_mask, p_subindex_array, nullptr);
+	}
 
-		tree.cull_aabb(params);
+	// Holds the mutex so nothing can modify the BVH, e.g. around unlocked culls run by worker threads
+	// while the locking thread waits for them.
+	void lock() {
+		if (BVH_THREAD_SAFE && _thread_safe) {
+			_mutex.lock();
+		}
+	}
+	void unlock() {
+		if (BVH_THREAD_SAFE && _thread_safe) {
+			_mutex.unlock();
+		}
+	}
 
-		return params.result_count_overall;
+	// The unlocked culls don't take the mutex, and gather hits in r_hits rather than in the tree,
+	// so any number of threads can cull at the same time. Only valid while nothing modifies the BVH,
+	// see lock().
+	int cull_aabb_unlocked(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, LocalVector<uint32_t, uint32_t, true> &r_hits, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
+		return _cull_aabb(p_aabb, p_result_array, p_result_max, p_tester, p_tree_collision_mask, p_subindex_array, &r_hits);
 	}
 
 	int cull_segment(const POINT &p_from, const POINT &p_to, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
@@ -381,6 +416,41 @@ public:
 		return params.result_count_overall;
 	}
 
+	// Culls up to SegmentPacket::MAX_SIZE segments in one traversal of the tree. Segment n writes
+	// up to p_result_max results to p_result_arrays[n], and its result count to r_result_counts[n].
+	void cull_segment_packet(const POINT *p_from, const POINT *p_to, int p_count, T ***p_result_arrays, int p_result_max, int *r_result_counts, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int **p_subindex_arrays = nullptr) {
+		BVH_LOCKED_FUNCTION
+		cull_segment_packet_unlocked(p_from, p_to, p_count, p_result_arrays, p_result_max, r_result_counts, p_tester, p_tree_collision_mask, p_subindex_arrays);
+	}
+
+	// Packets write their hits straight to the result arrays, so no hit buffer is needed.
+	void cull_segment_packet_unlocked(const POINT *p_from, const POINT *p_to, int p_count, T ***p_result_arrays, int p_result_max, int *r_result_counts, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int **p_subindex_arrays = nullptr) {
+		BVH_ASSERT(p_count > 0 && p_count <= BVHABB_CLASS::SegmentPacket::MAX_SIZE);
+		if (p_result_max <= 0) {
+			for (int n = 0; n < p_count; n++) {
+				r_result_counts[n] = 0;
+			}
+			return;
+		}
+
+		typename BVHTREE_CLASS::CullSegmentPacketParams params;
+
+		params.result_max = p_result_max;
+		for (int n = 0; n < p_count; n++) {
+			params.result_arrays[n] = p_result_arrays[n];
+			params.subindex_arrays[n] = p_subindex_arrays ? p_subindex_arrays[n] : nullptr;
+		}
+		params.tester = p_tester;
+		params.tree_collision_mask = p_tree_collision_mask;
+		params.packet.set(p_from, p_to, p_count);
+
+		tree.cull_segment_packet(params);
+
+		for (int n = 0; n < p_count; n++) {
+			r_result_counts[n] = params.result_counts[n];
+		}
+	}
+
 	int cull_point(const POINT &p_point, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
 		BVH_LOCKED_FUNCTION
 		typename BVHTREE_CLASS::CullParams params;
@@ -759,6 +829,23 @@ private:
 		tree._extra[p_handle.id()].last_updated_tick = 0;
 	}
 
+	int _cull_aabb(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask, int *p_subindex_array, LocalVector<uint32_t, uint32_t, true> *r_hits) {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.tree_collision_mask = p_tree_collision_mask;
+		params.abb.from(p_aabb);
+		params.tester = p_tester;
+		params.hits = r_hits;
+
+		tree.cull_aabb(params);
+
+		return params.result_count_overall;
+	}
+
 	PairCallback pair_callback = nullptr;
 	UnpairCallback unpair_callback = nullptr;
 	CheckPairCallback check_pair_callback = nullptr;
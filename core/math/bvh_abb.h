@@ -47,6 +47,39 @@ struct BVH_ABB {
 		POINT to;
 	};
 
+	// Several segments tested against an ABB at once. Lanes are stored as
+	// structure of arrays, with the slab test for every lane written as
+	// straight line code so the compiler can turn each axis into a single
+	// SIMD operation.
+	struct SegmentPacket {
+		enum {
+			MAX_SIZE = 4,
+		};
+
+		real_t origin[POINT::AXIS_COUNT][MAX_SIZE];
+		real_t inv_dir[POINT::AXIS_COUNT][MAX_SIZE];
+		int size = 0;
+
+		void set(const POINT *p_from, const POINT *p_to, int p_size) {
+			size = p_size;
+			for (int lane = 0; lane < MAX_SIZE; lane++) {
+				// Unused lanes repeat the first segment, their hits are masked out.
+				int src = lane < p_size ? lane : 0;
+				for (int axis = 0; axis < POINT::AXIS_COUNT; ++axis) {
+					real_t dir = p_to[src][axis] - p_from[src][axis];
+					origin[axis][lane] = p_from[src][axis];
+					// A large finite value rather than infinity, so that a zero
+					// direction multiplied by a zero distance doesn't produce NaN.
+					inv_dir[axis][lane] = dir == 0 ? (real_t)1e30 : 1 / dir;
+				}
+			}
+		}
+
+		uint32_t get_lane_mask() const {
+			return (1 << size) - 1;
+		}
+	};
+
 	enum IntersectResult {
 		IR_MISS = 0,
 		IR_PARTIAL,
@@ -202,6 +235,33 @@ struct BVH_ABB {
 		return bb.intersects_segment(p_s.from, p_s.to);
 	}
 
+	// Returns the subset of p_lanes whose segments intersect the ABB.
+	uint32_t intersects_segment_packet(const SegmentPacket &p_packet, uint32_t p_lanes) const {
+		real_t t_near[SegmentPacket::MAX_SIZE];
+		real_t t_far[SegmentPacket::MAX_SIZE];
+		for (int lane = 0; lane < SegmentPacket::MAX_SIZE; lane++) {
+			t_near[lane] = 0.0;
+			t_far[lane] = 1.0;
+		}
+
+		for (int axis = 0; axis < POINT::AXIS_COUNT; ++axis) {
+			const real_t slab_min = min[axis];
+			const real_t slab_max = -neg_max[axis];
+			for (int lane = 0; lane < SegmentPacket::MAX_SIZE; lane++) {
+				real_t t0 = (slab_min - p_packet.origin[axis][lane]) * p_packet.inv_dir[axis][lane];
+				real_t t1 = (slab_max - p_packet.origin[axis][lane]) * p_packet.inv_dir[axis][lane];
+				t_near[lane] = MAX(t_near[lane], MIN(t0, t1));
+				t_far[lane] = MIN(t_far[lane], MAX(t0, t1));
+			}
+		}
+
+		uint32_t hits = 0;
+		for (int lane = 0; lane < SegmentPacket::MAX_SIZE; lane++) {
+			hits |= (uint32_t)(t_near[lane] <= t_far[lane]) << lane;
+		}
+		return hits & p_lanes;
+	}
+
 	bool intersects_point(const POINT &p_pt) const {
 		if (_any_lessthan(-p_pt, neg_max)) {
 			return false;
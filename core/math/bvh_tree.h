@@ -47,6 +47,18 @@
 #include "core/templates/pooled_list.h"
 #include <limits.h>
 
+// Leaf bounds are tested four at a time. With double precision the scalar
+// path is used, as only four floats fit in an SSE or NEON register.
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BVH_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define BVH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 #define BVHABB_CLASS BVH_ABB<BOUNDS, POINT>
 
 // not sure if this is better yet so making optional
@@ -105,6 +117,19 @@ struct BVHHandle {
 	bool operator!=(const BVHHandle &p_h) const { return (*this == p_h) == false; }
 };
 
+// one decision made while rebuilding a tree from scratch, stored in pre-order.
+// Splits record planes rather than items, so a recorded layout can be replayed
+// onto a set of items that has changed slightly since it was saved.
+struct BVHBuildSplit {
+	enum {
+		AXIS_LEAF = -1, // the remaining items form a leaf
+		AXIS_MEDIAN = -2, // the items are split in half by count (all centers coincide)
+	};
+
+	int32_t axis;
+	real_t position;
+};
+
 // helper class to make iterative versions of recursive functions
 template <class T>
 class BVH_IterativeInfo {
@@ -181,6 +206,8 @@ public:
 	BVH_Tree() {
 		for (int n = 0; n < NUM_TREES; n++) {
 			_root_node_id[n] = BVHCommon::INVALID;
+			_tree_dirty[n] = false;
+			_tree_frozen[n] = false;
 		}
 
 		// disallow zero leaf ids
@@ -328,7 +355,7 @@ private:
 
 		// if the aabb is not determining the corner size, then there is no need to refit!
 		// (optimization, as merging AABBs takes a lot of time)
-		const BVHABB_CLASS &old_aabb = leaf.get_aabb(ref.item_id);
+		const BVHABB_CLASS old_aabb = leaf.get_aabb(ref.item_id);
 
 		// shrink a little to prevent using corner aabbs
 		// in order to miss the corners first we shrink by node_expansion
@@ -364,6 +391,7 @@ private:
 			// we defer the refit updates until the update function is called once per frame
 			if (refit) {
 				leaf.set_dirty(true);
+				_tree_dirty[p_tree_id] = true;
 			}
 		} else {
 			// remove node if empty
@@ -424,7 +452,7 @@ private:
 		BVH_ASSERT(ref.item_id != BVHCommon::INVALID);
 
 		// set the aabb of the new item
-		leaf.get_aabb(ref.item_id) = p_aabb;
+		leaf.set_aabb(ref.item_id, p_aabb);
 
 		// back reference on the item back to the item reference
 		leaf.get_item_ref_id(ref.item_id) = p_ref_id;
@@ -451,6 +479,7 @@ private:
 #include "bvh_logic.inc"
 #include "bvh_misc.inc"
 #include "bvh_public.inc"
+#include "bvh_rebuild.inc"
 #include "bvh_refit.inc"
 #include "bvh_split.inc"
 };
@@ -0,0 +1,611 @@
+/**************************************************************************/
+/*  column_table.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "column_table.h"
+
+#include "core/object/class_db.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLUMN_TABLE_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define COLUMN_TABLE_NEON
+#include <arm_neon.h>
+#endif
+
+// Bulk kernels over flat component arrays. Vector columns are processed as
+// plain runs of components; only clamping needs to know the row layout.
+
+namespace {
+
+// Clamp bounds are repeated over this many components in the vector loops,
+// a multiple of every supported row width (1, 2, 3 and 4).
+constexpr int CLAMP_PATTERN_SIZE = 12;
+
+template <typename T>
+void _add_scaled(T *r_dst, const T *p_src, T p_scale, int64_t p_count, int64_t p_from = 0) {
+	for (int64_t i = p_from; i < p_count; i++) {
+		r_dst[i] += p_src[i] * p_scale;
+	}
+}
+
+template <typename T>
+void _scale(T *r_dst, T p_factor, int64_t p_count, int64_t p_from = 0) {
+	for (int64_t i = p_from; i < p_count; i++) {
+		r_dst[i] *= p_factor;
+	}
+}
+
+template <typename T>
+void _clamp(T *r_dst, const T *p_min, const T *p_max, int p_period, int64_t p_count, int64_t p_from = 0) {
+	for (int64_t i = p_from; i < p_count; i++) {
+		const int k = i % p_period;
+		r_dst[i] = CLAMP(r_dst[i], p_min[k], p_max[k]);
+	}
+}
+
+template <typename T>
+void _build_clamp_pattern(const T *p_min, const T *p_max, int p_period, T *r_min, T *r_max) {
+	for (int k = 0; k < CLAMP_PATTERN_SIZE; k++) {
+		r_min[k] = p_min[k % p_period];
+		r_max[k] = p_max[k % p_period];
+	}
+}
+
+template <>
+void _add_scaled<float>(float *r_dst, const float *p_src, float p_scale, int64_t p_count, int64_t p_from) {
+	int64_t i = p_from;
+#if defined(COLUMN_TABLE_SSE2)
+	const __m128 scale = _mm_set1_ps(p_scale);
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_dst + i, _mm_add_ps(_mm_loadu_ps(r_dst + i), _mm_mul_ps(_mm_loadu_ps(p_src + i), scale)));
+	}
+#elif defined(COLUMN_TABLE_NEON)
+	const float32x4_t scale = vdupq_n_f32(p_scale);
+	for (; i + 4 <= p_count; i += 4) {
+		vst1q_f32(r_dst + i, vaddq_f32(vld1q_f32(r_dst + i), vmulq_f32(vld1q_f32(p_src + i), scale)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] += p_src[i] * p_scale;
+	}
+}
+
+template <>
+void _add_scaled<double>(double *r_dst, const double *p_src, double p_scale, int64_t p_count, int64_t p_from) {
+	int64_t i = p_from;
+#if defined(COLUMN_TABLE_SSE2)
+	const __m128d scale = _mm_set1_pd(p_scale);
+	for (; i + 2 <= p_count; i += 2) {
+		_mm_storeu_pd(r_dst + i, _mm_add_pd(_mm_loadu_pd(r_dst + i), _mm_mul_pd(_mm_loadu_pd(p_src + i), scale)));
+	}
+#elif defined(COLUMN_TABLE_NEON)
+	const float64x2_t scale = vdupq_n_f64(p_scale);
+	for (; i + 2 <= p_count; i += 2) {
+		vst1q_f64(r_dst + i, vaddq_f64(vld1q_f64(r_dst + i), vmulq_f64(vld1q_f64(p_src + i), scale)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] += p_src[i] * p_scale;
+	}
+}
+
+template <>
+void _scale<float>(float *r_dst, float p_factor, int64_t p_count, int64_t p_from) {
+	int64_t i = p_from;
+#if defined(COLUMN_TABLE_SSE2)
+	const __m128 factor = _mm_set1_ps(p_factor);
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_dst + i, _mm_mul_ps(_mm_loadu_ps(r_dst + i), factor));
+	}
+#elif defined(COLUMN_TABLE_NEON)
+	const float32x4_t factor = vdupq_n_f32(p_factor);
+	for (; i + 4 <= p_count; i += 4) {
+		vst1q_f32(r_dst + i, vmulq_f32(vld1q_f32(r_dst + i), factor));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] *= p_factor;
+	}
+}
+
+template <>
+void _scale<double>(double *r_dst, double p_factor, int64_t p_count, int64_t p_from) {
+	int64_t i = p_from;
+#if defined(COLUMN_TABLE_SSE2)
+	const __m128d factor = _mm_set1_pd(p_factor);
+	for (; i + 2 <= p_count; i += 2) {
+		_mm_storeu_pd(r_dst + i, _mm_mul_pd(_mm_loadu_pd(r_dst + i), factor));
+	}
+#elif defined(COLUMN_TABLE_NEON)
+	const float64x2_t factor = vdupq_n_f64(p_factor);
+	for (; i + 2 <= p_count; i += 2) {
+		vst1q_f64(r_dst + i, vmulq_f64(vld1q_f64(r_dst + i), factor));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] *= p_factor;
+	}
+}
+
+template <>
+void _clamp<float>(float *r_dst, const float *p_min, const float *p_max, int p_period, int64_t p_count, int64_t p_from) {
+	int64_t i = p_from;
+#if defined(COLUMN_TABLE_SSE2) || defined(COLUMN_TABLE_NEON)
+	float lo[CLAMP_PATTERN_SIZE];
+	float hi[CLAMP_PATTERN_SIZE];
+	_build_clamp_pattern(p_min, p_max, p_period, lo, hi);
+#if defined(COLUMN_TABLE_SSE2)
+	const __m128 lo0 = _mm_loadu_ps(lo), lo1 = _mm_loadu_ps(lo + 4), lo2 = _mm_loadu_ps(lo + 8);
+	const __m128 hi0 = _mm_loadu_ps(hi), hi1 = _mm_loadu_ps(hi + 4), hi2 = _mm_loadu_ps(hi + 8);
+	for (; i + CLAMP_PATTERN_SIZE <= p_count; i += CLAMP_PATTERN_SIZE) {
+		_mm_storeu_ps(r_dst + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(r_dst + i), lo0), hi0));
+		_mm_storeu_ps(r_dst + i + 4, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(r_dst + i + 4), lo1), hi1));
+		_mm_storeu_ps(r_dst + i + 8, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(r_dst + i + 8), lo2), hi2));
+	}
+#else
+	const float32x4_t lo0 = vld1q_f32(lo), lo1 = vld1q_f32(lo + 4), lo2 = vld1q_f32(lo + 8);
+	const float32x4_t hi0 = vld1q_f32(hi), hi1 = vld1q_f32(hi + 4), hi2 = vld1q_f32(hi + 8);
+	for (; i + CLAMP_PATTERN_SIZE <= p_count; i += CLAMP_PATTERN_SIZE) {
+		vst1q_f32(r_dst + i, vminq_f32(vmaxq_f32(vld1q_f32(r_dst + i), lo0), hi0));
+		vst1q_f32(r_dst + i + 4, vminq_f32(vmaxq_f32(vld1q_f32(r_dst + i + 4), lo1), hi1));
+		vst1q_f32(r_dst + i + 8, vminq_f32(vmaxq_f32(vld1q_f32(r_dst + i + 8), lo2), hi2));
+	}
+#endif
+#endif
+	for (; i < p_count; i++) {
+		const int k = i % p_period;
+		r_dst[i] = CLAMP(r_dst[i], p_min[k], p_max[k]);
+	}
+}
+
+template <>
+void _clamp<double>(double *r_dst, const double *p_min, const double *p_max, int p_period, int64_t p_count, int64_t p_from) {
+	int64_t i = p_from;
+#if defined(COLUMN_TABLE_SSE2) || defined(COLUMN_TABLE_NEON)
+	double lo[CLAMP_PATTERN_SIZE];
+	double hi[CLAMP_PATTERN_SIZE];
+	_build_clamp_pattern(p_min, p_max, p_period, lo, hi);
+	for (; i + CLAMP_PATTERN_SIZE <= p_count; i += CLAMP_PATTERN_SIZE) {
+		for (int k = 0; k < CLAMP_PATTERN_SIZE; k += 2) {
+#if defined(COLUMN_TABLE_SSE2)
+			_mm_storeu_pd(r_dst + i + k, _mm_min_pd(_mm_max_pd(_mm_loadu_pd(r_dst + i + k), _mm_loadu_pd(lo + k)), _mm_loadu_pd(hi + k)));
+#else
+			vst1q_f64(r_dst + i + k, vminq_f64(vmaxq_f64(vld1q_f64(r_dst + i + k), vld1q_f64(lo + k)), vld1q_f64(hi + k)));
+#endif
+		}
+	}
+#endif
+	for (; i < p_count; i++) {
+		const int k = i % p_period;
+		r_dst[i] = CLAMP(r_dst[i], p_min[k], p_max[k]);
+	}
+}
+
+} // namespace
+
+void ColumnTable::Column::resize(int p_size) {
+	switch (type) {
+		case Variant::INT:
+			ints.resize_zeroed(p_size);
+			break;
+		case Variant::FLOAT:
+			floats.resize_zeroed(p_size);
+			break;
+		case Variant::VECTOR2:
+			vector2s.resize(p_size);
+			break;
+		case Variant::VECTOR3:
+			vector3s.resize(p_size);
+			break;
+		case Variant::COLOR:
+			colors.resize(p_size);
+			break;
+		default:
+			ERR_FAIL();
+	}
+}
+
+void ColumnTable::Column::swap_remove(int p_row, int p_last) {
+	switch (type) {
+		case Variant::INT: {
+			int64_t *w = ints.ptrw();
+			w[p_row] = w[p_last];
+		} break;
+		case Variant::FLOAT: {
+			double *w = floats.ptrw();
+			w[p_row] = w[p_last];
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 *w = vector2s.ptrw();
+			w[p_row] = w[p_last];
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 *w = vector3s.ptrw();
+			w[p_row] = w[p_last];
+		} break;
+		case Variant::COLOR: {
+			Color *w = colors.ptrw();
+			w[p_row] = w[p_last];
+		} break;
+		default:
+			ERR_FAIL();
+	}
+	resize(p_last);
+}
+
+real_t *ColumnTable::Column::real_components(int &r_period) {
+	switch (type) {
+		case Variant::VECTOR2:
+			r_period = 2;
+			return (real_t *)vector2s.ptrw();
+		case Variant::VECTOR3:
+			r_period = 3;
+			return (real_t *)vector3s.ptrw();
+		default:
+			r_period = 0;
+			return nullptr;
+	}
+}
+
+bool ColumnTable::is_column_type_supported(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR3:
+		case Variant::COLOR:
+			return true;
+		default:
+			return false;
+	}
+}
+
+int ColumnTable::add_column(const StringName &p_name, Variant::Type p_type) {
+	ERR_FAIL_COND_V_MSG(p_name == StringName(), -1, "Column name can't be empty.");
+	ERR_FAIL_COND_V_MSG(find_column(p_name) != -1, -1, vformat("Column \"%s\" already exists.", p_name));
+	ERR_FAIL_COND_V_MSG(!is_column_type_supported(p_type), -1, vformat("Columns of type %s are not supported.", Variant::get_type_name(p_type)));
+
+	Column column;
+	column.name = p_name;
+	column.type = p_type;
+	column.resize(row_count);
+	columns.push_back(column);
+	return columns.size() - 1;
+}
+
+int ColumnTable::find_column(const StringName &p_name) const {
+	for (uint32_t i = 0; i < columns.size(); i++) {
+		if (columns[i].name == p_name) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+StringName ColumnTable::get_column_name(int p_column) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_column, columns.size(), StringName());
+	return columns[p_column].name;
+}
+
+Variant::Type ColumnTable::get_column_type(int p_column) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_column, columns.size(), Variant::NIL);
+	return columns[p_column].type;
+}
+
+void ColumnTable::set_row_count(int p_count) {
+	ERR_FAIL_COND(p_count < 0);
+	for (Column &column : columns) {
+		column.resize(p_count);
+	}
+	row_count = p_count;
+}
+
+int ColumnTable::add_row() {
+	set_row_count(row_count + 1);
+	return row_count - 1;
+}
+
+void ColumnTable::remove_row(int p_row) {
+	ERR_FAIL_INDEX(p_row, row_count);
+	for (Column &column : columns) {
+		column.swap_remove(p_row, row_count - 1);
+	}
+	row_count--;
+}
+
+Variant ColumnTable::get_value(int p_row, int p_column) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_column, columns.size(), Variant());
+	ERR_FAIL_INDEX_V(p_row, row_count, Variant());
+	const Column &column = columns[p_column];
+	switch (column.type) {
+		case Variant::INT:
+			return column.ints[p_row];
+		case Variant::FLOAT:
+			return column.floats[p_row];
+		case Variant::VECTOR2:
+			return column.vector2s[p_row];
+		case Variant::VECTOR3:
+			return column.vector3s[p_row];
+		case Variant::COLOR:
+			return column.colors[p_row];
+		default:
+			ERR_FAIL_V(Variant());
+	}
+}
+
+void ColumnTable::set_value(int p_row, int p_column, const Variant &p_value) {
+	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_column, columns.size());
+	ERR_FAIL_INDEX(p_row, row_count);
+	Column &column = columns[p_column];
+	ERR_FAIL_COND_MSG(!Variant::can_convert_strict(p_value.get_type(), column.type), vformat("Can't store a value of type %s in column \"%s\" of type %s.", Variant::get_type_name(p_value.get_type()), column.name, Variant::get_type_name(column.type)));
+	switch (column.type) {
+		case Variant::INT:
+			column.ints.write[p_row] = p_value;
+			break;
+		case Variant::FLOAT:
+			column.floats.write[p_row] = p_value;
+			break;
+		case Variant::VECTOR2:
+			column.vector2s.write[p_row] = p_value;
+			break;
+		case Variant::VECTOR3:
+			column.vector3s.write[p_row] = p_value;
+			break;
+		case Variant::COLOR:
+			column.colors.write[p_row] = p_value;
+			break;
+		default:
+			ERR_FAIL();
+	}
+}
+
+Variant ColumnTable::get_column_data(int p_column) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_column, columns.size(), Variant());
+	const Column &column = columns[p_column];
+	// Packed arrays are copy-on-write, so this shares the storage until either side writes.
+	switch (column.type) {
+		case Variant::INT:
+			return column.ints;
+		case Variant::FLOAT:
+			return column.floats;
+		case Variant::VECTOR2:
+			return column.vector2s;
+		case Variant::VECTOR3:
+			return column.vector3s;
+		case Variant::COLOR:
+			return column.colors;
+		default:
+			ERR_FAIL_V(Variant());
+	}
+}
+
+template <typename T>
+static void _set_column_array(Vector<T> &r_array, const Variant &p_data, Variant::Type p_array_type, int p_row_count) {
+	ERR_FAIL_COND_MSG(p_data.get_type() != p_array_type, vformat("Column data must be a %s.", Variant::get_type_name(p_array_type)));
+	const Vector<T> data = p_data;
+	ERR_FAIL_COND_MSG(data.size() != p_row_count, vformat("Column data has %d rows, but the table has %d.", data.size(), p_row_count));
+	r_array = data;
+}
+
+void ColumnTable::set_column_data(int p_column, const Variant &p_data) {
+	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_column, columns.size());
+	Column &column = columns[p_column];
+	switch (column.type) {
+		case Variant::INT:
+			_set_column_array(column.ints, p_data, Variant::PACKED_INT64_ARRAY, row_count);
+			break;
+		case Variant::FLOAT:
+			_set_column_array(column.floats, p_data, Variant::PACKED_FLOAT64_ARRAY, row_count);
+			break;
+		case Variant::VECTOR2:
+			_set_column_array(column.vector2s, p_data, Variant::PACKED_VECTOR2_ARRAY, row_count);
+			break;
+		case Variant::VECTOR3:
+			_set_column_array(column.vector3s, p_data, Variant::PACKED_VECTOR3_ARRAY, row_count);
+			break;
+		case Variant::COLOR:
+			_set_column_array(column.colors, p_data, Variant::PACKED_COLOR_ARRAY, row_count);
+			break;
+		default:
+			ERR_FAIL();
+	}
+}
+
+void ColumnTable::fill_column(int p_column, const Variant &p_value) {
+	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_column, columns.size());
+	Column &column = columns[p_column];
+	ERR_FAIL_COND_MSG(!Variant::can_convert_strict(p_value.get_type(), column.type), vformat("Can't store a value of type %s in column \"%s\" of type %s.", Variant::get_type_name(p_value.get_type()), column.name, Variant::get_type_name(column.type)));
+	switch (column.type) {
+		case Variant::INT:
+			column.ints.fill(p_value);
+			break;
+		case Variant::FLOAT:
+			column.floats.fill(p_value);
+			break;
+		case Variant::VECTOR2:
+			column.vector2s.fill(p_value);
+			break;
+		case Variant::VECTOR3:
+			column.vector3s.fill(p_value);
+			break;
+		case Variant::COLOR:
+			column.colors.fill(p_value);
+			break;
+		default:
+			ERR_FAIL();
+	}
+}
+
+void ColumnTable::add_to_column(int p_column, int p_source_column, double p_scale) {
+	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_column, columns.size());
+	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_source_column, columns.size());
+	Column &column = columns[p_column];
+	const Column &source = columns[p_source_column];
+	ERR_FAIL_COND_MSG(column.type != source.type, vformat("Can't add column \"%s\" of type %s to column \"%s\" of type %s.", source.name, Variant::get_type_name(source.type), column.name, Variant::get_type_name(column.type)));
+
+	switch (column.type) {
+		case Variant::INT: {
+			// Take the write pointer first, so adding a column to itself reads from the buffer being written.
+			int64_t *w = column.ints.ptrw();
+			const int64_t *r = source.ints.ptr();
+			if (p_scale == 1.0) {
+				for (int i = 0; i < row_count; i++) {
+					w[i] += r[i];
+				}
+			} else {
+				for (int i = 0; i < row_count; i++) {
+					w[i] += int64_t(r[i] * p_scale);
+				}
+			}
+		} break;
+		case Variant::FLOAT: {
+			double *w = column.floats.ptrw();
+			_add_scaled<double>(w, source.floats.ptr(), p_scale, row_count);
+		} break;
+		case Variant::VECTOR2:
+		case Variant::VECTOR3: {
+			int period = 0;
+			real_t *w = column.real_components(period);
+			const real_t *r = column.type == Variant::VECTOR2 ? (const real_t *)source.vector2s.ptr() : (const real_t *)source.vector3s.ptr();
+			_add_scaled<real_t>(w, r, (real_t)p_scale, int64_t(row_count) * period);
+		} break;
+		case Variant::COLOR: {
+			float *w = (float *)column.colors.ptrw();
+			_add_scaled<float>(w, (const float *)source.colors.ptr(), (float)p_scale, int64_t(row_count) * 4);
+		} break;
+		default:
+			ERR_FAIL();
+	}
+}
+
+void ColumnTable::scale_column(int p_column, double p_factor) {
+	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_column, columns.size());
+	Column &column = columns[p_column];
+
+	switch (column.type) {
+		case Variant::INT: {
+			int64_t *w = column.ints.ptrw();
+			for (int i = 0; i < row_count; i++) {
+				w[i] = int64_t(w[i] * p_factor);
+			}
+		} break;
+		case Variant::FLOAT: {
+			_scale<double>(column.floats.ptrw(), p_factor, row_count);
+		} break;
+		case Variant::VECTOR2:
+		case Variant::VECTOR3: {
+			int period = 0;
+			real_t *w = column.real_components(period);
+			_scale<real_t>(w, (real_t)p_factor, int64_t(row_count) * period);
+		} break;
+		case Variant::COLOR: {
+			_scale<float>((float *)column.colors.ptrw(), (float)p_factor, int64_t(row_count) * 4);
+		} break;
+		default:
+			ERR_FAIL();
+	}
+}
+
+void ColumnTable::clamp_column(int p_column, const Variant &p_min, const Variant &p_max) {
+	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_column, columns.size());
+	Column &column = columns[p_column];
+	ERR_FAIL_COND_MSG(!Variant::can_convert_strict(p_min.get_type(), column.type) || !Variant::can_convert_strict(p_max.get_type(), column.type), vformat("Clamp bounds must be of the column type %s.", Variant::get_type_name(column.type)));
+
+	switch (column.type) {
+		case Variant::INT: {
+			const int64_t min = p_min;
+			const int64_t max = p_max;
+			int64_t *w = column.ints.ptrw();
+			for (int i = 0; i < row_count; i++) {
+				w[i] = CLAMP(w[i], min, max);
+			}
+		} break;
+		case Variant::FLOAT: {
+			const double min = p_min;
+			const double max = p_max;
+			_clamp<double>(column.floats.ptrw(), &min, &max, 1, row_count);
+		} break;
+		case Variant::VECTOR2: {
+			const Vector2 min = p_min;
+			const Vector2 max = p_max;
+			_clamp<real_t>((real_t *)column.vector2s.ptrw(), &min.x, &max.x, 2, int64_t(row_count) * 2);
+		} break;
+		case Variant::VECTOR3: {
+			const Vector3 min = p_min;
+			const Vector3 max = p_max;
+			_clamp<real_t>((real_t *)column.vector3s.ptrw(), &min.x, &max.x, 3, int64_t(row_count) * 3);
+		} break;
+		case Variant::COLOR: {
+			const Color min = p_min;
+			const Color max = p_max;
+			_clamp<float>((float *)column.colors.ptrw(), &min.r, &max.r, 4, int64_t(row_count) * 4);
+		} break;
+		default:
+			ERR_FAIL();
+	}
+}
+
+void ColumnTable::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("add_column", "name", "type"), &ColumnTable::add_column);
+	ClassDB::bind_method(D_METHOD("find_column", "name"), &ColumnTable::find_column);
+	ClassDB::bind_method(D_METHOD("get_column_count"), &ColumnTable::get_column_count);
+	ClassDB::bind_method(D_METHOD("get_column_name", "column"), &ColumnTable::get_column_name);
+	ClassDB::bind_method(D_METHOD("get_column_type", "column"), &ColumnTable::get_column_type);
+
+	ClassDB::bind_method(D_METHOD("set_row_count", "count"), &ColumnTable::set_row_count);
+	ClassDB::bind_method(D_METHOD("get_row_count"), &ColumnTable::get_row_count);
+	ClassDB::bind_method(D_METHOD("add_row"), &ColumnTable::add_row);
+	ClassDB::bind_method(D_METHOD("remove_row", "row"), &ColumnTable::remove_row);
+	ClassDB::bind_method(D_METHOD("clear_rows"), &ColumnTable::clear_rows);
+
+	ClassDB::bind_method(D_METHOD("get_value", "row", "column"), &ColumnTable::get_value);
+	ClassDB::bind_method(D_METHOD("set_value", "row", "column", "value"), &ColumnTable::set_value);
+	ClassDB::bind_method(D_METHOD("get_int", "row", "column"), &ColumnTable::get_int);
+	ClassDB::bind_method(D_METHOD("set_int", "row", "column", "value"), &ColumnTable::set_int);
+	ClassDB::bind_method(D_METHOD("get_float", "row", "column"), &ColumnTable::get_float);
+	ClassDB::bind_method(D_METHOD("set_float", "row", "column", "value"), &ColumnTable::set_float);
+	ClassDB::bind_method(D_METHOD("get_vector2", "row", "column"), &ColumnTable::get_vector2);
+	ClassDB::bind_method(D_METHOD("set_vector2", "row", "column", "value"), &ColumnTable::set_vector2);
+	ClassDB::bind_method(D_METHOD("get_vector3", "row", "column"), &ColumnTable::get_vector3);
+	ClassDB::bind_method(D_METHOD("set_vector3", "row", "column", "value"), &ColumnTable::set_vector3);
+	ClassDB::bind_method(D_METHOD("get_color", "row", "column"), &ColumnTable::get_color);
+	ClassDB::bind_method(D_METHOD("set_color", "row", "column", "value"), &ColumnTable::set_color);
+
+	ClassDB::bind_method(D_METHOD("get_column_data", "column"), &ColumnTable::get_column_data);
+	ClassDB::bind_method(D_METHOD("set_column_data", "column", "data"), &ColumnTable::set_column_data);
+
+	ClassDB::bind_method(D_METHOD("fill_column", "column", "value"), &ColumnTable::fill_column);
+	ClassDB::bind_method(D_METHOD("add_to_column", "column", "source_column", "scale"), &ColumnTable::add_to_column, DEFVAL(1.0));
+	ClassDB::bind_method(D_METHOD("scale_column", "column", "factor"), &ColumnTable::scale_column);
+	ClassDB::bind_method(D_METHOD("clamp_column", "column", "min", "max"), &ColumnTable::clamp_column);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "row_count", PROPERTY_HINT_RANGE, "0,1000000,1,or_greater"), "set_row_count", "get_row_count");
+}
@@ -0,0 +1,165 @@
+/**************************************************************************/
+/*  column_table.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef COLUMN_TABLE_H
+#define COLUMN_TABLE_H
+
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// Fixed schema of typed columns, each stored contiguously in a packed array.
+// Rows are addressed by index; bulk operations work on whole columns at once.
+class ColumnTable : public RefCounted {
+	GDCLASS(ColumnTable, RefCounted);
+
+	struct Column {
+		StringName name;
+		Variant::Type type = Variant::NIL;
+		// Only the array matching `type` is used.
+		PackedInt64Array ints;
+		PackedFloat64Array floats;
+		PackedVector2Array vector2s;
+		PackedVector3Array vector3s;
+		PackedColorArray colors;
+
+		void resize(int p_size);
+		void swap_remove(int p_row, int p_last);
+		// Pointer to the real-valued components of a vector column, and the number of components per row.
+		real_t *real_components(int &r_period);
+	};
+
+	LocalVector<Column> columns;
+	int row_count = 0;
+
+	_FORCE_INLINE_ Column *_get_typed_column(int p_column, Variant::Type p_type) {
+		ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_column, columns.size(), nullptr);
+		Column *c = &columns[p_column];
+		ERR_FAIL_COND_V_MSG(c->type != p_type, nullptr, vformat("Column \"%s\" is of type %s, not %s.", c->name, Variant::get_type_name(c->type), Variant::get_type_name(p_type)));
+		return c;
+	}
+
+	_FORCE_INLINE_ const Column *_get_typed_column(int p_column, Variant::Type p_type) const {
+		return const_cast<ColumnTable *>(this)->_get_typed_column(p_column, p_type);
+	}
+
+protected:
+	static void _bind_methods();
+
+public:
+	static bool is_column_type_supported(Variant::Type p_type);
+
+	int add_column(const StringName &p_name, Variant::Type p_type);
+	int find_column(const StringName &p_name) const;
+	int get_column_count() const { return columns.size(); }
+	StringName get_column_name(int p_column) const;
+	Variant::Type get_column_type(int p_column) const;
+
+	void set_row_count(int p_count);
+	int get_row_count() const { return row_count; }
+	int add_row();
+	void remove_row(int p_row);
+	void clear_rows() { set_row_count(0); }
+
+	Variant get_value(int p_row, int p_column) const;
+	void set_value(int p_row, int p_column, const Variant &p_value);
+
+	// Typed accessors, these skip the Variant conversions of get_value() and set_value().
+	_FORCE_INLINE_ int64_t get_int(int p_row, int p_column) const {
+		const Column *c = _get_typed_column(p_column, Variant::INT);
+		ERR_FAIL_NULL_V(c, 0);
+		ERR_FAIL_INDEX_V(p_row, row_count, 0);
+		return c->ints.ptr()[p_row];
+	}
+	_FORCE_INLINE_ void set_int(int p_row, int p_column, int64_t p_value) {
+		Column *c = _get_typed_column(p_column, Variant::INT);
+		ERR_FAIL_NULL(c);
+		ERR_FAIL_INDEX(p_row, row_count);
+		c->ints.ptrw()[p_row] = p_value;
+	}
+	_FORCE_INLINE_ double get_float(int p_row, int p_column) const {
+		const Column *c = _get_typed_column(p_column, Variant::FLOAT);
+		ERR_FAIL_NULL_V(c, 0.0);
+		ERR_FAIL_INDEX_V(p_row, row_count, 0.0);
+		return c->floats.ptr()[p_row];
+	}
+	_FORCE_INLINE_ void set_float(int p_row, int p_column, double p_value) {
+		Column *c = _get_typed_column(p_column, Variant::FLOAT);
+		ERR_FAIL_NULL(c);
+		ERR_FAIL_INDEX(p_row, row_count);
+		c->floats.ptrw()[p_row] = p_value;
+	}
+	_FORCE_INLINE_ Vector2 get_vector2(int p_row, int p_column) const {
+		const Column *c = _get_typed_column(p_column, Variant::VECTOR2);
+		ERR_FAIL_NULL_V(c, Vector2());
+		ERR_FAIL_INDEX_V(p_row, row_count, Vector2());
+		return c->vector2s.ptr()[p_row];
+	}
+	_FORCE_INLINE_ void set_vector2(int p_row, int p_column, const Vector2 &p_value) {
+		Column *c = _get_typed_column(p_column, Variant::VECTOR2);
+		ERR_FAIL_NULL(c);
+		ERR_FAIL_INDEX(p_row, row_count);
+		c->vector2s.ptrw()[p_row] = p_value;
+	}
+	_FORCE_INLINE_ Vector3 get_vector3(int p_row, int p_column) const {
+		const Column *c = _get_typed_column(p_column, Variant::VECTOR3);
+		ERR_FAIL_NULL_V(c, Vector3());
+		ERR_FAIL_INDEX_V(p_row, row_count, Vector3());
+		return c->vector3s.ptr()[p_row];
+	}
+	_FORCE_INLINE_ void set_vector3(int p_row, int p_column, const Vector3 &p_value) {
+		Column *c = _get_typed_column(p_column, Variant::VECTOR3);
+		ERR_FAIL_NULL(c);
+		ERR_FAIL_INDEX(p_row, row_count);
+		c->vector3s.ptrw()[p_row] = p_value;
+	}
+	_FORCE_INLINE_ Color get_color(int p_row, int p_column) const {
+		const Column *c = _get_typed_column(p_column, Variant::COLOR);
+		ERR_FAIL_NULL_V(c, Color());
+		ERR_FAIL_INDEX_V(p_row, row_count, Color());
+		return c->colors.ptr()[p_row];
+	}
+	_FORCE_INLINE_ void set_color(int p_row, int p_column, const Color &p_value) {
+		Column *c = _get_typed_column(p_column, Variant::COLOR);
+		ERR_FAIL_NULL(c);
+		ERR_FAIL_INDEX(p_row, row_count);
+		c->colors.ptrw()[p_row] = p_value;
+	}
+
+	Variant get_column_data(int p_column) const;
+	void set_column_data(int p_column, const Variant &p_data);
+
+	void fill_column(int p_column, const Variant &p_value);
+	void add_to_column(int p_column, int p_source_column, double p_scale = 1.0);
+	void scale_column(int p_column, double p_factor);
+	void clamp_column(int p_column, const Variant &p_min, const Variant &p_max);
+};
+
+#endif // COLUMN_TABLE_H
@@ -31,9 +31,13 @@
 #ifndef DISJOINT_SET_H
 #define DISJOINT_SET_H
 
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/vector.h"
 
+#include <atomic>
+
 /* This DisjointSet class uses Find with path compression and Union by rank */
 template <typename T, class H = HashMapHasherDefault, class C = HashMapComparatorDefault<T>, class AL = DefaultAllocator>
 class DisjointSet {
@@ -147,4 +151,75 @@ void DisjointSet<T, H, C, AL>::get_members(Vector<T> &out_members, T representat
 	}
 }
 
+/* This SafeDisjointSet class works on the dense indices [0, size) and allows create_union and find to be
+ * called from several threads at once. Sets are always linked to their lowest index, so the representative
+ * of a set is its smallest member no matter in which order the unions happened. */
+class SafeDisjointSet {
+	// Atomics can't be moved, so the storage is only ever reallocated empty, never grown in place.
+	std::atomic<uint32_t> *parents = nullptr;
+	uint32_t parent_count = 0;
+	uint32_t capacity = 0;
+
+public:
+	void reset(uint32_t p_size) {
+		if (p_size > capacity) {
+			if (parents) {
+				memdelete_arr(parents);
+			}
+			parents = memnew_arr(std::atomic<uint32_t>, p_size);
+			capacity = p_size;
+		}
+		parent_count = p_size;
+		for (uint32_t i = 0; i < p_size; i++) {
+			parents[i].store(i, std::memory_order_relaxed);
+		}
+	}
+
+	_FORCE_INLINE_ uint32_t size() const { return parent_count; }
+
+	uint32_t find(uint32_t p_index) {
+		uint32_t index = p_index;
+		while (true) {
+			uint32_t parent = parents[index].load(std::memory_order_relaxed);
+			if (parent == index) {
+				return index;
+			}
+			// Path halving, losing the race to another thread is harmless.
+			uint32_t grandparent = parents[parent].load(std::memory_order_relaxed);
+			if (grandparent != parent) {
+				parents[index].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+			}
+			index = grandparent;
+		}
+	}
+
+	void create_union(uint32_t p_a, uint32_t p_b) {
+		while (true) {
+			uint32_t a = find(p_a);
+			uint32_t b = find(p_b);
+			if (a == b) {
+				return;
+			}
+			if (a < b) {
+				SWAP(a, b);
+			}
+			// Only succeeds if a is still a root, otherwise look for the roots again.
+			uint32_t expected = a;
+			if (parents[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+				return;
+			}
+		}
+	}
+
+	SafeDisjointSet() {}
+	SafeDisjointSet(const SafeDisjointSet &) = delete;
+	SafeDisjointSet &operator=(const SafeDisjointSet &) = delete;
+
+	~SafeDisjointSet() {
+		if (parents) {
+			memdelete_arr(parents);
+		}
+	}
+};
+
 #endif // DISJOINT_SET_H
@@ -34,6 +34,8 @@
 #include "core/io/resource_loader.h"
 #include "core/object/script_language.h"
 #include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/templates/sort_array.h"
 #include "core/version.h"
 
 #define OBJTYPE_RLOCK RWLockRead _rw_lockr_(lock);
@@ -68,6 +70,268 @@ ClassDB::APIType ClassDB::get_current_api() {
 HashMap<StringName, ClassDB::ClassInfo> ClassDB::classes;
 HashMap<StringName, StringName> ClassDB::resource_base_extensions;
 HashMap<StringName, StringName> ClassDB::compat_classes;
+bool ClassDB::lookup_tables_enabled = false;
+uint32_t ClassDB::lookup_generation = 0;
+LocalVector<ClassDB::LookupTable *> ClassDB::retired_lookup_tables;
+
+bool ClassDB::LookupTable::build(const LocalVector<LookupEntry> &p_entries) {
+	const uint32_t MAX_SEED = 1 << 16;
+	const uint32_t MAX_BUCKET_SIZE = 32;
+
+	uint32_t count = p_entries.size();
+	seeds.clear();
+	slots.clear();
+	if (count == 0) {
+		return true;
+	}
+
+	uint32_t bucket_count = next_power_of_2(count);
+	bucket_mask = bucket_count - 1;
+
+	LocalVector<LocalVector<uint32_t>> buckets;
+	buckets.resize(bucket_count);
+	for (uint32_t i = 0; i < count; i++) {
+		buckets[p_entries[i].name.hash() & bucket_mask].push_back(i);
+	}
+
+	// Place the largest buckets first, while most slots are still free.
+	LocalVector<uint32_t> order;
+	order.resize(bucket_count);
+	for (uint32_t i = 0; i < bucket_count; i++) {
+		order[i] = i;
+	}
+	struct BucketSizeSort {
+		const LocalVector<LocalVector<uint32_t>> *buckets = nullptr;
+		bool operator()(uint32_t p_a, uint32_t p_b) const { return (*buckets)[p_a].size() > (*buckets)[p_b].size(); }
+	};
+	SortArray<uint32_t, BucketSizeSort> sorter;
+	sorter.compare.buckets = &buckets;
+	sorter.sort(order.ptr(), bucket_count);
+
+	seeds.resize(bucket_count);
+	LocalVector<int32_t> slot_entry;
+	slot_entry.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		slot_entry[i] = -1;
+	}
+
+	uint32_t next_free_slot = 0;
+	for (uint32_t i = 0; i < bucket_count; i++) {
+		uint32_t bucket_index = order[i];
+		const LocalVector<uint32_t> &bucket = buckets[bucket_index];
+		seeds[bucket_index] = 0;
+
+		if (bucket.size() == 0) {
+			continue;
+		}
+
+		if (bucket.size() == 1) {
+			// The multi-name buckets are all placed, so any free slot will do.
+			while (slot_entry[next_free_slot] != -1) {
+				next_free_slot++;
+			}
+			slot_entry[next_free_slot] = bucket[0];
+			seeds[bucket_index] = DIRECT_SLOT | next_free_slot;
+			continue;
+		}
+
+		if (bucket.size() > MAX_BUCKET_SIZE) {
+			return false;
+		}
+		for (uint32_t j = 0; j < bucket.size(); j++) {
+			for (uint32_t k = 0; k < j; k++) {
+				if (p_entries[bucket[j]].name.hash() == p_entries[bucket[k]].name.hash()) {
+					return false; // Names with the same hash can never be told apart.
+				}
+			}
+		}
+
+		uint32_t bucket_slots[MAX_BUCKET_SIZE];
+		bool placed = false;
+		for (uint32_t seed = 1; seed < MAX_SEED && !placed; seed++) {
+			placed = true;
+			for (uint32_t j = 0; j < bucket.size() && placed; j++) {
+				uint32_t slot = get_seeded_slot(p_entries[bucket[j]].name.hash(), seed, count);
+				if (slot_entry[slot] != -1) {
+					placed = false;
+				}
+				for (uint32_t k = 0; k < j && placed; k++) {
+					if (bucket_slots[k] == slot) {
+						placed = false;
+					}
+				}
+				bucket_slots[j] = slot;
+			}
+			if (placed) {
+				seeds[bucket_index] = seed;
+				for (uint32_t j = 0; j < bucket.size(); j++) {
+					slot_entry[bucket_slots[j]] = bucket[j];
+				}
+			}
+		}
+
+		if (!placed) {
+			return false;
+		}
+	}
+
+	slots.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		slots[i] = p_entries[slot_entry[i]];
+	}
+	return true;
+}
+
+void ClassDB::_build_lookup_table(ClassInfo *p_class) {
+	LocalVector<LookupEntry> entries;
+	HashMap<StringName, uint32_t> entry_indices;
+
+	auto get_entry = [&](const StringName &p_name) -> LookupEntry & {
+		uint32_t *index = entry_indices.getptr(p_name);
+		if (index) {
+			return entries[*index];
+		}
+		entry_indices.insert(p_name, entries.size());
+		entries.push_back(LookupEntry());
+		entries[entries.size() - 1].name = p_name;
+		return entries[entries.size() - 1];
+	};
+
+	// Walk up like get_property() does, checking properties, constants, methods and signals
+	// of each class in turn, so the first match for each name wins.
+	for (ClassInfo *check = p_class; check; check = check->inherits_ptr) {
+		for (const KeyValue<StringName, PropertySetGet> &E : check->property_setget) {
+			LookupEntry &entry = get_entry(E.key);
+			if (!entry.setget) {
+				entry.setget = &E.value;
+			}
+			if (entry.get_kind == LookupEntry::GET_NONE) {
+				entry.get_kind = LookupEntry::GET_PROPERTY;
+			}
+		}
+		for (const KeyValue<StringName, int64_t> &E : check->constant_map) {
+			LookupEntry &entry = get_entry(E.key);
+			if (entry.get_kind == LookupEntry::GET_NONE) {
+				entry.get_kind = LookupEntry::GET_CONSTANT;
+				entry.constant = &E.value;
+			}
+		}
+		for (const KeyValue<StringName, MethodBind *> &E : check->method_map) {
+			LookupEntry &entry = get_entry(E.key);
+			if (!entry.method) {
+				entry.method = E.value;
+			}
+			if (entry.get_kind == LookupEntry::GET_NONE) {
+				entry.get_kind = LookupEntry::GET_METHOD;
+			}
+		}
+		for (const KeyValue<StringName, MethodInfo> &E : check->signal_map) {
+			LookupEntry &entry = get_entry(E.key);
+			if (entry.get_kind == LookupEntry::GET_NONE) {
+				entry.get_kind = LookupEntry::GET_SIGNAL;
+			}
+		}
+	}
+
+	LookupTable *table = memnew(LookupTable);
+	if (!table->build(entries)) {
+		// Kept empty so the class isn't stale, lookups fall back to walking the inheritance chain.
+		table->seeds.clear();
+		table->slots.clear();
+		table->fallback = true;
+	}
+
+	LookupTable *old_table = p_class->lookup_table.take();
+	if (old_table) {
+		retired_lookup_tables.push_back(old_table);
+	}
+	// The table is fully built before it's published.
+	p_class->lookup_table.publish(table);
+}
+
+void ClassDB::_build_stale_lookup_table(const StringName &p_class) {
+	// Only tried, as this thread may be inside ClassDB already. The inheritance chain is walked
+	// until a later lookup manages to build the table.
+	if (!lock.write_try_lock()) {
+		return;
+	}
+
+	ClassInfo *type = classes.getptr(p_class);
+	if (type && _is_lookup_table_stale(type)) {
+		_build_lookup_table(type);
+	}
+
+	lock.write_unlock();
+}
+
+void ClassDB::_invalidate_lookup_tables(ClassInfo *p_class) {
+	if (!lookup_tables_enabled) {
+		return;
+	}
+
+	// Tables hold the members of all the ancestors, so the ones of inheriting classes go stale too.
+	bool built_table_changed = false;
+	for (KeyValue<StringName, ClassInfo> &E : classes) {
+		if (!E.value.lookup_table.get()) {
+			continue;
+		}
+		for (ClassInfo *check = &E.value; check; check = check->inherits_ptr) {
+			if (check == p_class) {
+				// Lookups without the lock may still be using it.
+				retired_lookup_tables.push_back(E.value.lookup_table.take());
+				built_table_changed = true;
+				break;
+			}
+		}
+	}
+
+	if (built_table_changed) {
+		lookup_generation++;
+	}
+}
+
+void ClassDB::build_lookup_tables() {
+	OBJTYPE_WLOCK;
+
+	lookup_tables_enabled = true;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t entry_count = 0;
+	for (KeyValue<StringName, ClassInfo> &E : classes) {
+		if (!E.value.lookup_table.get()) {
+			_build_lookup_table(&E.value);
+		}
+		entry_count += E.value.lookup_table.get()->slots.size();
+	}
+
+	print_verbose(vformat("ClassDB: Built lookup tables for %d classes (%d entries) in %d usec.", classes.size(), entry_count, OS::get_singleton()->get_ticks_usec() - begin));
+}
+
+const ClassDB::PropertySetGet *ClassDB::_get_property_setget(ClassInfo *p_class, const StringName &p_property) {
+	if (!p_class) {
+		return nullptr;
+	}
+
+	if (unlikely(_is_lookup_table_stale(p_class))) {
+		_build_stale_lookup_table(p_class->name);
+	}
+
+	const LookupTable *table = _get_lookup_table(p_class);
+	if (likely(table)) {
+		const LookupEntry *entry = table->find(p_property);
+		return entry ? entry->setget : nullptr;
+	}
+
+	ClassInfo *check = p_class;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			return psg;
+		}
+		check = check->inherits_ptr;
+	}
+	return nullptr;
+}
 
 bool ClassDB::_is_parent_class(const StringName &p_class, const StringName &p_inherits) {
 	if (!classes.has(p_class)) {
@@ -638,9 +902,32 @@ bool ClassDB::get_method_info(const StringName &p_class, const StringName &p_met
 }
 
 MethodBind *ClassDB::get_method(const StringName &p_class, const StringName &p_name) {
+	{
+		OBJTYPE_RLOCK;
+
+		ClassInfo *type = classes.getptr(p_class);
+		if (likely(!type || !_is_lookup_table_stale(type))) {
+			return _find_method(type, p_name);
+		}
+	}
+
+	// The table can't be built while holding the read lock.
+	_build_stale_lookup_table(p_class);
+
 	OBJTYPE_RLOCK;
+	return _find_method(classes.getptr(p_class), p_name);
+}
 
-	ClassInfo *type = classes.getptr(p_class);
+MethodBind *ClassDB::_find_method(ClassInfo *p_class, const StringName &p_name) {
+	ClassInfo *type = p_class;
+
+	if (likely(type)) {
+		const LookupTable *table = _get_lookup_table(type);
+		if (likely(table)) {
+			const LookupEntry *entry = table->find(p_name);
+			return entry ? entry->method : nullptr;
+		}
+	}
 
 	while (type) {
 		MethodBind **method = type->method_map.getptr(p_name);
@@ -718,6 +1005,7 @@ void ClassDB::bind_integer_constant(const StringName &p_class, const StringName
 	}
 
 	type->constant_map[p_name] = p_constant;
+	_invalidate_lookup_tables(type);
 
 	String enum_name = p_enum;
 	if (!enum_name.is_empty()) {
@@ -957,6 +1245,7 @@ void ClassDB::add_signal(const StringName &p_class, const MethodInfo &p_signal)
 #endif
 
 	type->signal_map[sname] = p_signal;
+	_invalidate_lookup_tables(type);
 }
 
 void ClassDB::get_signal_list(const StringName &p_class, List<MethodInfo> *p_signals, bool p_no_inheritance) {
@@ -1109,6 +1398,7 @@ void ClassDB::add_property(const StringName &p_class, const PropertyInfo &p_pinf
 	psg.type = p_pinfo.type;
 
 	type->property_setget[p_pinfo.name] = psg;
+	_invalidate_lookup_tables(type);
 }
 
 void ClassDB::set_property_default_value(const StringName &p_class, const StringName &p_name, const Variant &p_default) {
@@ -1205,78 +1495,105 @@ bool ClassDB::get_property_info(const StringName &p_class, const StringName &p_p
 bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
 	ERR_FAIL_NULL_V(p_object, false);
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (!psg->setter) {
-				if (r_valid) {
-					*r_valid = false;
-				}
-				return true; //return true but do nothing
-			}
-
-			Callable::CallError ce;
+	const PropertySetGet *psg = _get_property_setget(classes.getptr(p_object->get_class_name()), p_property);
+	if (!psg) {
+		return false;
+	}
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[2] = { &index, &p_value };
-				//p_object->call(psg->setter,arg,2,ce);
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 2, ce);
-				} else {
-					p_object->callp(psg->setter, arg, 2, ce);
-				}
+	if (!psg->setter) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		return true; //return true but do nothing
+	}
 
-			} else {
-				const Variant *arg[1] = { &p_value };
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 1, ce);
-				} else {
-					p_object->callp(psg->setter, arg, 1, ce);
-				}
-			}
+	Callable::CallError ce;
 
-			if (r_valid) {
-				*r_valid = ce.error == Callable::CallError::CALL_OK;
-			}
+	if (psg->index >= 0) {
+		Variant index = psg->index;
+		const Variant *arg[2] = { &index, &p_value };
+		//p_object->call(psg->setter,arg,2,ce);
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 2, ce);
+		} else {
+			p_object->callp(psg->setter, arg, 2, ce);
+		}
 
-			return true;
+	} else {
+		const Variant *arg[1] = { &p_value };
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 1, ce);
+		} else {
+			p_object->callp(psg->setter, arg, 1, ce);
 		}
+	}
 
-		check = check->inherits_ptr;
+	if (r_valid) {
+		*r_valid = ce.error == Callable::CallError::CALL_OK;
 	}
 
-	return false;
+	return true;
+}
+
+static void _call_property_getter(Object *p_object, const ClassDB::PropertySetGet *p_psg, Variant &r_value) {
+	if (!p_psg->getter) {
+		return; //return true but do nothing
+	}
+
+	Callable::CallError ce;
+	if (p_psg->index >= 0) {
+		Variant index = p_psg->index;
+		const Variant *arg[1] = { &index };
+		r_value = p_object->callp(p_psg->getter, arg, 1, ce);
+
+	} else {
+		if (p_psg->_getptr) {
+			r_value = p_psg->_getptr->call(p_object, nullptr, 0, ce);
+		} else {
+			r_value = p_object->callp(p_psg->getter, nullptr, 0, ce);
+		}
+	}
 }
 
 bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
 	ERR_FAIL_NULL_V(p_object, false);
 
 	ClassInfo *type = classes.getptr(p_object->get_class_name());
+
+	if (unlikely(type && _is_lookup_table_stale(type))) {
+		_build_stale_lookup_table(type->name);
+	}
+
+	const LookupTable *table = type ? _get_lookup_table(type) : nullptr;
+	if (likely(table)) {
+		const LookupEntry *entry = table->find(p_property);
+		if (!entry) {
+			return false;
+		}
+
+		switch (entry->get_kind) {
+			case LookupEntry::GET_NONE:
+				return false;
+			case LookupEntry::GET_PROPERTY:
+				_call_property_getter(p_object, entry->setget, r_value);
+				return true;
+			case LookupEntry::GET_CONSTANT:
+				r_value = *entry->constant;
+				return true;
+			case LookupEntry::GET_METHOD:
+				r_value = Callable(p_object, p_property);
+				return true;
+			case LookupEntry::GET_SIGNAL:
+				r_value = Signal(p_object, p_property);
+				return true;
+		}
+	}
+
 	ClassInfo *check = type;
 	while (check) {
 		const PropertySetGet *psg = check->property_setget.getptr(p_property);
 		if (psg) {
-			if (!psg->getter) {
-				return true; //return true but do nothing
-			}
-
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[1] = { &index };
-				Callable::CallError ce;
-				r_value = p_object->callp(psg->getter, arg, 1, ce);
-
-			} else {
-				Callable::CallError ce;
-				if (psg->_getptr) {
-					r_value = psg->_getptr->call(p_object, nullptr, 0, ce);
-				} else {
-					r_value = p_object->callp(psg->getter, nullptr, 0, ce);
-				}
-			}
+			_call_property_getter(p_object, psg, r_value);
 			return true;
 		}
 
@@ -1303,77 +1620,35 @@ bool ClassDB::get_property(Object *p_object, const StringName &p_property, Varia
 }
 
 int ClassDB::get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
-	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (r_is_valid) {
-				*r_is_valid = true;
-			}
-
-			return psg->index;
-		}
-
-		check = check->inherits_ptr;
-	}
+	const PropertySetGet *psg = _get_property_setget(classes.getptr(p_class), p_property);
 	if (r_is_valid) {
-		*r_is_valid = false;
+		*r_is_valid = psg != nullptr;
 	}
 
-	return -1;
+	return psg ? psg->index : -1;
 }
 
 Variant::Type ClassDB::get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
-	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (r_is_valid) {
-				*r_is_valid = true;
-			}
-
-			return psg->type;
-		}
-
-		check = check->inherits_ptr;
-	}
+	const PropertySetGet *psg = _get_property_setget(classes.getptr(p_class), p_property);
 	if (r_is_valid) {
-		*r_is_valid = false;
+		*r_is_valid = psg != nullptr;
 	}
 
-	return Variant::NIL;
+	return psg ? psg->type : Variant::NIL;
 }
 
-StringName ClassDB::get_property_setter(const StringName &p_class, const StringName &p_property) {
-	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			return psg->setter;
-		}
-
-		check = check->inherits_ptr;
-	}
+const ClassDB::PropertySetGet *ClassDB::get_property_setget(const StringName &p_class, const StringName &p_property) {
+	return _get_property_setget(classes.getptr(p_class), p_property);
+}
 
-	return StringName();
+StringName ClassDB::get_property_setter(const StringName &p_class, const StringName &p_property) {
+	const PropertySetGet *psg = _get_property_setget(classes.getptr(p_class), p_property);
+	return psg ? psg->setter : StringName();
 }
 
 StringName ClassDB::get_property_getter(const StringName &p_class, const StringName &p_property) {
-	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			return psg->getter;
-		}
-
-		check = check->inherits_ptr;
-	}
-
-	return StringName();
+	const PropertySetGet *psg = _get_property_setget(classes.getptr(p_class), p_property);
+	return psg ? psg->getter : StringName();
 }
 
 bool ClassDB::has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance) {
@@ -1455,6 +1730,7 @@ void ClassDB::_bind_method_custom(const StringName &p_class, MethodBind *p_metho
 #endif
 
 	type->method_map[p_method->get_name()] = p_method;
+	_invalidate_lookup_tables(type);
 }
 
 MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p_name, const Vector<Variant> &p_default_args, bool p_compatibility) {
@@ -1481,6 +1757,7 @@ MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p
 		ERR_FAIL_V_MSG(nullptr, "Method already bound: " + instance_type + "::" + p_name + ".");
 	}
 	type->method_map[p_name] = bind;
+	_invalidate_lookup_tables(type);
 #ifdef DEBUG_METHODS_ENABLED
 	// FIXME: <reduz> set_return_type is no longer in MethodBind, so I guess it should be moved to vararg method bind
 	//bind->set_return_type("Variant");
@@ -1539,6 +1816,7 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, bool p_
 		_bind_compatibility(type, p_bind);
 	} else {
 		type->method_map[mdname] = p_bind;
+		_invalidate_lookup_tables(type);
 	}
 
 	Vector<Variant> defvals;
@@ -1796,7 +2074,13 @@ void ClassDB::unregister_extension_class(const StringName &p_class, bool p_free_
 			memdelete(F.value);
 		}
 	}
+	_invalidate_lookup_tables(c);
+	LookupTable *table = c->lookup_table.take();
+	if (table) {
+		retired_lookup_tables.push_back(table);
+	}
 	classes.erase(p_class);
+	lookup_generation++;
 }
 
 HashMap<StringName, ClassDB::NativeStruct> ClassDB::native_structs;
@@ -1844,7 +2128,17 @@ void ClassDB::cleanup() {
 				memdelete(F.value[i]);
 			}
 		}
+		LookupTable *table = ti.lookup_table.take();
+		if (table) {
+			memdelete(table);
+		}
+	}
+
+	for (LookupTable *table : retired_lookup_tables) {
+		memdelete(table);
 	}
+	retired_lookup_tables.clear();
+	lookup_tables_enabled = false;
 
 	classes.clear();
 	resource_base_extensions.clear();
@@ -39,6 +39,7 @@
 // Needs to come after method_bind and object have been included.
 #include "core/object/callable_method_pointer.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 
 #include <type_traits>
 
@@ -97,6 +98,68 @@ public:
 		Variant::Type type;
 	};
 
+	// Everything a dynamic call, set or get can resolve a name to, merged over a class and all
+	// its ancestors with the same precedence as walking the inheritance chain.
+	struct LookupEntry {
+		enum GetKind : uint8_t {
+			GET_NONE,
+			GET_PROPERTY,
+			GET_CONSTANT,
+			GET_METHOD,
+			GET_SIGNAL,
+		};
+
+		StringName name;
+		MethodBind *method = nullptr;
+		const PropertySetGet *setget = nullptr;
+		const int64_t *constant = nullptr;
+		GetKind get_kind = GET_NONE; // What get_property() resolves the name to.
+	};
+
+	// Minimal perfect hash (hash and displace) over the LookupEntry of a class. Each name hashes to a
+	// bucket, whose seed was chosen when building so every name of the table lands in its own slot.
+	// Buckets holding a single name store its slot directly instead.
+	struct LookupTable {
+		static constexpr uint32_t DIRECT_SLOT = 0x80000000;
+
+		uint32_t bucket_mask = 0;
+		LocalVector<uint32_t> seeds;
+		LocalVector<LookupEntry> slots;
+		bool fallback = false; // Couldn't be built, lookups walk the inheritance chain instead.
+
+		_FORCE_INLINE_ static uint32_t get_seeded_slot(uint32_t p_hash, uint32_t p_seed, uint32_t p_slot_count) {
+			return (uint64_t(hash_fmix32(hash_murmur3_one_32(p_hash, p_seed))) * p_slot_count) >> 32;
+		}
+
+		bool build(const LocalVector<LookupEntry> &p_entries);
+
+		_FORCE_INLINE_ const LookupEntry *find(const StringName &p_name) const {
+			if (unlikely(slots.is_empty())) {
+				return nullptr;
+			}
+			uint32_t hash = p_name.hash();
+			uint32_t seed = seeds[hash & bucket_mask];
+			uint32_t slot = (seed & DIRECT_SLOT) ? (seed & ~DIRECT_SLOT) : get_seeded_slot(hash, seed, slots.size());
+			const LookupEntry &entry = slots[slot];
+			return entry.name == p_name ? &entry : nullptr;
+		}
+	};
+
+	// Built table of a class, or nullptr while stale. Lookups read it without the lock, so it's
+	// published with release and read with acquire. Copies start stale, a table only belongs to
+	// the ClassInfo registered in `classes`.
+	struct LookupTablePtr {
+		std::atomic<LookupTable *> table = { nullptr };
+
+		_FORCE_INLINE_ LookupTable *get() const { return table.load(std::memory_order_acquire); }
+		_FORCE_INLINE_ void publish(LookupTable *p_table) { table.store(p_table, std::memory_order_release); }
+		_FORCE_INLINE_ LookupTable *take() { return table.exchange(nullptr, std::memory_order_acq_rel); }
+
+		LookupTablePtr() {}
+		LookupTablePtr(const LookupTablePtr &p_other) {}
+		void operator=(const LookupTablePtr &p_other) { table.store(nullptr, std::memory_order_release); }
+	};
+
 	struct ClassInfo {
 		APIType api = API_NONE;
 		ClassInfo *inherits_ptr = nullptr;
@@ -135,6 +198,8 @@ public:
 		bool is_virtual = false;
 		Object *(*creation_func)() = nullptr;
 
+		LookupTablePtr lookup_table; // Built (again) on the next lookup while stale, once tables are enabled.
+
 		ClassInfo() {}
 		~ClassInfo() {}
 	};
@@ -178,6 +243,25 @@ private:
 	static MethodBind *_bind_vararg_method(MethodBind *p_bind, const StringName &p_name, const Vector<Variant> &p_default_args, bool p_compatibility);
 	static void _bind_method_custom(const StringName &p_class, MethodBind *p_method, bool p_compatibility);
 
+	// Lookup tables are built lazily once build_lookup_tables() enabled them. Changing the members
+	// of a class makes its table and the ones of the classes inheriting it stale, and each is
+	// built again on its next lookup.
+	static bool lookup_tables_enabled;
+	static uint32_t lookup_generation; // Bumped whenever a built table goes stale or a class is removed.
+	static LocalVector<LookupTable *> retired_lookup_tables; // Kept until cleanup, lookups without the lock may still use them.
+	static void _invalidate_lookup_tables(ClassInfo *p_class);
+	_FORCE_INLINE_ static bool _is_lookup_table_stale(const ClassInfo *p_class) {
+		return lookup_tables_enabled && !p_class->lookup_table.get();
+	}
+	_FORCE_INLINE_ static const LookupTable *_get_lookup_table(const ClassInfo *p_class) {
+		const LookupTable *table = p_class->lookup_table.get();
+		return (table && !table->fallback) ? table : nullptr;
+	}
+	static void _build_lookup_table(ClassInfo *p_class);
+	static void _build_stale_lookup_table(const StringName &p_class);
+	static MethodBind *_find_method(ClassInfo *p_class, const StringName &p_name);
+	static const PropertySetGet *_get_property_setget(ClassInfo *p_class, const StringName &p_property);
+
 public:
 	// DO NOT USE THIS!!!!!! NEEDS TO BE PUBLIC BUT DO NOT USE NO MATTER WHAT!!!
 	template <class T>
@@ -395,6 +479,7 @@ public:
 	static bool has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance = false);
 	static int get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
+	static const PropertySetGet *get_property_setget(const StringName &p_class, const StringName &p_property);
 	static StringName get_property_setter(const StringName &p_class, const StringName &p_property);
 	static StringName get_property_getter(const StringName &p_class, const StringName &p_property);
 
@@ -444,6 +529,11 @@ public:
 	static void set_current_api(APIType p_api);
 	static APIType get_current_api();
 	static void cleanup_defaults();
+	static void build_lookup_tables();
+	// Changes whenever members of classes that were already looked up change, or classes are removed.
+	// Registering new classes doesn't change it.
+	static uint32_t get_lookup_generation() { return lookup_generation; }
+
 	static void cleanup();
 
 	static void register_native_struct(const StringName &p_name, const String &p_code, uint64_t p_current_size);
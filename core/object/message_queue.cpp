@@ -34,38 +34,69 @@
 #include "core/core_string_names.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
 
 #include <stdio.h>
 
+uint8_t *CallQueue::_alloc_message(uint32_t p_room_needed, Lane *&r_lane) {
 #ifdef DEV_ENABLED
-// Includes safety checks to ensure that a queue set as a thread singleton override
-// is only ever called from the thread it was set for.
-#define LOCK_MUTEX                                     \
-	if (this != MessageQueue::thread_singleton) {      \
-		DEV_ASSERT(!this->is_current_thread_override); \
-		mutex.lock();                                  \
-	} else {                                           \
-		DEV_ASSERT(this->is_current_thread_override);  \
-	}
-#else
-#define LOCK_MUTEX                                \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.lock();                             \
-	}
+	// A queue set as a thread singleton override must only ever be used from the thread it was set for.
+	DEV_ASSERT((this == MessageQueue::thread_singleton) == is_current_thread_override);
 #endif
 
-#define UNLOCK_MUTEX                              \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.unlock();                           \
+	Lane &lane = lanes[Thread::get_caller_id() % LANE_COUNT];
+	lane.lock.lock();
+
+	if (!lane.last || (lane.last->bytes + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used.get() >= max_pages) {
+			lane.lock.unlock();
+			return nullptr;
+		}
+		Page *page = allocator->alloc();
+		max_pages_used.exchange_if_greater(pages_used.increment());
+		if (lane.last) {
+			lane.last->next = page;
+		} else {
+			lane.first = page;
+		}
+		lane.last = page;
+	}
+
+	// The lane is kept locked until the message is constructed, so a flush can't see it half-written.
+	uint8_t *buffer = &lane.last->data[lane.last->bytes];
+	lane.last->bytes += p_room_needed;
+	r_lane = &lane;
+	return buffer;
+}
+
+CallQueue::Page *CallQueue::_take_lane_pages(Lane &p_lane) {
+	p_lane.lock.lock();
+	Page *first = p_lane.first;
+	p_lane.first = nullptr;
+	p_lane.last = nullptr;
+	p_lane.lock.unlock();
+	return first;
+}
+
+void CallQueue::_free_pages(Page *p_page) {
+	while (p_page) {
+		Page *next = p_page->next;
+		allocator->free(p_page);
+		pages_used.decrement();
+		p_page = next;
 	}
+}
 
-void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
-		pages.push_back(allocator->alloc());
-		page_bytes.push_back(0);
+void CallQueue::_destroy_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+
+	p_message->~Message();
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -89,24 +120,14 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	Lane *lane = nullptr;
+	uint8_t *buffer_end = _alloc_message(room_needed, lane);
+	if (!buffer_end) {
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
@@ -127,37 +148,27 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	lane->lock.unlock();
+	bytes_pending.add(room_needed);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	Lane *lane = nullptr;
+	uint8_t *buffer_end = _alloc_message(room_needed, lane);
+	if (!buffer_end) {
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
@@ -168,32 +179,24 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	lane->lock.unlock();
+	bytes_pending.add(room_needed);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %s target ID: %s. Message queue out of memory. %s\n", itos(p_notification).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	Lane *lane = nullptr;
+	uint8_t *buffer_end = _alloc_message(room_needed, lane);
+	if (!buffer_end) {
+		fprintf(stderr, "Failed notification: %s target ID: %s. Message queue out of memory. %s\n", itos(p_notification).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 
 	msg->type = TYPE_NOTIFICATION;
@@ -201,8 +204,8 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	lane->lock.unlock();
+	bytes_pending.add(room_needed);
 
 	return OK;
 }
@@ -225,54 +228,66 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 }
 
 Error CallQueue::_transfer_messages_to_main_queue() {
-	if (pages.size() == 0) {
+	if (bytes_pending.get() == 0) {
 		return OK;
 	}
 
 	CallQueue *mq = MessageQueue::main_singleton;
-	DEV_ASSERT(!mq->allocator_is_custom && !allocator_is_custom); // Transferring pages is only safe if using the same alloator parameters.
-
-	mq->mutex.lock();
 
 	// Here we're transferring the data from this queue to the main one.
 	// However, it's very unlikely big amounts of messages will be queued here,
 	// so PagedArray/Pool would be overkill. Also, in most cases the data will fit
-	// an already existing page of the main queue.
-
-	// Let's see if our first (likely only) page fits the current target queue page.
-	uint32_t src_page = 0;
-	{
-		if (mq->pages_used) {
-			uint32_t dst_page = mq->pages_used - 1;
-			uint32_t dst_offset = mq->page_bytes[dst_page];
-			if (dst_offset + page_bytes[0] < uint32_t(PAGE_SIZE_BYTES)) {
-				memcpy(mq->pages[dst_page]->data + dst_offset, pages[0]->data, page_bytes[0]);
-				mq->page_bytes[dst_page] += page_bytes[0];
-				src_page++;
-			}
-		}
-	}
+	// an already existing page of the main queue. Pages are copied whole, since
+	// they may come from a different allocator.
+	Lane &dst = mq->lanes[Thread::get_caller_id() % LANE_COUNT];
+
+	for (uint32_t i = 0; i < LANE_COUNT; i++) {
+		Page *page = _take_lane_pages(lanes[i]);
+		while (page) {
+			dst.lock.lock();
+			if (!dst.last || (dst.last->bytes + page->bytes) > uint32_t(PAGE_SIZE_BYTES)) {
+				if (mq->pages_used.get() >= mq->max_pages) {
+					dst.lock.unlock();
+					// Give the remaining pages back, so they are released with this queue.
+					lanes[i].lock.lock();
+					Page *last = page;
+					while (last->next) {
+						last = last->next;
+					}
+					last->next = lanes[i].first;
+					if (!lanes[i].last) {
+						lanes[i].last = last;
+					}
+					lanes[i].first = page;
+					lanes[i].lock.unlock();
 
-	// Any other possibly existing source page needs to be added.
+					ERR_PRINT("Failed appending thread queue. Message queue out of memory. " + mq->error_text);
+					mq->statistics();
+					return ERR_OUT_OF_MEMORY;
+				}
+				Page *dst_page = mq->allocator->alloc();
+				mq->max_pages_used.exchange_if_greater(mq->pages_used.increment());
+				if (dst.last) {
+					dst.last->next = dst_page;
+				} else {
+					dst.first = dst_page;
+				}
+				dst.last = dst_page;
+			}
+			memcpy(dst.last->data + dst.last->bytes, page->data, page->bytes);
+			dst.last->bytes += page->bytes;
+			dst.lock.unlock();
 
-	if (mq->pages_used + (pages_used - src_page) > mq->max_pages) {
-		ERR_PRINT("Failed appending thread queue. Message queue out of memory. " + mq->error_text);
-		mq->statistics();
-		mq->mutex.unlock();
-		return ERR_OUT_OF_MEMORY;
-	}
+			mq->bytes_pending.add(page->bytes);
+			bytes_pending.sub(page->bytes);
 
-	for (; src_page < pages_used; src_page++) {
-		mq->_add_page();
-		memcpy(mq->pages[mq->pages_used - 1]->data, pages[src_page]->data, page_bytes[src_page]);
-		mq->page_bytes[mq->pages_used - 1] = page_bytes[src_page];
+			Page *next = page->next;
+			allocator->free(page);
+			pages_used.decrement();
+			page = next;
+		}
 	}
 
-	mq->mutex.unlock();
-
-	page_bytes[0] = 0;
-	pages_used = 1;
-
 	return OK;
 }
 
@@ -282,206 +297,154 @@ Error CallQueue::flush() {
 		return _transfer_messages_to_main_queue();
 	}
 
-	LOCK_MUTEX;
-
-	if (pages.size() == 0) {
-		// Never allocated
-		UNLOCK_MUTEX;
-		return OK; // Do nothing.
-	}
-
+	mutex.lock();
 	if (flushing) {
-		UNLOCK_MUTEX;
+		mutex.unlock();
 		return ERR_BUSY;
 	}
-
 	flushing = true;
+	mutex.unlock();
+
+	uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+	uint64_t bytes_flushed = 0;
+
+	// Keep going until all lanes are empty, so a call can re-add itself to the message queue.
+	bool found = true;
+	while (found) {
+		found = false;
+		for (uint32_t i = 0; i < LANE_COUNT; i++) {
+			Page *first = _take_lane_pages(lanes[i]);
+			if (!first) {
+				continue;
+			}
+			found = true;
+
+			for (Page *page = first; page; page = page->next) {
+				uint32_t offset = 0;
+				while (offset < page->bytes) {
+					Message *message = (Message *)&page->data[offset];
+					offset += _get_message_size(message);
+
+					Object *target = message->callable.get_object();
+
+					switch (message->type & FLAG_MASK) {
+						case TYPE_CALL: {
+							if (target || (message->type & FLAG_NULL_IS_OK)) {
+								Variant *args = (Variant *)(message + 1);
+								_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+							}
+						} break;
+						case TYPE_NOTIFICATION: {
+							if (target) {
+								target->notification(message->notification);
+							}
+						} break;
+						case TYPE_SET: {
+							if (target) {
+								Variant *arg = (Variant *)(message + 1);
+								target->set(message->callable.get_method(), *arg);
+							}
+						} break;
+					}
 
-	uint32_t i = 0;
-	uint32_t offset = 0;
-
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
-
-		//lock on each iteration, so a call can re-add itself to the message queue
-
-		Message *message = (Message *)&page->data[offset];
-
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
-
-		//pre-advance so this function is reentrant
-		offset += advance;
-
-		Object *target = message->callable.get_object();
-
-		UNLOCK_MUTEX;
-
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
+					_destroy_message(message);
 				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
-				}
-			} break;
-		}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
+				bytes_pending.sub(page->bytes);
+				bytes_flushed += page->bytes;
 			}
-		}
-
-		message->~Message();
 
-		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
+			_free_pages(first);
 		}
 	}
 
-	page_bytes[0] = 0;
-	pages_used = 1;
+	last_flush_bytes.set(bytes_flushed);
+	last_flush_usec.set(OS::get_singleton()->get_ticks_usec() - begin_usec);
 
+	mutex.lock();
 	flushing = false;
-	UNLOCK_MUTEX;
+	mutex.unlock();
 	return OK;
 }
 
 void CallQueue::clear() {
-	LOCK_MUTEX;
-
-	if (pages.size() == 0) {
-		UNLOCK_MUTEX;
-		return; // Nothing to clear.
-	}
-
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
-
-			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
+	for (uint32_t i = 0; i < LANE_COUNT; i++) {
+		Page *first = _take_lane_pages(lanes[i]);
+		for (Page *page = first; page; page = page->next) {
+			uint32_t offset = 0;
+			while (offset < page->bytes) {
+				Message *message = (Message *)&page->data[offset];
+				offset += _get_message_size(message);
+				_destroy_message(message);
 			}
-
-			message->~Message();
+			bytes_pending.sub(page->bytes);
 		}
+		_free_pages(first);
 	}
-
-	pages_used = 1;
-	page_bytes[0] = 0;
-
-	UNLOCK_MUTEX;
 }
 
 void CallQueue::statistics() {
-	LOCK_MUTEX;
 	HashMap<StringName, int> set_count;
 	HashMap<int, int> notify_count;
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
 
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
-
-			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			Object *target = message->callable.get_object();
-
-			bool null_target = true;
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (target || (message->type & FLAG_NULL_IS_OK)) {
-						if (!call_count.has(message->callable)) {
-							call_count[message->callable] = 0;
+	for (uint32_t i = 0; i < LANE_COUNT; i++) {
+		lanes[i].lock.lock();
+		for (Page *page = lanes[i].first; page; page = page->next) {
+			uint32_t offset = 0;
+			while (offset < page->bytes) {
+				Message *message = (Message *)&page->data[offset];
+				offset += _get_message_size(message);
+
+				Object *target = message->callable.get_object();
+
+				bool null_target = true;
+				switch (message->type & FLAG_MASK) {
+					case TYPE_CALL: {
+						if (target || (message->type & FLAG_NULL_IS_OK)) {
+							if (!call_count.has(message->callable)) {
+								call_count[message->callable] = 0;
+							}
+
+							call_count[message->callable]++;
+							null_target = false;
 						}
-
-						call_count[message->callable]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (target) {
-						if (!notify_count.has(message->notification)) {
-							notify_count[message->notification] = 0;
+					} break;
+					case TYPE_NOTIFICATION: {
+						if (target) {
+							if (!notify_count.has(message->notification)) {
+								notify_count[message->notification] = 0;
+							}
+
+							notify_count[message->notification]++;
+							null_target = false;
 						}
-
-						notify_count[message->notification]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_SET: {
-					if (target) {
-						StringName t = message->callable.get_method();
-						if (!set_count.has(t)) {
-							set_count[t] = 0;
+					} break;
+					case TYPE_SET: {
+						if (target) {
+							StringName t = message->callable.get_method();
+							if (!set_count.has(t)) {
+								set_count[t] = 0;
+							}
+
+							set_count[t]++;
+							null_target = false;
 						}
+					} break;
+				}
+				if (null_target) {
+					//object was deleted
+					print_line("Object was deleted while awaiting a callback");
 
-						set_count[t]++;
-						null_target = false;
-					}
-				} break;
-			}
-			if (null_target) {
-				//object was deleted
-				print_line("Object was deleted while awaiting a callback");
-
-				null_count++;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
+					null_count++;
 				}
 			}
-
-			message->~Message();
 		}
+		lanes[i].lock.unlock();
 	}
 
-	print_line("TOTAL PAGES: " + itos(pages_used) + " (" + itos(pages_used * PAGE_SIZE_BYTES) + " bytes).");
+	print_line("TOTAL PAGES: " + itos(pages_used.get()) + " (" + itos(pages_used.get() * PAGE_SIZE_BYTES) + " bytes).");
 	print_line("NULL count: " + itos(null_count));
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -495,8 +458,6 @@ void CallQueue::statistics() {
 	for (const KeyValue<int, int> &E : notify_count) {
 		print_line("NOTIFY " + itos(E.key) + ": " + itos(E.value));
 	}
-
-	UNLOCK_MUTEX;
 }
 
 bool CallQueue::is_flushing() const {
@@ -504,18 +465,19 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
-		return false;
-	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
-		return false;
-	}
-
-	return true;
+	return bytes_pending.get() > 0;
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	return max_pages_used.get() * PAGE_SIZE_BYTES;
+}
+
+uint64_t CallQueue::get_last_flush_bytes() const {
+	return last_flush_bytes.get();
+}
+
+uint64_t CallQueue::get_last_flush_usec() const {
+	return last_flush_usec.get();
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -531,11 +493,8 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 }
 
 CallQueue::~CallQueue() {
-	clear();
 	// Let go of pages.
-	for (uint32_t i = 0; i < pages.size(); i++) {
-		allocator->free(pages[i]);
-	}
+	clear();
 	if (!allocator_is_custom) {
 		memdelete(allocator);
 	}
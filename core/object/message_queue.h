@@ -49,6 +49,8 @@ public:
 
 	struct Page {
 		uint8_t data[PAGE_SIZE_BYTES];
+		Page *next = nullptr;
+		uint32_t bytes = 0;
 	};
 
 	// Needs to be public to be able to define it outside the class.
@@ -66,17 +68,36 @@ private:
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
-	Mutex mutex;
+	enum {
+		LANE_COUNT = 16
+	};
+
+	// Each thread pushes to its own lane, so producers don't contend on a queue-wide lock.
+	// Lanes are merged on flush, which keeps messages from a single thread in order.
+	// Messages are constructed with the lane locked, which copies Variants and may allocate pages,
+	// so this is a mutex rather than a spin lock.
+	struct Lane {
+		Mutex lock;
+		Page *first = nullptr;
+		Page *last = nullptr;
+	};
+
+	Mutex mutex; // Only guards the flushing state.
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
 
-	LocalVector<Page *> pages;
-	LocalVector<uint32_t> page_bytes;
+	Lane lanes[LANE_COUNT];
 	uint32_t max_pages = 0;
-	uint32_t pages_used = 0;
+	SafeNumeric<uint32_t> pages_used;
+	SafeNumeric<uint32_t> max_pages_used;
+	SafeNumeric<uint64_t> bytes_pending;
 	bool flushing = false;
 
+	// Written by flush(), and can be read from any thread.
+	SafeNumeric<uint64_t> last_flush_bytes;
+	SafeNumeric<uint64_t> last_flush_usec;
+
 #ifdef DEV_ENABLED
 	bool is_current_thread_override = false;
 #endif
@@ -90,17 +111,20 @@ private:
 		};
 	};
 
-	_FORCE_INLINE_ void _ensure_first_page() {
-		if (unlikely(pages.is_empty())) {
-			pages.push_back(allocator->alloc());
-			page_bytes.push_back(0);
-			pages_used = 1;
+	_FORCE_INLINE_ static uint32_t _get_message_size(const Message *p_message) {
+		uint32_t size = sizeof(Message);
+		if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+			size += sizeof(Variant) * p_message->args;
 		}
+		return size;
 	}
 
 	Error _transfer_messages_to_main_queue();
 
-	void _add_page();
+	uint8_t *_alloc_message(uint32_t p_room_needed, Lane *&r_lane);
+	Page *_take_lane_pages(Lane &p_lane);
+	void _free_pages(Page *p_page);
+	void _destroy_message(Message *p_message);
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -154,6 +178,8 @@ public:
 
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
+	uint64_t get_last_flush_bytes() const;
+	uint64_t get_last_flush_usec() const;
 
 	CallQueue(Allocator *p_custom_allocator = 0, uint32_t p_max_pages = 8192, const String &p_error_text = String());
 	virtual ~CallQueue();
@@ -0,0 +1,216 @@
+/**************************************************************************/
+/*  property_accessor.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "property_accessor.h"
+
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/object/object.h"
+#include "core/variant/variant_internal.h"
+
+void PropertyAccessor::set_names(const Vector<StringName> &p_names) {
+	names = p_names;
+	bound = false;
+	members.clear();
+	if (names.size() > 1) {
+		members.resize(names.size() - 1);
+	}
+}
+
+void PropertyAccessor::_bind(Object *p_object) {
+	bound = true;
+	bound_class = p_object->get_class_name();
+	bound_generation = ClassDB::get_lookup_generation();
+	bound_direct = false;
+	setter = nullptr;
+	getter = nullptr;
+	setget_index = -1;
+
+	const ClassDB::PropertySetGet *psg = ClassDB::get_property_setget(bound_class, names[0]);
+	if (!psg || !psg->_setptr || !psg->_getptr) {
+		return;
+	}
+
+	setter = psg->_setptr;
+	getter = psg->_getptr;
+	setget_index = psg->index;
+	bound_direct = true;
+}
+
+Variant PropertyAccessor::_get_first(Object *p_object, bool &r_valid) {
+	if (unlikely(!bound || bound_class != p_object->get_class_name() || bound_generation != ClassDB::get_lookup_generation())) {
+		_bind(p_object);
+	}
+
+	if (!bound_direct || p_object->script_instance || p_object->_extension) {
+		return p_object->get(names[0], &r_valid);
+	}
+
+	Callable::CallError ce;
+	Variant ret;
+	if (setget_index >= 0) {
+		Variant index = setget_index;
+		const Variant *args[1] = { &index };
+		ret = getter->call(p_object, args, 1, ce);
+	} else {
+		ret = getter->call(p_object, nullptr, 0, ce);
+	}
+	r_valid = ce.error == Callable::CallError::CALL_OK;
+	return ret;
+}
+
+void PropertyAccessor::_set_first(Object *p_object, const Variant &p_value, bool &r_valid) {
+	if (unlikely(!bound || bound_class != p_object->get_class_name() || bound_generation != ClassDB::get_lookup_generation())) {
+		_bind(p_object);
+	}
+
+	if (!bound_direct || p_object->script_instance || p_object->_extension) {
+		p_object->set(names[0], p_value, &r_valid);
+		return;
+	}
+
+#ifdef TOOLS_ENABLED
+	p_object->_edited = true;
+#endif
+
+	Callable::CallError ce;
+	if (setget_index >= 0) {
+		Variant index = setget_index;
+		const Variant *args[2] = { &index, &p_value };
+		setter->call(p_object, args, 2, ce);
+	} else if (!setter->has_return() && !setter->is_vararg() && p_value.get_type() != Variant::OBJECT && setter->get_argument_type(0) == p_value.get_type()) {
+		// Objects still go through call(), which checks their class.
+		const Variant *args[1] = { &p_value };
+		setter->validated_call(p_object, args, nullptr);
+	} else {
+		const Variant *args[1] = { &p_value };
+		setter->call(p_object, args, 1, ce);
+	}
+	r_valid = ce.error == Callable::CallError::CALL_OK;
+}
+
+PropertyAccessor::Member &PropertyAccessor::_get_member(uint32_t p_index, Variant::Type p_base_type) {
+	Member &member = members[p_index - 1];
+	if (unlikely(member.base_type != p_base_type)) {
+		member.base_type = p_base_type;
+		member.type = Variant::get_member_type(p_base_type, names[p_index]);
+		member.setter = Variant::get_member_validated_setter(p_base_type, names[p_index]);
+		member.getter = Variant::get_member_validated_getter(p_base_type, names[p_index]);
+	}
+	return member;
+}
+
+Variant PropertyAccessor::get(Object *p_object, bool *r_valid) {
+	bool valid = false;
+	if (unlikely(!p_object || names.is_empty())) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		return Variant();
+	}
+
+	Variant value = _get_first(p_object, valid);
+	for (int i = 1; i < names.size() && valid; i++) {
+		const Member &member = _get_member(i, value.get_type());
+		if (member.getter) {
+			Variant member_value;
+			VariantInternal::initialize(&member_value, member.type);
+			member.getter(&value, &member_value);
+			value = member_value;
+		} else {
+			value = value.get_named(names[i], valid);
+		}
+	}
+
+	if (r_valid) {
+		*r_valid = valid;
+	}
+	return value;
+}
+
+void PropertyAccessor::set(Object *p_object, const Variant &p_value, bool *r_valid) {
+	bool valid = false;
+	if (unlikely(!p_object || names.is_empty())) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		return;
+	}
+
+	if (names.size() == 1) {
+		_set_first(p_object, p_value, valid);
+		if (r_valid) {
+			*r_valid = valid;
+		}
+		return;
+	}
+
+	if (unlikely(names.size() > MAX_DEPTH)) {
+		p_object->set_indexed(names, p_value, r_valid);
+		return;
+	}
+
+	// Read down to the parent of the last name, then write back up.
+	Variant values[MAX_DEPTH];
+	const int last = names.size() - 1;
+	values[0] = _get_first(p_object, valid);
+	for (int i = 1; i < last && valid; i++) {
+		const Member &member = _get_member(i, values[i - 1].get_type());
+		if (member.getter) {
+			VariantInternal::initialize(&values[i], member.type);
+			member.getter(&values[i - 1], &values[i]);
+		} else {
+			values[i] = values[i - 1].get_named(names[i], valid);
+		}
+	}
+
+	const Variant *value = &p_value;
+	for (int i = last; i > 0 && valid; i--) {
+		const Member &member = _get_member(i, values[i - 1].get_type());
+		if (member.setter && member.type == value->get_type()) {
+			member.setter(&values[i - 1], value);
+		} else {
+			values[i - 1].set_named(names[i], *value, valid);
+		}
+		value = &values[i - 1];
+	}
+
+	if (valid) {
+		_set_first(p_object, values[0], valid);
+	}
+
+	if (r_valid) {
+		*r_valid = valid;
+	}
+}
+
+PropertyAccessor::PropertyAccessor(const Vector<StringName> &p_names) {
+	set_names(p_names);
+}
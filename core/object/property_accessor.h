@@ -0,0 +1,90 @@
+/**************************************************************************/
+/*  property_accessor.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PROPERTY_ACCESSOR_H
+#define PROPERTY_ACCESSOR_H
+
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/vector.h"
+#include "core/variant/variant.h"
+
+class MethodBind;
+class Object;
+
+// A property path (the names used by Object::set_indexed(), like "position:x"), compiled for
+// repeated access. The first name is bound to the native setter and getter of the object class,
+// so setting or getting it skips the name lookups done by Object::set() and Object::get(). The
+// following names use the validated member setters and getters of the value types.
+//
+// The binding is redone when the accessor is used with an object of another class, or after the
+// members of classes already looked up changed. Objects with a script or extension instance take
+// the regular path for the first name, as those can intercept any property.
+class PropertyAccessor {
+	Vector<StringName> names;
+
+	StringName bound_class;
+	uint32_t bound_generation = 0;
+	bool bound = false;
+	bool bound_direct = false; // Whether the first name can use setter and getter directly.
+	MethodBind *setter = nullptr;
+	MethodBind *getter = nullptr;
+	int setget_index = -1;
+
+	struct Member {
+		Variant::Type base_type = Variant::NIL;
+		Variant::Type type = Variant::NIL;
+		Variant::ValidatedSetter setter = nullptr;
+		Variant::ValidatedGetter getter = nullptr;
+	};
+	LocalVector<Member> members; // One for each name after the first.
+
+	void _bind(Object *p_object);
+	Variant _get_first(Object *p_object, bool &r_valid);
+	void _set_first(Object *p_object, const Variant &p_value, bool &r_valid);
+	Member &_get_member(uint32_t p_index, Variant::Type p_base_type);
+
+public:
+	enum {
+		MAX_DEPTH = 8,
+	};
+
+	void set_names(const Vector<StringName> &p_names);
+	_FORCE_INLINE_ const Vector<StringName> &get_names() const { return names; }
+	_FORCE_INLINE_ bool is_empty() const { return names.is_empty(); }
+
+	Variant get(Object *p_object, bool *r_valid = nullptr);
+	void set(Object *p_object, const Variant &p_value, bool *r_valid = nullptr);
+
+	PropertyAccessor() {}
+	PropertyAccessor(const Vector<StringName> &p_names);
+};
+
+#endif // PROPERTY_ACCESSOR_H
@@ -43,18 +43,61 @@ void WorkerThreadPool::Task::free_template_userdata() {
 
 WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 
+thread_local int WorkerThreadPool::current_thread_index = -1;
+thread_local WorkerThreadPool::Task *WorkerThreadPool::current_task = nullptr;
+
 void WorkerThreadPool::_process_task_queue() {
-	task_mutex.lock();
-	Task *task = task_queue.first()->self();
-	task_queue.remove(task_queue.first());
-	task_mutex.unlock();
+	Task *task = _pop_task_from_queues();
 	_process_task(task);
 }
 
+void WorkerThreadPool::_push_task_to_queue(Task *p_task) {
+	// Tasks posted from a pool thread go to its own queue, so they are likely to run on the same core.
+	// Tasks posted from elsewhere are spread across queues, so posters don't contend on a single lock.
+	uint32_t index = current_thread_index >= 0 ? (uint32_t)current_thread_index : next_queue_index.postincrement() % threads.size();
+	ThreadData &td = threads[index];
+	td.queue_mutex.lock();
+	td.task_queue.add_last(&p_task->task_elem);
+	td.queue_mutex.unlock();
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_pop_task_from_queues() {
+	// The caller has acquired task_available_semaphore, so there is a task queued for it somewhere,
+	// even if other threads may be racing for the one that is seen first.
+	uint32_t thread_count = threads.size();
+	uint32_t own_index = current_thread_index >= 0 ? (uint32_t)current_thread_index : 0;
+	while (true) {
+		// Own queue first, taking the newest task, which is the most likely to be hot in cache.
+		ThreadData &own = threads[own_index];
+		own.queue_mutex.lock();
+		SelfList<Task> *E = own.task_queue.last();
+		if (E) {
+			own.task_queue.remove(E);
+			own.queue_mutex.unlock();
+			return E->self();
+		}
+		own.queue_mutex.unlock();
+
+		// Otherwise, steal the oldest task from another thread.
+		for (uint32_t i = 1; i < thread_count; i++) {
+			ThreadData &victim = threads[(own_index + i) % thread_count];
+			victim.queue_mutex.lock();
+			E = victim.task_queue.first();
+			if (E) {
+				victim.task_queue.remove(E);
+				victim.queue_mutex.unlock();
+				return E->self();
+			}
+			victim.queue_mutex.unlock();
+		}
+	}
+}
+
 void WorkerThreadPool::_process_task(Task *p_task) {
 	bool low_priority = p_task->low_priority;
 	int pool_thread_index = -1;
 	Task *prev_low_prio_task = nullptr; // In case this is recursively called.
+	MemoryTagScope memory_tag(p_task->memory_tag);
 
 	if (!use_native_low_priority_threads) {
 		// Tasks must start with this unset. They are free to set-and-forget otherwise.
@@ -112,15 +155,16 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (low_priority && use_native_low_priority_threads) {
-			p_task->completed = true;
-			p_task->done_semaphore.post();
 			if (do_post) {
-				p_task->group->completed.set_to(true);
+				// Must happen before posting, since the awaiter frees the group afterwards.
+				_complete_group(p_task->group);
 			}
+			p_task->completed = true;
+			p_task->done_semaphore.post();
 		} else {
 			if (do_post) {
+				_complete_group(p_task->group);
 				p_task->group->done_semaphore.post();
-				p_task->group->completed.set_to(true);
 			}
 			uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 			uint32_t finished_users = p_task->group->finished.increment();
@@ -139,6 +183,8 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			task_mutex.unlock();
 		}
 	} else {
+		Task *prev_task = current_task;
+		current_task = p_task;
 		if (p_task->native_func) {
 			p_task->native_func(p_task->native_func_userdata);
 		} else if (p_task->template_userdata) {
@@ -147,16 +193,25 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		} else {
 			p_task->callable.call();
 		}
+		current_task = prev_task;
 
+		TightLocalVector<Task *> ready;
+		Task *parent = nullptr;
 		task_mutex.lock();
-		p_task->completed = true;
-		for (uint8_t i = 0; i < p_task->waiting; i++) {
-			p_task->done_semaphore.post();
-		}
 		if (!use_native_low_priority_threads) {
 			p_task->pool_thread_index = -1;
 		}
+		// If children are still running, the last of them to finish will complete this task.
+		if (p_task->pending_children.decrement() == 0) {
+			parent = p_task->parent;
+			_complete_task(p_task, ready);
+		}
 		task_mutex.unlock(); // Keep mutex down to here since on unlock the task may be freed.
+
+		_post_ready_tasks(ready);
+		if (parent) {
+			_child_task_completed(parent);
+		}
 	}
 
 	// Task may have been freed by now (all callers notified).
@@ -187,6 +242,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
+	current_thread_index = ((ThreadData *)p_user)->index;
 	while (true) {
 		singleton->task_available_semaphore.wait();
 		if (singleton->exit_threads) {
@@ -217,12 +273,9 @@ void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
 		p_task->low_priority_thread = native_thread_allocator.alloc();
 		task_mutex.unlock();
 
-		if (p_task->group) {
-			p_task->group->low_priority_native_tasks.push_back(p_task);
-		}
 		p_task->low_priority_thread->start(_native_low_priority_thread_function, p_task); // Pask task directly to thread.
 	} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-		task_queue.add_last(&p_task->task_elem);
+		_push_task_to_queue(p_task);
 		if (!p_high_priority) {
 			low_priority_threads_used++;
 		}
@@ -239,7 +292,7 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
 		low_priority_task_queue.remove(low_priority_task_queue.first());
-		task_queue.add_last(&low_prio_task->task_elem);
+		_push_task_to_queue(low_prio_task);
 		low_priority_threads_used++;
 		return true;
 	} else {
@@ -257,18 +310,98 @@ void WorkerThreadPool::_prevent_low_prio_saturation_deadlock() {
 		SelfList<Task> *to_promote = low_priority_task_queue.first();
 		if (to_promote) {
 			low_priority_task_queue.remove(to_promote);
-			task_queue.add_last(to_promote);
+			_push_task_to_queue(to_promote->self());
 			low_priority_threads_used++;
 			task_available_semaphore.post();
 		}
 	}
 }
 
+void WorkerThreadPool::_add_dependency(Task *p_task, TaskID p_dependency) {
+	// Must be called with task_mutex held.
+	Task **taskp = tasks.getptr(p_dependency);
+	if (taskp) {
+		if (!(*taskp)->completed) {
+			(*taskp)->continuations.push_back(p_task);
+			p_task->pending_dependencies++;
+		}
+		return;
+	}
+	Group **groupp = groups.getptr(p_dependency);
+	if (groupp) {
+		if (!(*groupp)->completed.is_set()) {
+			(*groupp)->continuations.push_back(p_task);
+			p_task->pending_dependencies++;
+		}
+		return;
+	}
+	// Tasks and groups that were already waited for are gone, but they are completed too.
+	ERR_FAIL_COND_MSG(p_dependency < 1 || p_dependency >= (TaskID)last_task, "Invalid Task or Group ID used as dependency.");
+}
+
+void WorkerThreadPool::_complete_task(Task *p_task, TightLocalVector<Task *> &r_ready) {
+	// Must be called with task_mutex held. Continuations that became ready are returned in r_ready,
+	// to be posted once the mutex is released.
+	p_task->completed = true;
+	for (uint32_t i = 0; i < p_task->waiting; i++) {
+		p_task->done_semaphore.post();
+	}
+	_release_continuations(p_task->continuations, r_ready);
+	if (p_task->detached) {
+		task_allocator.free(p_task);
+	}
+}
+
+void WorkerThreadPool::_complete_group(Group *p_group) {
+	TightLocalVector<Task *> ready;
+	task_mutex.lock();
+	_release_continuations(p_group->continuations, ready);
+	p_group->completed.set_to(true);
+	task_mutex.unlock();
+	_post_ready_tasks(ready);
+}
+
+void WorkerThreadPool::_release_continuations(TightLocalVector<Task *> &p_continuations, TightLocalVector<Task *> &r_ready) {
+	for (Task *continuation : p_continuations) {
+		continuation->pending_dependencies--;
+		if (continuation->pending_dependencies == 0) {
+			r_ready.push_back(continuation);
+		}
+	}
+	p_continuations.clear();
+}
+
+void WorkerThreadPool::_post_ready_tasks(const TightLocalVector<Task *> &p_ready) {
+	for (Task *task : p_ready) {
+		_post_task(task, !task->low_priority);
+	}
+}
+
+void WorkerThreadPool::_child_task_completed(Task *p_parent) {
+	// Completing a parent may in turn complete its own parent.
+	while (p_parent) {
+		TightLocalVector<Task *> ready;
+		Task *next = nullptr;
+		task_mutex.lock();
+		if (p_parent->pending_children.decrement() == 0) {
+			next = p_parent->parent;
+			_complete_task(p_parent, ready);
+		}
+		task_mutex.unlock();
+		_post_ready_tasks(ready);
+		p_parent = next;
+	}
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_with_dependencies(const Vector<TaskID> &p_dependencies, void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	task_mutex.lock();
 	// Get a free task
 	Task *task = task_allocator.alloc();
@@ -278,14 +411,54 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	task->memory_tag = Memory::get_thread_tag();
+	task->low_priority = !p_high_priority && threads.size() > 0;
+	task->pending_children.set(1);
+	for (const TaskID &dependency : p_dependencies) {
+		_add_dependency(task, dependency);
+	}
+	// Read under the lock, since a dependency may complete and post the task right after unlocking.
+	bool post_now = task->pending_dependencies == 0;
 	tasks.insert(id, task);
 	task_mutex.unlock();
 
-	_post_task(task, p_high_priority);
+	if (post_now) {
+		_post_task(task, p_high_priority);
+	}
 
 	return id;
 }
 
+void WorkerThreadPool::_add_child_task(void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, const String &p_description) {
+	Task *parent = current_task;
+	if (unlikely(!parent)) {
+		if (p_template_userdata) {
+			memdelete(p_template_userdata);
+		}
+		ERR_FAIL_MSG("Child tasks can only be added from within a running task.");
+	}
+
+	task_mutex.lock();
+	Task *task = task_allocator.alloc();
+	task->native_func = p_func;
+	task->native_func_userdata = p_userdata;
+	task->description = p_description;
+	task->template_userdata = p_template_userdata;
+	task->memory_tag = Memory::get_thread_tag();
+	task->pending_children.set(1);
+	task->parent = parent;
+	task->detached = true; // No task ID is used.
+	parent->pending_children.increment();
+	task_mutex.unlock();
+
+	// Children always run on the pool, as there is nobody to join a native thread for them.
+	_post_task(task, true);
+}
+
+void WorkerThreadPool::add_native_child_task(void (*p_func)(void *), void *p_userdata, const String &p_description) {
+	_add_child_task(p_func, p_userdata, nullptr, p_description);
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bool p_high_priority, const String &p_description) {
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
@@ -415,12 +588,14 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	return OK;
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
 	}
 
+	const Memory::Tag memory_tag = Memory::get_thread_tag();
+
 	task_mutex.lock();
 	Group *group = group_allocator.alloc();
 	GroupID id = last_task++;
@@ -428,6 +603,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	group->self = id;
 
 	Task **tasks_posted = nullptr;
+	bool post_now = true;
 	if (p_elements == 0) {
 		// Should really not call it with zero Elements, but at least it should work.
 		group->completed.set_to(true);
@@ -449,16 +625,28 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->group = group;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
+			task->memory_tag = memory_tag;
+			task->low_priority = !p_high_priority && threads.size() > 0;
+			for (const TaskID &dependency : p_dependencies) {
+				_add_dependency(task, dependency);
+			}
+			if (task->low_priority && use_native_low_priority_threads) {
+				group->low_priority_native_tasks.push_back(task);
+			}
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
+		// All tasks share the same dependencies, so they become ready at the same time.
+		post_now = tasks_posted[0]->pending_dependencies == 0;
 	}
 
 	groups[id] = group;
 	task_mutex.unlock();
 
-	for (int i = 0; i < p_tasks; i++) {
-		_post_task(tasks_posted[i], p_high_priority);
+	if (post_now) {
+		for (int i = 0; i < p_tasks; i++) {
+			_post_task(tasks_posted[i], p_high_priority);
+		}
 	}
 
 	return id;
@@ -468,6 +656,10 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)
 	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_with_dependencies(const Vector<TaskID> &p_dependencies, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
 WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
@@ -498,14 +690,16 @@ bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
 void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 	task_mutex.lock();
 	Group **groupp = groups.getptr(p_group);
+	Group *group = groupp ? *groupp : nullptr;
 	task_mutex.unlock();
-	if (!groupp) {
+	if (!group) {
 		ERR_FAIL_MSG("Invalid Group ID");
 	}
-	Group *group = *groupp;
 
 	if (group->low_priority_native_tasks.size() > 0) {
 		for (Task *task : group->low_priority_native_tasks) {
+			// The thread may not even be started yet if the group is waiting for dependencies.
+			task->done_semaphore.wait();
 			task->low_priority_thread->wait_to_finish();
 			task_mutex.lock();
 			native_thread_allocator.free(task->low_priority_thread);
@@ -514,11 +708,16 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		}
 
 		task_mutex.lock();
+		groups.erase(p_group); // Erase before freeing, so it's not found as a dependency meanwhile.
 		group_allocator.free(group);
 		task_mutex.unlock();
 	} else {
 		group->done_semaphore.wait();
 
+		task_mutex.lock();
+		groups.erase(p_group); // Erase before freeing, so it's not found as a dependency meanwhile.
+		task_mutex.unlock();
+
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
@@ -529,15 +728,10 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			task_mutex.unlock();
 		}
 	}
-
-	task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
-	task_mutex.unlock();
 }
 
 int WorkerThreadPool::get_thread_index() {
-	Thread::ID tid = Thread::get_caller_id();
-	return singleton->thread_ids.has(tid) ? singleton->thread_ids[tid] : -1;
+	return current_thread_index;
 }
 
 void WorkerThreadPool::init(int p_thread_count, bool p_use_native_threads_low_priority, float p_low_priority_task_ratio) {
@@ -553,6 +747,7 @@ void WorkerThreadPool::init(int p_thread_count, bool p_use_native_threads_low_pr
 	}
 
 	use_native_low_priority_threads = p_use_native_threads_low_priority;
+	exit_threads = false;
 
 	threads.resize(p_thread_count);
 
@@ -587,6 +782,7 @@ void WorkerThreadPool::finish() {
 	}
 
 	threads.clear();
+	thread_ids.clear();
 }
 
 void WorkerThreadPool::_bind_methods() {
@@ -69,6 +69,7 @@ private:
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
 		TightLocalVector<Task *> low_priority_native_tasks;
+		TightLocalVector<Task *> continuations; // Tasks waiting for this group to complete.
 	};
 
 	struct Task {
@@ -86,6 +87,14 @@ private:
 		BaseTemplateUserdata *template_userdata = nullptr;
 		Thread *low_priority_thread = nullptr;
 		int pool_thread_index = -1;
+		Memory::Tag memory_tag = Memory::TAG_DEFAULT; // Tag of the thread that added the task, allocations of the task use it too.
+
+		// Dependency tracking.
+		Task *parent = nullptr; // Set for child tasks, which the parent can't complete without.
+		SafeNumeric<uint32_t> pending_children; // Children still running, plus one for the task itself.
+		uint32_t pending_dependencies = 0; // The task is posted when this reaches zero.
+		TightLocalVector<Task *> continuations; // Tasks waiting for this one to complete.
+		bool detached = false; // Freed by the pool on completion, since nobody can wait for it.
 
 		void free_template_userdata();
 		Task() :
@@ -97,7 +106,6 @@ private:
 	PagedAllocator<Thread> native_thread_allocator;
 
 	SelfList<Task>::List low_priority_task_queue;
-	SelfList<Task>::List task_queue;
 
 	Mutex task_mutex;
 	Semaphore task_available_semaphore;
@@ -107,10 +115,18 @@ private:
 		Thread thread;
 		Task *current_low_prio_task = nullptr;
 		bool ready_for_scripting = false;
+
+		// Work-stealing queue. The owner pops from the back; other threads steal from the front.
+		BinaryMutex queue_mutex;
+		SelfList<Task>::List task_queue;
 	};
 
 	TightLocalVector<ThreadData> threads;
 	bool exit_threads = false;
+	SafeNumeric<uint32_t> next_queue_index; // Round-robin target for tasks posted from outside the pool.
+
+	static thread_local int current_thread_index;
+	static thread_local Task *current_task;
 
 	HashMap<Thread::ID, int> thread_ids;
 	HashMap<TaskID, Task *> tasks;
@@ -131,14 +147,24 @@ private:
 	void _process_task(Task *task);
 
 	void _post_task(Task *p_task, bool p_high_priority);
+	void _push_task_to_queue(Task *p_task);
+	Task *_pop_task_from_queues();
+
+	void _add_dependency(Task *p_task, TaskID p_dependency);
+	void _complete_task(Task *p_task, TightLocalVector<Task *> &r_ready);
+	void _complete_group(Group *p_group);
+	void _release_continuations(TightLocalVector<Task *> &p_continuations, TightLocalVector<Task *> &r_ready);
+	void _post_ready_tasks(const TightLocalVector<Task *> &p_ready);
+	void _child_task_completed(Task *p_parent);
 
 	bool _try_promote_low_priority_task();
 	void _prevent_low_prio_saturation_deadlock();
 
 	static WorkerThreadPool *singleton;
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies = Vector<TaskID>());
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies = Vector<TaskID>());
+	void _add_child_task(void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, const String &p_description);
 
 	template <class C, class M, class U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -176,6 +202,31 @@ public:
 	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Continuations: the task is only started once all the tasks and groups in p_dependencies have completed.
+	template <class C, class M, class U>
+	TaskID add_template_task_with_dependencies(const Vector<TaskID> &p_dependencies, C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, p_dependencies);
+	}
+	TaskID add_native_task_with_dependencies(const Vector<TaskID> &p_dependencies, void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
+
+	// Child tasks can only be added from within a running (non-group) task, which won't be considered
+	// completed until all its children are. They have no ID and are freed automatically.
+	template <class C, class M, class U>
+	void add_template_child_task(C *p_instance, M p_method, U p_userdata, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		_add_child_task(nullptr, nullptr, ud, p_description);
+	}
+	void add_native_child_task(void (*p_func)(void *), void *p_userdata, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -189,6 +240,16 @@ public:
 		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description);
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	template <class C, class M, class U>
+	GroupID add_template_group_task_with_dependencies(const Vector<TaskID> &p_dependencies, C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+	}
+	GroupID add_native_group_task_with_dependencies(const Vector<TaskID> &p_dependencies, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
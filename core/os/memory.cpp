@@ -61,6 +61,15 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
+SafeNumeric<uint64_t> Memory::alloc_calls;
+SafeNumeric<uint64_t> Memory::tag_usage[TAG_MAX];
+SafeNumeric<uint64_t> Memory::tag_alloc_count[TAG_MAX];
+
+// The top byte of the size stored in front of each allocation holds its tag.
+#define TAG_SHIFT 56
+#define SIZE_MASK ((uint64_t(1) << TAG_SHIFT) - 1)
+
+static thread_local Memory::Tag current_tag = Memory::TAG_DEFAULT;
 #endif
 
 SafeNumeric<uint64_t> Memory::alloc_count;
@@ -85,6 +94,12 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		uint8_t *s8 = (uint8_t *)mem;
 
 #ifdef DEBUG_ENABLED
+		Tag tag = current_tag;
+		*s |= uint64_t(tag) << TAG_SHIFT;
+		tag_usage[tag].add(p_bytes);
+		tag_alloc_count[tag].increment();
+
+		alloc_calls.increment();
 		uint64_t new_mem_usage = mem_usage.add(p_bytes);
 		max_usage.exchange_if_greater(new_mem_usage);
 #endif
@@ -112,11 +127,22 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		uint64_t *s = (uint64_t *)mem;
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
+		// Reallocations keep the tag of the original allocation.
+		uint64_t tag_bits = *s & ~SIZE_MASK;
+		Tag tag = Tag(*s >> TAG_SHIFT);
+		uint64_t old_bytes = *s & SIZE_MASK;
+
+		alloc_calls.increment();
+		if (p_bytes > old_bytes) {
+			uint64_t new_mem_usage = mem_usage.add(p_bytes - old_bytes);
 			max_usage.exchange_if_greater(new_mem_usage);
+			tag_usage[tag].add(p_bytes - old_bytes);
 		} else {
-			mem_usage.sub(*s - p_bytes);
+			mem_usage.sub(old_bytes - p_bytes);
+			tag_usage[tag].sub(old_bytes - p_bytes);
+		}
+		if (p_bytes == 0) {
+			tag_alloc_count[tag].decrement();
 		}
 #endif
 
@@ -132,6 +158,9 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 			s = (uint64_t *)mem;
 
 			*s = p_bytes;
+#ifdef DEBUG_ENABLED
+			*s |= tag_bits;
+#endif
 
 			return mem + PAD_ALIGN;
 		}
@@ -162,7 +191,11 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 #ifdef DEBUG_ENABLED
 		uint64_t *s = (uint64_t *)mem;
-		mem_usage.sub(*s);
+		Tag tag = Tag(*s >> TAG_SHIFT);
+		uint64_t bytes = *s & SIZE_MASK;
+		mem_usage.sub(bytes);
+		tag_usage[tag].sub(bytes);
+		tag_alloc_count[tag].decrement();
 #endif
 
 		free(mem);
@@ -191,6 +224,139 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+uint64_t Memory::get_alloc_calls() {
+#ifdef DEBUG_ENABLED
+	return alloc_calls.get();
+#else
+	return 0;
+#endif
+}
+
+#ifdef DEBUG_ENABLED
+Memory::Tag Memory::get_thread_tag() {
+	return current_tag;
+}
+
+void Memory::set_thread_tag(Tag p_tag) {
+	ERR_FAIL_INDEX(p_tag, TAG_MAX);
+	current_tag = p_tag;
+}
+#endif
+
+const char *Memory::get_tag_name(Tag p_tag) {
+	static const char *names[TAG_MAX] = {
+		"default",
+		"scene",
+		"physics",
+		"navigation",
+		"rendering",
+		"audio",
+		"resource",
+		"arena",
+	};
+
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, "");
+	return names[p_tag];
+}
+
+uint64_t Memory::get_tag_usage(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef DEBUG_ENABLED
+	return tag_usage[p_tag].get();
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_tag_alloc_count(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef DEBUG_ENABLED
+	return tag_alloc_count[p_tag].get();
+#else
+	return 0;
+#endif
+}
+
+MemoryArena::MemoryArena(size_t p_chunk_size) {
+	chunk_size = p_chunk_size;
+}
+
+MemoryArena::~MemoryArena() {
+	reset();
+	while (free_chunks) {
+		Chunk *chunk = free_chunks;
+		free_chunks = chunk->prev;
+		Memory::free_static(chunk);
+	}
+}
+
+void MemoryArena::_push_chunk(size_t p_min_size) {
+	// Reuse a free chunk if one is large enough.
+	Chunk **prev_link = &free_chunks;
+	Chunk *chunk = free_chunks;
+	while (chunk && chunk->size < p_min_size) {
+		prev_link = &chunk->prev;
+		chunk = chunk->prev;
+	}
+
+	if (chunk) {
+		*prev_link = chunk->prev;
+	} else {
+		MemoryTagScope tag(Memory::TAG_ARENA);
+		size_t size = MAX(chunk_size, p_min_size);
+		chunk = (Chunk *)Memory::alloc_static(CHUNK_HEADER_SIZE + size);
+		CRASH_COND_MSG(!chunk, "Out of memory allocating a memory arena chunk.");
+		chunk->size = size;
+	}
+
+	chunk->used = 0;
+	chunk->prev = current;
+	current = chunk;
+}
+
+void *MemoryArena::_alloc_slow(size_t p_bytes, size_t p_alignment) {
+	_push_chunk(p_bytes + p_alignment);
+	return alloc(p_bytes, p_alignment);
+}
+
+void MemoryArena::rewind(const Position &p_position) {
+	while (current != p_position.chunk) {
+		ERR_FAIL_NULL_MSG(current, "Rewinding a memory arena to a position that it no longer has.");
+		Chunk *chunk = current;
+		current = chunk->prev;
+		chunk->prev = free_chunks;
+		free_chunks = chunk;
+	}
+
+	if (current) {
+		current->used = p_position.used;
+	}
+}
+
+size_t MemoryArena::get_used_bytes() const {
+	size_t used = 0;
+	for (const Chunk *chunk = current; chunk; chunk = chunk->prev) {
+		used += chunk->used;
+	}
+	return used;
+}
+
+size_t MemoryArena::get_reserved_bytes() const {
+	size_t reserved = 0;
+	for (const Chunk *chunk = current; chunk; chunk = chunk->prev) {
+		reserved += chunk->size;
+	}
+	for (const Chunk *chunk = free_chunks; chunk; chunk = chunk->prev) {
+		reserved += chunk->size;
+	}
+	return reserved;
+}
+
+MemoryArena &MemoryArena::get_thread_scratch() {
+	static thread_local MemoryArena scratch;
+	return scratch;
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
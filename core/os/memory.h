@@ -43,9 +43,28 @@
 #endif
 
 class Memory {
+public:
+	// Subsystems allocations are attributed to, in debug builds. Allocations
+	// take the tag that is current on the calling thread, see MemoryTagScope.
+	enum Tag : uint8_t {
+		TAG_DEFAULT,
+		TAG_SCENE,
+		TAG_PHYSICS,
+		TAG_NAVIGATION,
+		TAG_RENDERING,
+		TAG_AUDIO,
+		TAG_RESOURCE,
+		TAG_ARENA,
+		TAG_MAX
+	};
+
+private:
 #ifdef DEBUG_ENABLED
 	static SafeNumeric<uint64_t> mem_usage;
 	static SafeNumeric<uint64_t> max_usage;
+	static SafeNumeric<uint64_t> alloc_calls;
+	static SafeNumeric<uint64_t> tag_usage[TAG_MAX];
+	static SafeNumeric<uint64_t> tag_alloc_count[TAG_MAX];
 #endif
 
 	static SafeNumeric<uint64_t> alloc_count;
@@ -58,6 +77,33 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+	// Number of allocations and reallocations done so far, for benchmarks.
+	static uint64_t get_alloc_calls();
+
+#ifdef DEBUG_ENABLED
+	static Tag get_thread_tag();
+	static void set_thread_tag(Tag p_tag);
+#else
+	_FORCE_INLINE_ static Tag get_thread_tag() { return TAG_DEFAULT; }
+	_FORCE_INLINE_ static void set_thread_tag(Tag p_tag) {}
+#endif
+	static const char *get_tag_name(Tag p_tag);
+	// Bytes and number of live allocations of a tag, only tracked in debug builds.
+	static uint64_t get_tag_usage(Tag p_tag);
+	static uint64_t get_tag_alloc_count(Tag p_tag);
+};
+
+class MemoryTagScope {
+	Memory::Tag prev_tag;
+
+public:
+	_FORCE_INLINE_ MemoryTagScope(Memory::Tag p_tag) {
+		prev_tag = Memory::get_thread_tag();
+		Memory::set_thread_tag(p_tag);
+	}
+	_FORCE_INLINE_ ~MemoryTagScope() {
+		Memory::set_thread_tag(prev_tag);
+	}
 };
 
 class DefaultAllocator {
@@ -206,4 +252,103 @@ public:
 	_FORCE_INLINE_ void delete_allocation(T *p_allocation) { memdelete(p_allocation); }
 };
 
+/**
+ * Bump allocator for short-lived data, such as buffers that only live for
+ * a frame. Allocating only moves a pointer forward, and memory is given back
+ * all at once by rewinding to a previous position. Chunks are kept around
+ * for reuse until the arena is destroyed.
+ *
+ * Each thread has its own scratch arena, meant to be used through
+ * MemoryArenaScope so everything allocated in a scope is released on exit.
+ */
+class MemoryArena {
+	struct Chunk {
+		Chunk *prev = nullptr;
+		size_t size = 0;
+		size_t used = 0;
+	};
+
+	static constexpr size_t CHUNK_HEADER_SIZE = (sizeof(Chunk) + 15) & ~size_t(15);
+
+	Chunk *current = nullptr;
+	Chunk *free_chunks = nullptr;
+	size_t chunk_size = 0;
+
+	_FORCE_INLINE_ static uint8_t *_get_chunk_data(Chunk *p_chunk) { return (uint8_t *)p_chunk + CHUNK_HEADER_SIZE; }
+	void _push_chunk(size_t p_min_size);
+	void *_alloc_slow(size_t p_bytes, size_t p_alignment);
+
+public:
+	struct Position {
+		Chunk *chunk = nullptr;
+		size_t used = 0;
+	};
+
+	_FORCE_INLINE_ void *alloc(size_t p_bytes, size_t p_alignment = 16) {
+		if (likely(current)) {
+			uintptr_t base = (uintptr_t)_get_chunk_data(current);
+			uintptr_t ptr = (base + current->used + p_alignment - 1) & ~(uintptr_t)(p_alignment - 1);
+			if (likely(ptr + p_bytes <= base + current->size)) {
+				current->used = ptr + p_bytes - base;
+				return (void *)ptr;
+			}
+		}
+		return _alloc_slow(p_bytes, p_alignment);
+	}
+
+	// Elements are not constructed, meant for trivial types.
+	template <class T>
+	_FORCE_INLINE_ T *alloc_array(size_t p_count) {
+		return (T *)alloc(sizeof(T) * p_count, alignof(T) > 16 ? alignof(T) : 16);
+	}
+
+	_FORCE_INLINE_ Position get_position() const {
+		Position position;
+		position.chunk = current;
+		position.used = current ? current->used : 0;
+		return position;
+	}
+	void rewind(const Position &p_position);
+	void reset() { rewind(Position()); }
+
+	size_t get_used_bytes() const;
+	size_t get_reserved_bytes() const;
+
+	static MemoryArena &get_thread_scratch();
+
+	MemoryArena(size_t p_chunk_size = 64 * 1024);
+	~MemoryArena();
+};
+
+class MemoryArenaScope {
+	MemoryArena &arena;
+	MemoryArena::Position position;
+
+public:
+	_FORCE_INLINE_ MemoryArena &get_arena() { return arena; }
+
+	_FORCE_INLINE_ MemoryArenaScope(MemoryArena &p_arena = MemoryArena::get_thread_scratch()) :
+			arena(p_arena) {
+		position = arena.get_position();
+	}
+	_FORCE_INLINE_ ~MemoryArenaScope() {
+		arena.rewind(position);
+	}
+};
+
+// Typed allocator (see DefaultTypedAllocator) that takes memory from the scratch
+// arena of the calling thread. Containers using it must not outlive the
+// MemoryArenaScope they were filled in.
+template <class T>
+class ScratchTypedAllocator {
+public:
+	template <class... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(MemoryArena::get_thread_scratch().alloc(sizeof(T), alignof(T) > 16 ? alignof(T) : 16), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		if (!std::is_trivially_destructible<T>::value) {
+			p_allocation->~T();
+		}
+	}
+};
+
 #endif // MEMORY_H
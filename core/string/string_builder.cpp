@@ -32,68 +32,66 @@
 
 #include <string.h>
 
+char32_t *StringBuilder::_grow(uint32_t p_length) {
+	// CowData rounds allocations up to the next power of two, so this only
+	// reallocates when crossing one. It also copies on write if the buffer
+	// was shared by a previous call to as_string().
+	buffer.resize(string_length + p_length + 1);
+	char32_t *dst = buffer.ptrw() + string_length;
+	dst[p_length] = 0;
+
+	string_length += p_length;
+	appended_count++;
+
+	return dst;
+}
+
 StringBuilder &StringBuilder::append(const String &p_string) {
 	if (p_string.is_empty()) {
 		return *this;
 	}
 
-	strings.push_back(p_string);
-	appended_strings.push_back(-1);
-
-	string_length += p_string.length();
+	int len = p_string.length();
+	memcpy(_grow(len), p_string.ptr(), len * sizeof(char32_t));
 
 	return *this;
 }
 
 StringBuilder &StringBuilder::append(const char *p_cstring) {
 	int32_t len = strlen(p_cstring);
+	if (len == 0) {
+		return *this;
+	}
 
-	c_strings.push_back(p_cstring);
-	appended_strings.push_back(len);
-
-	string_length += len;
+	char32_t *dst = _grow(len);
+	for (int32_t i = 0; i < len; i++) {
+		dst[i] = (uint8_t)p_cstring[i];
+	}
 
 	return *this;
 }
 
-String StringBuilder::as_string() const {
-	if (string_length == 0) {
-		return "";
+StringBuilder &StringBuilder::append(const char32_t *p_chars, int p_length) {
+	if (p_length <= 0) {
+		return *this;
 	}
 
-	char32_t *buffer = memnew_arr(char32_t, string_length);
-
-	int current_position = 0;
-
-	int godot_string_elem = 0;
-	int c_string_elem = 0;
+	memcpy(_grow(p_length), p_chars, p_length * sizeof(char32_t));
 
-	for (int i = 0; i < appended_strings.size(); i++) {
-		if (appended_strings[i] == -1) {
-			// Godot string
-			const String &s = strings[godot_string_elem];
-
-			memcpy(buffer + current_position, s.ptr(), s.length() * sizeof(char32_t));
-
-			current_position += s.length();
-
-			godot_string_elem++;
-		} else {
-			const char *s = c_strings[c_string_elem];
+	return *this;
+}
 
-			for (int32_t j = 0; j < appended_strings[i]; j++) {
-				buffer[current_position + j] = s[j];
-			}
+StringBuilder &StringBuilder::append(char32_t p_char) {
+	*_grow(1) = p_char;
 
-			current_position += appended_strings[i];
+	return *this;
+}
 
-			c_string_elem++;
-		}
+String StringBuilder::as_string() const {
+	if (string_length == 0) {
+		return "";
 	}
 
-	String final_string = String(buffer, string_length);
-
-	memdelete_arr(buffer);
-
-	return final_string;
+	// Shares the buffer, any further append will copy it first.
+	return buffer;
 }
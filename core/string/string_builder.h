@@ -36,17 +36,19 @@
 
 class StringBuilder {
 	uint32_t string_length = 0;
+	int appended_count = 0;
 
-	Vector<String> strings;
-	Vector<const char *> c_strings;
+	// Appended strings are written straight into the storage of the resulting
+	// String, which grows geometrically, so as_string() doesn't need to copy.
+	String buffer;
 
-	// -1 means it's a Godot String
-	// a natural number means C string.
-	Vector<int32_t> appended_strings;
+	char32_t *_grow(uint32_t p_length);
 
 public:
 	StringBuilder &append(const String &p_string);
 	StringBuilder &append(const char *p_cstring);
+	StringBuilder &append(const char32_t *p_chars, int p_length);
+	StringBuilder &append(char32_t p_char);
 
 	_FORCE_INLINE_ StringBuilder &operator+(const String &p_string) {
 		return append(p_string);
@@ -65,7 +67,7 @@ public:
 	}
 
 	_FORCE_INLINE_ int num_strings_appended() const {
-		return appended_strings.size();
+		return appended_count;
 	}
 
 	_FORCE_INLINE_ uint32_t get_string_length() const {
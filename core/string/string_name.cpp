@@ -32,6 +32,7 @@
 
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/hashfuncs.h"
 
 StaticCString StaticCString::create(const char *p_ptr) {
 	StaticCString scs;
@@ -39,7 +40,11 @@ StaticCString StaticCString::create(const char *p_ptr) {
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+StringName::_Stripe StringName::_stripes[STRING_TABLE_STRIPES];
+SafeNumeric<uint32_t> StringName::name_count;
+SafeNumeric<uint32_t> StringName::bucket_count;
+SafeNumeric<uint64_t> StringName::contended_usec;
+thread_local StringName::_CacheEntry StringName::thread_cache[THREAD_CACHE_LEN];
 
 StringName _scs_create(const char *p_chr, bool p_static) {
 	return (p_chr[0] ? StringName(StaticCString::create(p_chr), p_static) : StringName());
@@ -54,9 +59,18 @@ bool StringName::debug_stringname = false;
 
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		_table[i] = nullptr;
+	for (int i = 0; i < STRING_TABLE_STRIPES; i++) {
+		_Stripe &stripe = _stripes[i];
+		stripe.table = memnew_arr(_Data *, STRING_TABLE_STRIPE_MIN_LEN);
+		for (int j = 0; j < STRING_TABLE_STRIPE_MIN_LEN; j++) {
+			stripe.table[j] = nullptr;
+		}
+		stripe.mask = STRING_TABLE_STRIPE_MIN_LEN - 1;
+		stripe.count = 0;
 	}
+	name_count.set(0);
+	bucket_count.set(STRING_TABLE_STRIPES * STRING_TABLE_STRIPE_MIN_LEN);
+	contended_usec.set(0);
 	configured = true;
 }
 
@@ -66,11 +80,14 @@ void StringName::cleanup() {
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
-		for (int i = 0; i < STRING_TABLE_LEN; i++) {
-			_Data *d = _table[i];
-			while (d) {
-				data.push_back(d);
-				d = d->next;
+		for (int i = 0; i < STRING_TABLE_STRIPES; i++) {
+			const _Stripe &stripe = _stripes[i];
+			for (uint32_t j = 0; j <= stripe.mask; j++) {
+				_Data *d = stripe.table[j];
+				while (d) {
+					data.push_back(d);
+					d = d->next;
+				}
 			}
 		}
 
@@ -93,35 +110,229 @@ void StringName::cleanup() {
 	}
 #endif
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
-			if (d->static_count.get() != d->refcount.get()) {
-				lost_strings++;
-
-				if (OS::get_singleton()->is_stdout_verbose()) {
-					String dname = String(d->cname ? d->cname : d->name);
-
-					print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", dname, d->static_count.get(), d->refcount.get()));
+	for (int i = 0; i < STRING_TABLE_STRIPES; i++) {
+		_Stripe &stripe = _stripes[i];
+		for (uint32_t j = 0; j <= stripe.mask; j++) {
+			while (stripe.table[j]) {
+				_Data *d = stripe.table[j];
+				if (d->static_count.get() != d->refcount.get()) {
+					lost_strings++;
+
+					if (OS::get_singleton()->is_stdout_verbose()) {
+						String dname = String(d->cname ? d->cname : d->name);
+
+						print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", dname, d->static_count.get(), d->refcount.get()));
+					}
 				}
-			}
 
-			_table[i] = _table[i]->next;
-			memdelete(d);
+				stripe.table[j] = stripe.table[j]->next;
+				memdelete(d);
+			}
 		}
+		memdelete_arr(stripe.table);
+		stripe.table = nullptr;
+		stripe.mask = 0;
+		stripe.count = 0;
+		stripe.generation.fetch_add(1);
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
+	name_count.set(0);
+	bucket_count.set(0);
 	configured = false;
 }
 
+StringName::_Stripe &StringName::_get_stripe(uint32_t p_hash) {
+	// Buckets use the low bits of the hash, so pick the stripe from the high bits of a remix.
+	return _stripes[hash_fmix32(p_hash) >> (32 - STRING_TABLE_STRIPE_BITS)];
+}
+
+void StringName::_lock_stripe(_Stripe &p_stripe) {
+	if (likely(p_stripe.mutex.try_lock())) {
+		return;
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	p_stripe.mutex.lock();
+	contended_usec.add(OS::get_singleton()->get_ticks_usec() - begin);
+}
+
+void StringName::_grow_stripe(_Stripe &p_stripe) {
+	// Stripe must be locked.
+	uint32_t old_len = p_stripe.mask + 1;
+	uint32_t new_len = old_len * 2;
+	_Data **new_table = memnew_arr(_Data *, new_len);
+	for (uint32_t i = 0; i < new_len; i++) {
+		new_table[i] = nullptr;
+	}
+
+	for (uint32_t i = 0; i < old_len; i++) {
+		_Data *d = p_stripe.table[i];
+		while (d) {
+			_Data *next = d->next;
+			uint32_t idx = d->hash & (new_len - 1);
+			d->prev = nullptr;
+			d->next = new_table[idx];
+			if (new_table[idx]) {
+				new_table[idx]->prev = d;
+			}
+			new_table[idx] = d;
+			d = next;
+		}
+	}
+
+	memdelete_arr(p_stripe.table);
+	p_stripe.table = new_table;
+	p_stripe.mask = new_len - 1;
+	bucket_count.add(new_len - old_len);
+}
+
+template <class T>
+StringName::_Data *StringName::_intern(const T &p_name, uint32_t p_hash, bool p_static, const char *p_cname) {
+	_Stripe &stripe = _get_stripe(p_hash);
+	_lock_stripe(stripe);
+
+	_Data *data = stripe.table[p_hash & stripe.mask];
+
+	while (data) {
+		// compare hash first
+		if (data->hash == p_hash && data->name_equals(p_name)) {
+			break;
+		}
+		data = data->next;
+	}
+
+	if (data && data->refcount.ref()) {
+		// exists
+		if (p_static) {
+			data->static_count.increment();
+		}
+#ifdef DEBUG_ENABLED
+		if (unlikely(debug_stringname)) {
+			data->debug_references++;
+		}
+#endif
+		stripe.mutex.unlock();
+		return data;
+	}
+
+	if (stripe.count > stripe.mask) {
+		_grow_stripe(stripe);
+	}
+	uint32_t idx = p_hash & stripe.mask;
+
+	data = memnew(_Data);
+	if (p_cname) {
+		data->cname = p_cname;
+	} else {
+		data->name = p_name;
+	}
+	data->refcount.init();
+	data->static_count.set(p_static ? 1 : 0);
+	data->hash = p_hash;
+	data->next = stripe.table[idx];
+	data->prev = nullptr;
+#ifdef DEBUG_ENABLED
+	if (unlikely(debug_stringname)) {
+		// Keep in memory, force static.
+		data->refcount.ref();
+		data->static_count.increment();
+	}
+#endif
+
+	if (stripe.table[idx]) {
+		stripe.table[idx]->prev = data;
+	}
+	stripe.table[idx] = data;
+	stripe.count++;
+	name_count.increment();
+
+	stripe.mutex.unlock();
+	return data;
+}
+
+template <class T>
+StringName::_Data *StringName::_search_cache(const T &p_name, uint32_t p_hash, bool p_static) {
+	const _CacheEntry &entry = thread_cache[p_hash & THREAD_CACHE_MASK];
+	if (!entry.data || entry.hash != p_hash) {
+		return nullptr;
+	}
+
+	// Sequentially consistent, pairs with unref(), which bumps the generation before it checks
+	// for readers. Either the generation doesn't match, or the name isn't deleted before we're done.
+	_Stripe &stripe = _get_stripe(p_hash);
+	stripe.cache_readers.fetch_add(1);
+	_Data *data = entry.data;
+	if (stripe.generation.load() != entry.generation || !data->name_equals(p_name) || !data->refcount.ref()) {
+		data = nullptr;
+	}
+	stripe.cache_readers.fetch_sub(1);
+
+	if (data) {
+		if (p_static) {
+			data->static_count.increment();
+		}
+#ifdef DEBUG_ENABLED
+		if (unlikely(debug_stringname)) {
+			data->debug_references++;
+		}
+#endif
+	}
+	return data;
+}
+
+template <class T>
+StringName::_Data *StringName::_search(const T &p_name, uint32_t p_hash) {
+	_Data *data = _search_cache(p_name, p_hash, false);
+	if (data) {
+		return data;
+	}
+
+	_Stripe &stripe = _get_stripe(p_hash);
+	_lock_stripe(stripe);
+
+	data = stripe.table[p_hash & stripe.mask];
+
+	while (data) {
+		// compare hash first
+		if (data->hash == p_hash && data->name_equals(p_name)) {
+			break;
+		}
+		data = data->next;
+	}
+
+	if (data && !data->refcount.ref()) {
+		data = nullptr; // Being freed.
+	}
+
+	stripe.mutex.unlock();
+
+#ifdef DEBUG_ENABLED
+	if (data && unlikely(debug_stringname)) {
+		data->debug_references++;
+	}
+#endif
+	return data;
+}
+
+void StringName::_cache(_Data *p_data) {
+	// The caller holds a reference, so the name can't have been freed since the generation was last bumped.
+	_CacheEntry &entry = thread_cache[p_data->hash & THREAD_CACHE_MASK];
+	entry.data = p_data;
+	entry.hash = p_data->hash;
+	entry.generation = _get_stripe(p_data->hash).generation.load();
+}
+
+double StringName::get_table_load_factor() {
+	uint32_t buckets = bucket_count.get();
+	return buckets ? double(name_count.get()) / buckets : 0.0;
+}
+
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
-
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			if (_data->cname) {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->cname));
@@ -129,18 +340,36 @@ void StringName::unref() {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
 			}
 		}
+
+		// Stripe locks are not recursive, don't print errors while holding one.
+		bool bad_link = false;
+
+		_Stripe &stripe = _get_stripe(_data->hash);
+		_lock_stripe(stripe);
+
 		if (_data->prev) {
 			_data->prev->next = _data->next;
 		} else {
-			if (_table[_data->idx] != _data) {
-				ERR_PRINT("BUG!");
-			}
-			_table[_data->idx] = _data->next;
+			uint32_t idx = _data->hash & stripe.mask;
+			bad_link = stripe.table[idx] != _data;
+			stripe.table[idx] = _data->next;
 		}
 
 		if (_data->next) {
 			_data->next->prev = _data->prev;
 		}
+		stripe.count--;
+		name_count.decrement();
+
+		// Invalidate the thread caches, then wait for threads that may still be reading this name from theirs.
+		stripe.generation.fetch_add(1);
+		stripe.mutex.unlock();
+		while (stripe.cache_readers.load() != 0) {
+		}
+
+		if (bad_link) {
+			ERR_PRINT("BUG!");
+		}
 		memdelete(_data);
 	}
 
@@ -152,7 +381,7 @@ bool StringName::operator==(const String &p_name) const {
 		return (p_name.length() == 0);
 	}
 
-	return (_data->get_name() == p_name);
+	return _data->name_equals(p_name);
 }
 
 bool StringName::operator==(const char *p_name) const {
@@ -160,7 +389,7 @@ bool StringName::operator==(const char *p_name) const {
 		return (p_name[0] == 0);
 	}
 
-	return (_data->get_name() == p_name);
+	return _data->name_equals(p_name);
 }
 
 bool StringName::operator!=(const String &p_name) const {
@@ -216,56 +445,13 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
+	_data = _search_cache(p_name, hash, p_static);
+	if (!_data) {
+		_data = _intern(p_name, hash, p_static, nullptr);
+		_cache(_data);
 	}
-	_table[idx] = _data;
 }
 
 StringName::StringName(const StaticCString &p_static_string, bool p_static) {
@@ -275,55 +461,13 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_static_string.ptr);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
+	_data = _search_cache(p_static_string.ptr, hash, p_static);
+	if (!_data) {
+		_data = _intern(p_static_string.ptr, hash, p_static, p_static_string.ptr);
+		_cache(_data);
 	}
-	_table[idx] = _data;
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -335,54 +479,13 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
-	uint32_t idx = hash & STRING_TABLE_MASK;
 
-	_data = _table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
+	_data = _search_cache(p_name, hash, p_static);
+	if (!_data) {
+		_data = _intern(p_name, hash, p_static, nullptr);
+		_cache(_data);
 	}
-	_table[idx] = _data;
 }
 
 StringName StringName::search(const char *p_name) {
@@ -393,32 +496,7 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-
-		return StringName(_data);
-	}
-
-	return StringName(); //does not exist
+	return StringName(_search(p_name, String::hash(p_name)));
 }
 
 StringName StringName::search(const char32_t *p_name) {
@@ -429,58 +507,13 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		return StringName(_data);
-	}
-
-	return StringName(); //does not exist
+	return StringName(_search(p_name, String::hash(p_name)));
 }
 
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = p_name.hash();
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name()) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return StringName(_data);
-	}
-
-	return StringName(); //does not exist
+	return StringName(_search(p_name, p_name.hash()));
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
@@ -46,9 +46,11 @@ struct StaticCString {
 
 class StringName {
 	enum {
-		STRING_TABLE_BITS = 16,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_STRIPE_BITS = 6,
+		STRING_TABLE_STRIPES = 1 << STRING_TABLE_STRIPE_BITS,
+		STRING_TABLE_STRIPE_MIN_LEN = 1 << 10,
+		THREAD_CACHE_LEN = 256,
+		THREAD_CACHE_MASK = THREAD_CACHE_LEN - 1
 	};
 
 	struct _Data {
@@ -60,14 +62,53 @@ class StringName {
 		uint32_t debug_references = 0;
 #endif
 		String get_name() const { return cname ? String(cname) : name; }
-		int idx = 0;
+		_FORCE_INLINE_ bool name_equals(const char *p_name) const { return cname ? strcmp(cname, p_name) == 0 : name == p_name; }
+		_FORCE_INLINE_ bool name_equals(const char32_t *p_name) const { return cname ? String(cname) == p_name : name == p_name; }
+		_FORCE_INLINE_ bool name_equals(const String &p_name) const { return cname ? p_name == cname : name == p_name; }
 		uint32_t hash = 0;
 		_Data *prev = nullptr;
 		_Data *next = nullptr;
 		_Data() {}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	// The intern table is split in stripes, picked from the hash, so threads
+	// interning different names rarely wait on each other. Each stripe has its
+	// own lock and a bucket array that doubles when it gets full.
+	struct _Stripe {
+		BinaryMutex mutex;
+		_Data **table = nullptr;
+		uint32_t mask = 0;
+		uint32_t count = 0;
+		// Bumped whenever a name of this stripe is freed, which invalidates the thread caches.
+		std::atomic<uint64_t> generation = { 0 };
+		// Threads reading a name found in their cache. Freed names aren't deleted until this is zero.
+		std::atomic<uint32_t> cache_readers = { 0 };
+	};
+
+	// Recently interned names of each thread, checked before locking the table. Entries hold no
+	// reference, they are only used while the generation of their stripe hasn't changed.
+	struct _CacheEntry {
+		_Data *data = nullptr;
+		uint32_t hash = 0;
+		uint64_t generation = 0;
+	};
+
+	static _Stripe _stripes[STRING_TABLE_STRIPES];
+	static SafeNumeric<uint32_t> name_count;
+	static SafeNumeric<uint32_t> bucket_count;
+	static SafeNumeric<uint64_t> contended_usec;
+	static thread_local _CacheEntry thread_cache[THREAD_CACHE_LEN];
+
+	static _Stripe &_get_stripe(uint32_t p_hash);
+	static void _lock_stripe(_Stripe &p_stripe);
+	static void _grow_stripe(_Stripe &p_stripe);
+	template <class T>
+	static _Data *_intern(const T &p_name, uint32_t p_hash, bool p_static, const char *p_cname);
+	template <class T>
+	static _Data *_search_cache(const T &p_name, uint32_t p_hash, bool p_static);
+	template <class T>
+	static _Data *_search(const T &p_name, uint32_t p_hash);
+	static void _cache(_Data *p_data);
 
 	_Data *_data = nullptr;
 
@@ -194,6 +235,10 @@ public:
 		}
 	}
 
+	// Intern table statistics, exposed as performance monitors.
+	static double get_table_load_factor();
+	static uint64_t get_contended_usec() { return contended_usec.get(); }
+
 #ifdef DEBUG_ENABLED
 	static void set_debug_stringnames(bool p_enable) { debug_stringname = p_enable; }
 #endif
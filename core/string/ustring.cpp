@@ -35,6 +35,7 @@
 #include "core/math/math_funcs.h"
 #include "core/os/memory.h"
 #include "core/string/print_string.h"
+#include "core/string/string_builder.h"
 #include "core/string/string_name.h"
 #include "core/string/translation.h"
 #include "core/string/ucaps.h"
@@ -286,6 +287,27 @@ Error String::parse_url(String &r_scheme, String &r_host, int &r_port, String &r
 	return OK;
 }
 
+// Strings of a single ASCII character are very common (split() separators,
+// chr(), substr() of one character), so each of them shares one allocation
+// instead of allocating every time one is created.
+struct SharedASCIIStrings {
+	String strings[128];
+
+	SharedASCIIStrings() {
+		for (int i = 1; i < 128; i++) {
+			strings[i].resize(2);
+			char32_t *dst = strings[i].ptrw();
+			dst[0] = i;
+			dst[1] = 0;
+		}
+	}
+};
+
+static _FORCE_INLINE_ const String &_get_shared_ascii_string(char32_t p_char) {
+	static SharedASCIIStrings shared;
+	return shared.strings[p_char];
+}
+
 void String::copy_from(const char *p_cstr) {
 	// copy Latin-1 encoded c-string directly
 	if (!p_cstr) {
@@ -300,6 +322,11 @@ void String::copy_from(const char *p_cstr) {
 		return;
 	}
 
+	if (len == 1 && (uint8_t)p_cstr[0] < 128) {
+		*this = _get_shared_ascii_string(p_cstr[0]);
+		return;
+	}
+
 	resize(len + 1); // include 0
 
 	char32_t *dst = this->ptrw();
@@ -383,6 +410,11 @@ void String::copy_from(const char32_t &p_char) {
 		return;
 	}
 
+	if (p_char < 128) {
+		*this = _get_shared_ascii_string(p_char);
+		return;
+	}
+
 	resize(2);
 
 	char32_t *dst = ptrw();
@@ -445,6 +477,11 @@ void String::copy_from(const char32_t *p_cstr, const int p_clip_to) {
 // p_length > 0
 // p_length <= p_char strlen
 void String::copy_from_unchecked(const char32_t *p_char, const int p_length) {
+	if (p_length == 1 && p_char[0] > 0 && p_char[0] < 128) {
+		*this = _get_shared_ascii_string(p_char[0]);
+		return;
+	}
+
 	resize(p_length + 1);
 	char32_t *dst = ptrw();
 	dst[p_length] = 0;
@@ -3516,7 +3553,7 @@ bool String::matchn(const String &p_wildcard) const {
 }
 
 String String::format(const Variant &values, const String &placeholder) const {
-	String new_string = String(this->ptr());
+	String new_string = *this;
 
 	if (values.get_type() == Variant::ARRAY) {
 		Array values_arr = values;
@@ -3565,13 +3602,13 @@ String String::format(const Variant &values, const String &placeholder) const {
 }
 
 String String::replace(const String &p_key, const String &p_with) const {
-	String new_string;
+	StringBuilder new_string;
 	int search_from = 0;
 	int result = 0;
 
 	while ((result = find(p_key, search_from)) >= 0) {
-		new_string += substr(search_from, result - search_from);
-		new_string += p_with;
+		new_string.append(get_data() + search_from, result - search_from);
+		new_string.append(p_with);
 		search_from = result + p_key.length();
 	}
 
@@ -3579,9 +3616,9 @@ String String::replace(const String &p_key, const String &p_with) const {
 		return *this;
 	}
 
-	new_string += substr(search_from, length() - search_from);
+	new_string.append(get_data() + search_from, length() - search_from);
 
-	return new_string;
+	return new_string.as_string();
 }
 
 String String::replace(const char *p_key, const char *p_with) const {
@@ -33,9 +33,11 @@
 
 #include "core/os/memory.h"
 #include "core/os/spin_lock.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
@@ -69,52 +71,129 @@ public:
 
 template <class T, bool THREAD_SAFE = false>
 class RID_Alloc : public RID_AllocBase {
-	T **chunks = nullptr;
+	// Lookups never lock. Chunk tables are only replaced by larger copies (retired ones are kept
+	// until destruction), max_alloc is published once a new chunk is ready, and validators are
+	// read and changed atomically.
+	std::atomic<T **> chunks = { nullptr };
+	std::atomic<std::atomic<uint32_t> **> validator_chunks = { nullptr };
 	uint32_t **free_list_chunks = nullptr;
-	uint32_t **validator_chunks = nullptr;
+	uint32_t chunk_table_size = 0;
+	LocalVector<void *> retired_tables;
 
 	uint32_t elements_in_chunk;
-	uint32_t max_alloc = 0;
+	std::atomic<uint32_t> max_alloc = { 0 };
 	uint32_t alloc_count = 0;
 
 	const char *description = nullptr;
 
-	mutable SpinLock spin_lock;
+	mutable SpinLock spin_lock; // Guards the free list and growing.
+
+	// When thread safe, each thread takes free indices from its own lane, which is refilled from
+	// (and spills back to) the shared free list in batches.
+	enum {
+		LANE_COUNT = 8,
+		LANE_BATCH = 32,
+	};
+
+	struct Lane {
+		SpinLock lock;
+		uint32_t count = 0;
+		uint32_t indices[LANE_BATCH * 2];
+	};
+
+	Lane *lanes = nullptr;
+	uint32_t lane_batch = 1;
+	SafeNumeric<uint32_t> rid_count;
+
+	void _grow() {
+		uint32_t chunk_count = max_alloc.load(std::memory_order_relaxed) / elements_in_chunk;
+
+		if (chunk_count == chunk_table_size) {
+			uint32_t new_table_size = chunk_table_size == 0 ? 4 : chunk_table_size * 2;
+			T **old_chunks = chunks.load(std::memory_order_relaxed);
+			std::atomic<uint32_t> **old_validators = validator_chunks.load(std::memory_order_relaxed);
+
+			T **new_chunks = (T **)memalloc(sizeof(T *) * new_table_size);
+			std::atomic<uint32_t> **new_validators = (std::atomic<uint32_t> **)memalloc(sizeof(std::atomic<uint32_t> *) * new_table_size);
+			for (uint32_t i = 0; i < chunk_count; i++) {
+				new_chunks[i] = old_chunks[i];
+				new_validators[i] = old_validators[i];
+			}
+			free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * new_table_size);
 
-	_FORCE_INLINE_ RID _allocate_rid() {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
+			if (old_chunks) {
+				// Lookups may still be reading these.
+				retired_tables.push_back(old_chunks);
+				retired_tables.push_back(old_validators);
+			}
+
+			chunks.store(new_chunks, std::memory_order_release);
+			validator_chunks.store(new_validators, std::memory_order_release);
+			chunk_table_size = new_table_size;
 		}
 
-		if (alloc_count == max_alloc) {
-			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
-
-			//grow chunks
-			chunks = (T **)memrealloc(chunks, sizeof(T *) * (chunk_count + 1));
-			chunks[chunk_count] = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
-
-			//grow validators
-			validator_chunks = (uint32_t **)memrealloc(validator_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			validator_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
-			//grow free lists
-			free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
-
-			//initialize
-			for (uint32_t i = 0; i < elements_in_chunk; i++) {
-				// Don't initialize chunk.
-				validator_chunks[chunk_count][i] = 0xFFFFFFFF;
-				free_list_chunks[chunk_count][i] = alloc_count + i;
-			}
+		uint32_t first_index = chunk_count * elements_in_chunk;
+
+		chunks.load(std::memory_order_relaxed)[chunk_count] = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
 
-			max_alloc += elements_in_chunk;
+		std::atomic<uint32_t> *validators = (std::atomic<uint32_t> *)memalloc(sizeof(std::atomic<uint32_t>) * elements_in_chunk);
+		free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+		for (uint32_t i = 0; i < elements_in_chunk; i++) {
+			validators[i].store(0xFFFFFFFF, std::memory_order_relaxed);
+			free_list_chunks[chunk_count][i] = first_index + i;
 		}
+		validator_chunks.load(std::memory_order_relaxed)[chunk_count] = validators;
+
+		max_alloc.store(first_index + elements_in_chunk, std::memory_order_release);
+	}
+
+	// Call with spin_lock held.
+	_FORCE_INLINE_ uint32_t _pop_free_index() {
+		if (alloc_count == max_alloc.load(std::memory_order_relaxed)) {
+			_grow();
+		}
+		uint32_t index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+		alloc_count++;
+		return index;
+	}
 
-		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+	// Call with spin_lock held.
+	_FORCE_INLINE_ void _push_free_index(uint32_t p_index) {
+		alloc_count--;
+		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = p_index;
+	}
+
+	_FORCE_INLINE_ std::atomic<uint32_t> *_get_validator(uint32_t p_index) const {
+		if (unlikely(p_index >= max_alloc.load(std::memory_order_acquire))) {
+			return nullptr;
+		}
+		return &validator_chunks.load(std::memory_order_acquire)[p_index / elements_in_chunk][p_index % elements_in_chunk];
+	}
+
+	_FORCE_INLINE_ T *_get_element(uint32_t p_index) const {
+		return &chunks.load(std::memory_order_acquire)[p_index / elements_in_chunk][p_index % elements_in_chunk];
+	}
+
+	_FORCE_INLINE_ RID _allocate_rid() {
+		uint32_t free_index;
+
+		if (THREAD_SAFE) {
+			Lane &lane = lanes[Thread::get_caller_id() % LANE_COUNT];
+			lane.lock.lock();
+			if (lane.count == 0) {
+				spin_lock.lock();
+				while (lane.count < lane_batch) {
+					lane.indices[lane.count++] = _pop_free_index();
+				}
+				spin_lock.unlock();
+			}
+			free_index = lane.indices[--lane.count];
+			lane.lock.unlock();
 
-		uint32_t free_chunk = free_index / elements_in_chunk;
-		uint32_t free_element = free_index % elements_in_chunk;
+			rid_count.increment();
+		} else {
+			free_index = _pop_free_index();
+		}
 
 		uint32_t validator = (uint32_t)(_gen_id() & 0x7FFFFFFF);
 		CRASH_COND_MSG(validator == 0x7FFFFFFF, "Overflow in RID validator");
@@ -122,17 +201,39 @@ class RID_Alloc : public RID_AllocBase {
 		id <<= 32;
 		id |= free_index;
 
-		validator_chunks[free_chunk][free_element] = validator;
+		_get_validator(free_index)->store(validator | 0x80000000, std::memory_order_release); //mark uninitialized bit
 
-		validator_chunks[free_chunk][free_element] |= 0x80000000; //mark uninitialized bit
-
-		alloc_count++;
+		return _make_from_id(id);
+	}
 
+	_FORCE_INLINE_ void _release_index(uint32_t p_index) {
 		if (THREAD_SAFE) {
-			spin_lock.unlock();
+			Lane &lane = lanes[Thread::get_caller_id() % LANE_COUNT];
+			lane.lock.lock();
+			if (lane.count == LANE_BATCH * 2) {
+				spin_lock.lock();
+				for (uint32_t i = 0; i < LANE_BATCH; i++) {
+					_push_free_index(lane.indices[--lane.count]);
+				}
+				spin_lock.unlock();
+			}
+			lane.indices[lane.count++] = p_index;
+			lane.lock.unlock();
+
+			rid_count.decrement();
+		} else {
+			_push_free_index(p_index);
 		}
+	}
 
-		return _make_from_id(id);
+	// Swaps the validator only if it still holds the expected value, so two threads can't both
+	// initialize or free the same RID.
+	_FORCE_INLINE_ static bool _exchange_validator(std::atomic<uint32_t> &p_validator, uint32_t p_expected, uint32_t p_new) {
+		if (THREAD_SAFE) {
+			return p_validator.compare_exchange_strong(p_expected, p_new, std::memory_order_acq_rel);
+		}
+		p_validator.store(p_new, std::memory_order_relaxed);
+		return true;
 	}
 
 public:
@@ -156,58 +257,38 @@ public:
 		if (p_rid == RID()) {
 			return nullptr;
 		}
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		std::atomic<uint32_t> *slot = _get_validator(idx);
+		if (unlikely(!slot)) {
 			return nullptr;
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
-
 		uint32_t validator = uint32_t(id >> 32);
+		uint32_t current = slot->load(std::memory_order_acquire);
 
 		if (unlikely(p_initialize)) {
-			if (unlikely(!(validator_chunks[idx_chunk][idx_element] & 0x80000000))) {
-				if (THREAD_SAFE) {
-					spin_lock.unlock();
-				}
+			if (unlikely(!(current & 0x80000000))) {
 				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
 			}
 
-			if (unlikely((validator_chunks[idx_chunk][idx_element] & 0x7FFFFFFF) != validator)) {
-				if (THREAD_SAFE) {
-					spin_lock.unlock();
-				}
+			if (unlikely((current & 0x7FFFFFFF) != validator)) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
 			}
 
-			validator_chunks[idx_chunk][idx_element] &= 0x7FFFFFFF; //initialized
-
-		} else if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
+			if (unlikely(!_exchange_validator(*slot, current, validator))) { //initialized
+				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
 			}
-			if ((validator_chunks[idx_chunk][idx_element] & 0x80000000) && validator_chunks[idx_chunk][idx_element] != 0xFFFFFFFF) {
+
+		} else if (unlikely(current != validator)) {
+			if ((current & 0x80000000) && current != 0xFFFFFFFF) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
 			}
 			return nullptr;
 		}
 
-		T *ptr = &chunks[idx_chunk][idx_element];
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
-		return ptr;
+		return _get_element(idx);
 	}
 	void initialize_rid(RID p_rid) {
 		T *mem = get_or_null(p_rid, true);
@@ -221,108 +302,74 @@ public:
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		std::atomic<uint32_t> *slot = _get_validator(idx);
+		if (unlikely(!slot)) {
 			return false;
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
-
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (validator != 0x7FFFFFFF) && (validator_chunks[idx_chunk][idx_element] & 0x7FFFFFFF) == validator;
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
-		return owned;
+		return (validator != 0x7FFFFFFF) && (slot->load(std::memory_order_acquire) & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
-			ERR_FAIL();
-		}
-
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
+		std::atomic<uint32_t> *slot = _get_validator(idx);
+		ERR_FAIL_NULL(slot);
 
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(validator_chunks[idx_chunk][idx_element] & 0x80000000)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		uint32_t current = slot->load(std::memory_order_acquire);
+		if (unlikely(current & 0x80000000)) {
 			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
-		} else if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		} else if (unlikely(current != validator)) {
 			ERR_FAIL();
 		}
 
-		chunks[idx_chunk][idx_element].~T();
-		validator_chunks[idx_chunk][idx_element] = 0xFFFFFFFF; // go invalid
+		// Go invalid first, so lookups stop returning the element before it is destroyed.
+		if (unlikely(!_exchange_validator(*slot, validator, 0xFFFFFFFF))) {
+			ERR_FAIL_MSG("Attempted to free an RID that is being freed by another thread.");
+		}
 
-		alloc_count--;
-		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
+		_get_element(idx)->~T();
 
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
+		_release_index(idx);
 	}
 
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
+		if (THREAD_SAFE) {
+			return rid_count.get();
+		}
 		return alloc_count;
 	}
 	void get_owned_list(List<RID> *p_owned) const {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+		uint32_t count = max_alloc.load(std::memory_order_acquire);
+		std::atomic<uint32_t> **validators = validator_chunks.load(std::memory_order_acquire);
+		for (size_t i = 0; i < count; i++) {
+			uint64_t validator = validators[i / elements_in_chunk][i % elements_in_chunk].load(std::memory_order_relaxed);
 			if (validator != 0xFFFFFFFF) {
 				p_owned->push_back(_make_from_id((validator << 32) | i));
 			}
 		}
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
 	}
 
 	//used for fast iteration in the elements or RIDs
-	void fill_owned_buffer(RID *p_rid_buffer) const {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
+	// Other threads can make RIDs while the buffer is filled (allocation doesn't take a lock all
+	// the time), so it is bounded by p_max_count. Returns how many RIDs were written.
+	uint32_t fill_owned_buffer(RID *p_rid_buffer, uint32_t p_max_count) const {
+		uint32_t count = max_alloc.load(std::memory_order_acquire);
+		std::atomic<uint32_t> **validators = validator_chunks.load(std::memory_order_acquire);
 		uint32_t idx = 0;
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+		for (size_t i = 0; i < count && idx < p_max_count; i++) {
+			uint64_t validator = validators[i / elements_in_chunk][i % elements_in_chunk].load(std::memory_order_relaxed);
 			if (validator != 0xFFFFFFFF) {
 				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
 				idx++;
 			}
 		}
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
+		return idx;
 	}
 
 	void set_description(const char *p_descrption) {
@@ -331,35 +378,52 @@ public:
 
 	RID_Alloc(uint32_t p_target_chunk_byte_size = 65536) {
 		elements_in_chunk = sizeof(T) > p_target_chunk_byte_size ? 1 : (p_target_chunk_byte_size / sizeof(T));
+		if (THREAD_SAFE) {
+			lanes = memnew_arr(Lane, LANE_COUNT);
+			// Don't let a lane hold on to more than a fraction of a chunk.
+			lane_batch = CLAMP(elements_in_chunk / LANE_COUNT, 1u, uint32_t(LANE_BATCH));
+		}
 	}
 
 	~RID_Alloc() {
-		if (alloc_count) {
+		uint32_t count = max_alloc.load(std::memory_order_acquire);
+		T **chunk_table = chunks.load(std::memory_order_acquire);
+		std::atomic<uint32_t> **validators = validator_chunks.load(std::memory_order_acquire);
+
+		if (get_rid_count()) {
 			print_error(vformat("ERROR: %d RID allocations of type '%s' were leaked at exit.",
-					alloc_count, description ? description : typeid(T).name()));
+					get_rid_count(), description ? description : typeid(T).name()));
 
-			for (size_t i = 0; i < max_alloc; i++) {
-				uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+			for (size_t i = 0; i < count; i++) {
+				uint64_t validator = validators[i / elements_in_chunk][i % elements_in_chunk].load(std::memory_order_relaxed);
 				if (validator & 0x80000000) {
 					continue; //uninitialized
 				}
 				if (validator != 0xFFFFFFFF) {
-					chunks[i / elements_in_chunk][i % elements_in_chunk].~T();
+					chunk_table[i / elements_in_chunk][i % elements_in_chunk].~T();
 				}
 			}
 		}
 
-		uint32_t chunk_count = max_alloc / elements_in_chunk;
+		uint32_t chunk_count = count / elements_in_chunk;
 		for (uint32_t i = 0; i < chunk_count; i++) {
-			memfree(chunks[i]);
-			memfree(validator_chunks[i]);
+			memfree(chunk_table[i]);
+			memfree(validators[i]);
 			memfree(free_list_chunks[i]);
 		}
 
-		if (chunks) {
-			memfree(chunks);
+		if (chunk_table) {
+			memfree(chunk_table);
 			memfree(free_list_chunks);
-			memfree(validator_chunks);
+			memfree(validators);
+		}
+
+		for (void *table : retired_tables) {
+			memfree(table);
+		}
+
+		if (lanes) {
+			memdelete_arr(lanes);
 		}
 	}
 };
@@ -411,8 +475,8 @@ public:
 		return alloc.get_owned_list(p_owned);
 	}
 
-	void fill_owned_buffer(RID *p_rid_buffer) const {
-		alloc.fill_owned_buffer(p_rid_buffer);
+	uint32_t fill_owned_buffer(RID *p_rid_buffer, uint32_t p_max_count) const {
+		return alloc.fill_owned_buffer(p_rid_buffer, p_max_count);
 	}
 
 	void set_description(const char *p_descrption) {
@@ -466,8 +530,8 @@ public:
 	_FORCE_INLINE_ void get_owned_list(List<RID> *p_owned) const {
 		return alloc.get_owned_list(p_owned);
 	}
-	void fill_owned_buffer(RID *p_rid_buffer) const {
-		alloc.fill_owned_buffer(p_rid_buffer);
+	uint32_t fill_owned_buffer(RID *p_rid_buffer, uint32_t p_max_count) const {
+		return alloc.fill_owned_buffer(p_rid_buffer, p_max_count);
 	}
 
 	void set_description(const char *p_descrption) {
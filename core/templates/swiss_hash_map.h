@@ -0,0 +1,520 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SWISS_HASH_MAP_H
+#define SWISS_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/swiss_table.h"
+
+/**
+ * A HashMap implementation that uses SwissTable-style open addressing.
+ * Each slot has a control byte holding 7 bits of the key hash, and lookups
+ * compare the control bytes of 16 slots at once with SIMD instructions, so
+ * keys are only compared when those bits match. Erased slots become
+ * tombstones unless their group still has an empty slot.
+ *
+ * It has the same API as HashMap, so it can be used as a drop-in replacement
+ * where lookups are hot. As with HashMap, keys and values are stored in a
+ * double linked list by insertion order, so iteration order and iterator
+ * stability are the same.
+ *
+ * The assignment operator copy the pairs from one map to the other.
+ */
+
+template <class TKey, class TValue,
+		class Hasher = HashMapHasherDefault,
+		class Comparator = HashMapComparatorDefault<TKey>,
+		class Allocator = DefaultTypedAllocator<HashMapElement<TKey, TValue>>>
+class SwissHashMap {
+	Allocator element_alloc;
+	int8_t *ctrl = nullptr;
+	HashMapElement<TKey, TValue> **elements = nullptr;
+	HashMapElement<TKey, TValue> *head_element = nullptr;
+	HashMapElement<TKey, TValue> *tail_element = nullptr;
+
+	uint32_t capacity = SwissTable::GROUP_SIZE;
+	uint32_t num_elements = 0;
+	uint32_t growth_left = 0; // Empty slots that can still be used before rehashing.
+
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (elements == nullptr || num_elements == 0) {
+			return false; // Failed lookups, no elements
+		}
+
+		uint32_t hash = Hasher::hash(p_key);
+		int8_t h2 = SwissTable::get_h2(hash);
+		SwissTable::ProbeSequence seq(hash, capacity);
+
+		while (true) {
+			SwissTable::Group group(ctrl + seq.offset());
+			for (SwissTable::Group::Mask mask = group.match(h2); mask; mask.clear_lowest()) {
+				uint32_t pos = seq.offset() + mask.lowest();
+				if (Comparator::compare(elements[pos]->data.key, p_key)) {
+					r_pos = pos;
+					return true;
+				}
+			}
+			if (group.match_empty()) {
+				return false;
+			}
+			seq.next();
+		}
+	}
+
+	void _insert_with_hash(uint32_t p_hash, HashMapElement<TKey, TValue> *p_value) {
+		uint32_t pos = SwissTable::find_insert_slot(ctrl, capacity, p_hash);
+		if (ctrl[pos] == SwissTable::CTRL_EMPTY) {
+			growth_left--;
+		}
+		ctrl[pos] = SwissTable::get_h2(p_hash);
+		elements[pos] = p_value;
+		num_elements++;
+	}
+
+	void _clear_slot(uint32_t p_pos) {
+		if (SwissTable::can_erase_to_empty(ctrl, p_pos)) {
+			ctrl[p_pos] = SwissTable::CTRL_EMPTY;
+			growth_left++;
+		} else {
+			ctrl[p_pos] = SwissTable::CTRL_DELETED;
+		}
+		elements[p_pos] = nullptr;
+		num_elements--;
+	}
+
+	void _allocate(uint32_t p_capacity) {
+		capacity = p_capacity;
+		ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(sizeof(int8_t) * capacity));
+		elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(Memory::alloc_static(sizeof(HashMapElement<TKey, TValue> *) * capacity));
+
+		for (uint32_t i = 0; i < capacity; i++) {
+			ctrl[i] = SwissTable::CTRL_EMPTY;
+			elements[i] = nullptr;
+		}
+		growth_left = SwissTable::get_max_elements(capacity);
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		int8_t *old_ctrl = ctrl;
+		HashMapElement<TKey, TValue> **old_elements = elements;
+
+		_allocate(p_new_capacity);
+		num_elements = 0;
+
+		// The insertion order list already holds every element, so the old table is not needed.
+		for (HashMapElement<TKey, TValue> *E = head_element; E; E = E->next) {
+			_insert_with_hash(Hasher::hash(E->data.key), E);
+		}
+
+		if (old_ctrl != nullptr) {
+			Memory::free_static(old_ctrl);
+			Memory::free_static(old_elements);
+		}
+	}
+
+	_FORCE_INLINE_ HashMapElement<TKey, TValue> *_insert(const TKey &p_key, const TValue &p_value, bool p_front_insert = false) {
+		if (unlikely(elements == nullptr)) {
+			// Allocate on demand to save memory.
+			_allocate(capacity);
+		}
+
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			elements[pos]->data.value = p_value;
+			return elements[pos];
+		} else {
+			if (growth_left == 0) {
+				// Grow if actually full, otherwise only get rid of tombstones.
+				uint32_t new_capacity = num_elements + 1 > SwissTable::get_max_elements(capacity) / 2 ? capacity * 2 : capacity;
+				ERR_FAIL_COND_V_MSG(new_capacity < capacity, nullptr, "Hash table maximum capacity reached, aborting insertion.");
+				_resize_and_rehash(new_capacity);
+			}
+
+			HashMapElement<TKey, TValue> *elem = element_alloc.new_allocation(HashMapElement<TKey, TValue>(p_key, p_value));
+
+			if (tail_element == nullptr) {
+				head_element = elem;
+				tail_element = elem;
+			} else if (p_front_insert) {
+				head_element->prev = elem;
+				elem->next = head_element;
+				head_element = elem;
+			} else {
+				tail_element->next = elem;
+				elem->prev = tail_element;
+				tail_element = elem;
+			}
+
+			_insert_with_hash(Hasher::hash(p_key), elem);
+			return elem;
+		}
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		// Tombstones left by erase() also use up growth, so only an untouched table can be skipped.
+		if (elements == nullptr || growth_left == SwissTable::get_max_elements(capacity)) {
+			return;
+		}
+		for (uint32_t i = 0; i < capacity; i++) {
+			if (ctrl[i] >= 0) {
+				element_alloc.delete_allocation(elements[i]);
+			}
+			ctrl[i] = SwissTable::CTRL_EMPTY;
+			elements[i] = nullptr;
+		}
+
+		tail_element = nullptr;
+		head_element = nullptr;
+		num_elements = 0;
+		growth_left = SwissTable::get_max_elements(capacity);
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return elements[pos]->data.value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return elements[pos]->data.value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &elements[pos]->data.value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &elements[pos]->data.value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (!exists) {
+			return false;
+		}
+
+		HashMapElement<TKey, TValue> *element = elements[pos];
+		_clear_slot(pos);
+
+		if (head_element == element) {
+			head_element = element->next;
+		}
+
+		if (tail_element == element) {
+			tail_element = element->prev;
+		}
+
+		if (element->prev) {
+			element->prev->next = element->next;
+		}
+
+		if (element->next) {
+			element->next->prev = element->prev;
+		}
+
+		element_alloc.delete_allocation(element);
+
+		return true;
+	}
+
+	// Replace the key of an entry in-place, without invalidating iterators or changing the entries position during iteration.
+	// p_old_key must exist in the map and p_new_key must not, unless it is equal to p_old_key.
+	bool replace_key(const TKey &p_old_key, const TKey &p_new_key) {
+		if (p_old_key == p_new_key) {
+			return true;
+		}
+		uint32_t pos = 0;
+		ERR_FAIL_COND_V(_lookup_pos(p_new_key, pos), false);
+		ERR_FAIL_COND_V(!_lookup_pos(p_old_key, pos), false);
+		HashMapElement<TKey, TValue> *element = elements[pos];
+
+		// Free the old slot, _insert_with_hash will count the element again.
+		_clear_slot(pos);
+
+		// Update the HashMapElement with the new key and reinsert it.
+		const_cast<TKey &>(element->data.key) = p_new_key;
+		if (growth_left == 0) {
+			_resize_and_rehash(capacity); // Reinserts every element, including this one.
+		} else {
+			_insert_with_hash(Hasher::hash(p_new_key), element);
+		}
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_capacity = SwissTable::get_capacity_for(p_new_capacity);
+
+		if (new_capacity <= capacity) {
+			return;
+		}
+
+		if (elements == nullptr) {
+			capacity = new_capacity;
+			return; // Unallocated yet.
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return E->data;
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return &E->data; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			if (E) {
+				E = E->next;
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			if (E) {
+				E = E->prev;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return E == b.E; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return E != b.E; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return E != nullptr;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const HashMapElement<TKey, TValue> *p_E) { E = p_E; }
+		_FORCE_INLINE_ ConstIterator() {}
+		_FORCE_INLINE_ ConstIterator(const ConstIterator &p_it) { E = p_it.E; }
+		_FORCE_INLINE_ void operator=(const ConstIterator &p_it) {
+			E = p_it.E;
+		}
+
+	private:
+		const HashMapElement<TKey, TValue> *E = nullptr;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return E->data;
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return &E->data; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			if (E) {
+				E = E->next;
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			if (E) {
+				E = E->prev;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return E == b.E; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return E != b.E; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return E != nullptr;
+		}
+
+		_FORCE_INLINE_ Iterator(HashMapElement<TKey, TValue> *p_E) { E = p_E; }
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) { E = p_it.E; }
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			E = p_it.E;
+		}
+
+		operator ConstIterator() const {
+			return ConstIterator(E);
+		}
+
+	private:
+		HashMapElement<TKey, TValue> *E = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(head_element);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(nullptr);
+	}
+	_FORCE_INLINE_ Iterator last() {
+		return Iterator(tail_element);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(elements[pos]);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(head_element);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(nullptr);
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		return ConstIterator(tail_element);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return ConstIterator(elements[pos]);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND(!exists);
+		return elements[pos]->data.value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return _insert(p_key, TValue())->data.value;
+		} else {
+			return elements[pos]->data.value;
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value, bool p_front_insert = false) {
+		return Iterator(_insert(p_key, p_value, p_front_insert));
+	}
+
+	/* Constructors */
+
+	SwissHashMap(const SwissHashMap &p_other) {
+		reserve(p_other.num_elements);
+
+		if (p_other.num_elements == 0) {
+			return;
+		}
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		if (num_elements != 0) {
+			clear();
+		}
+
+		reserve(p_other.num_elements);
+
+		if (p_other.elements == nullptr) {
+			return; // Nothing to copy.
+		}
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	SwissHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	SwissHashMap() {}
+
+	~SwissHashMap() {
+		clear();
+
+		if (elements != nullptr) {
+			Memory::free_static(elements);
+			Memory::free_static(ctrl);
+		}
+	}
+};
+
+#endif // SWISS_HASH_MAP_H
@@ -0,0 +1,385 @@
+/**************************************************************************/
+/*  swiss_hash_set.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SWISS_HASH_SET_H
+#define SWISS_HASH_SET_H
+
+#include "core/os/memory.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/swiss_table.h"
+
+/**
+ * Implementation of Set using a SwissTable-style index over a dense key array.
+ * Lookups compare the control bytes of 16 slots at once with SIMD instructions,
+ * so keys are only compared when 7 bits of their hash match.
+ *
+ * It has the same API as HashSet, so it can be used as a drop-in replacement
+ * where lookups are hot. As with HashSet, keys are kept lineal in memory, and
+ * erasing moves the last key into the gap.
+ */
+
+template <class TKey,
+		class Hasher = HashMapHasherDefault,
+		class Comparator = HashMapComparatorDefault<TKey>>
+class SwissHashSet {
+	TKey *keys = nullptr;
+	int8_t *ctrl = nullptr;
+	uint32_t *slot_to_key = nullptr;
+	uint32_t *key_to_slot = nullptr;
+
+	uint32_t capacity = SwissTable::GROUP_SIZE;
+	uint32_t num_elements = 0;
+	uint32_t growth_left = 0; // Empty slots that can still be used before rehashing.
+
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (keys == nullptr || num_elements == 0) {
+			return false; // Failed lookups, no elements
+		}
+
+		uint32_t hash = Hasher::hash(p_key);
+		int8_t h2 = SwissTable::get_h2(hash);
+		SwissTable::ProbeSequence seq(hash, capacity);
+
+		while (true) {
+			SwissTable::Group group(ctrl + seq.offset());
+			for (SwissTable::Group::Mask mask = group.match(h2); mask; mask.clear_lowest()) {
+				uint32_t key_pos = slot_to_key[seq.offset() + mask.lowest()];
+				if (Comparator::compare(keys[key_pos], p_key)) {
+					r_pos = key_pos;
+					return true;
+				}
+			}
+			if (group.match_empty()) {
+				return false;
+			}
+			seq.next();
+		}
+	}
+
+	void _insert_with_hash(uint32_t p_hash, uint32_t p_index) {
+		uint32_t pos = SwissTable::find_insert_slot(ctrl, capacity, p_hash);
+		if (ctrl[pos] == SwissTable::CTRL_EMPTY) {
+			growth_left--;
+		}
+		ctrl[pos] = SwissTable::get_h2(p_hash);
+		slot_to_key[pos] = p_index;
+		key_to_slot[p_index] = pos;
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		capacity = p_new_capacity;
+
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(key_to_slot);
+		}
+		ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(sizeof(int8_t) * capacity));
+		keys = reinterpret_cast<TKey *>(Memory::realloc_static(keys, sizeof(TKey) * capacity));
+		key_to_slot = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		slot_to_key = reinterpret_cast<uint32_t *>(Memory::realloc_static(slot_to_key, sizeof(uint32_t) * capacity));
+
+		for (uint32_t i = 0; i < capacity; i++) {
+			ctrl[i] = SwissTable::CTRL_EMPTY;
+		}
+		growth_left = SwissTable::get_max_elements(capacity);
+
+		for (uint32_t i = 0; i < num_elements; i++) {
+			_insert_with_hash(Hasher::hash(keys[i]), i);
+		}
+	}
+
+	_FORCE_INLINE_ int32_t _insert(const TKey &p_key) {
+		if (unlikely(keys == nullptr)) {
+			// Allocate on demand to save memory.
+			_resize_and_rehash(capacity);
+		}
+
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return pos;
+		} else {
+			if (growth_left == 0) {
+				// Grow if actually full, otherwise only get rid of tombstones.
+				uint32_t new_capacity = num_elements + 1 > SwissTable::get_max_elements(capacity) / 2 ? capacity * 2 : capacity;
+				ERR_FAIL_COND_V_MSG(new_capacity < capacity, -1, "Hash table maximum capacity reached, aborting insertion.");
+				_resize_and_rehash(new_capacity);
+			}
+
+			memnew_placement(&keys[num_elements], TKey(p_key));
+			_insert_with_hash(Hasher::hash(p_key), num_elements);
+			num_elements++;
+			return num_elements - 1;
+		}
+	}
+
+	void _init_from(const SwissHashSet &p_other) {
+		capacity = p_other.capacity;
+		num_elements = p_other.num_elements;
+		growth_left = p_other.growth_left;
+
+		if (p_other.keys == nullptr) {
+			return;
+		}
+
+		ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(sizeof(int8_t) * capacity));
+		keys = reinterpret_cast<TKey *>(Memory::alloc_static(sizeof(TKey) * capacity));
+		key_to_slot = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		slot_to_key = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+
+		for (uint32_t i = 0; i < num_elements; i++) {
+			memnew_placement(&keys[i], TKey(p_other.keys[i]));
+			key_to_slot[i] = p_other.key_to_slot[i];
+		}
+
+		for (uint32_t i = 0; i < capacity; i++) {
+			ctrl[i] = p_other.ctrl[i];
+			slot_to_key[i] = p_other.slot_to_key[i];
+		}
+	}
+
+	void _free() {
+		if (keys != nullptr) {
+			Memory::free_static(keys);
+			Memory::free_static(ctrl);
+			Memory::free_static(key_to_slot);
+			Memory::free_static(slot_to_key);
+			keys = nullptr;
+			ctrl = nullptr;
+			key_to_slot = nullptr;
+			slot_to_key = nullptr;
+		}
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		// Tombstones left by erase() also use up growth, so only an untouched table can be skipped.
+		if (keys == nullptr || growth_left == SwissTable::get_max_elements(capacity)) {
+			return;
+		}
+		for (uint32_t i = 0; i < capacity; i++) {
+			ctrl[i] = SwissTable::CTRL_EMPTY;
+		}
+		for (uint32_t i = 0; i < num_elements; i++) {
+			keys[i].~TKey();
+		}
+
+		num_elements = 0;
+		growth_left = SwissTable::get_max_elements(capacity);
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t key_pos = 0;
+		bool exists = _lookup_pos(p_key, key_pos);
+
+		if (!exists) {
+			return false;
+		}
+
+		uint32_t pos = key_to_slot[key_pos];
+		if (SwissTable::can_erase_to_empty(ctrl, pos)) {
+			ctrl[pos] = SwissTable::CTRL_EMPTY;
+			growth_left++;
+		} else {
+			ctrl[pos] = SwissTable::CTRL_DELETED;
+		}
+
+		keys[key_pos].~TKey();
+		num_elements--;
+		if (key_pos < num_elements) {
+			// Not the last key, move the last one here to keep keys lineal
+			memnew_placement(&keys[key_pos], TKey(keys[num_elements]));
+			keys[num_elements].~TKey();
+			key_to_slot[key_pos] = key_to_slot[num_elements];
+			slot_to_key[key_to_slot[num_elements]] = key_pos;
+		}
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_capacity = SwissTable::get_capacity_for(p_new_capacity);
+
+		if (new_capacity <= capacity) {
+			return;
+		}
+
+		if (keys == nullptr) {
+			capacity = new_capacity;
+			return; // Unallocated yet.
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	struct Iterator {
+		_FORCE_INLINE_ const TKey &operator*() const {
+			return keys[index];
+		}
+		_FORCE_INLINE_ const TKey *operator->() const {
+			return &keys[index];
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			index++;
+			if (index >= (int32_t)num_keys) {
+				index = -1;
+				keys = nullptr;
+				num_keys = 0;
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			index--;
+			if (index < 0) {
+				index = -1;
+				keys = nullptr;
+				num_keys = 0;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return keys == b.keys && index == b.index; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return keys != b.keys || index != b.index; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return keys != nullptr;
+		}
+
+		_FORCE_INLINE_ Iterator(const TKey *p_keys, uint32_t p_num_keys, int32_t p_index = -1) {
+			keys = p_keys;
+			num_keys = p_num_keys;
+			index = p_index;
+		}
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) {
+			keys = p_it.keys;
+			num_keys = p_it.num_keys;
+			index = p_it.index;
+		}
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			keys = p_it.keys;
+			num_keys = p_it.num_keys;
+			index = p_it.index;
+		}
+
+	private:
+		const TKey *keys = nullptr;
+		uint32_t num_keys = 0;
+		int32_t index = -1;
+	};
+
+	_FORCE_INLINE_ Iterator begin() const {
+		return num_elements ? Iterator(keys, num_elements, 0) : Iterator();
+	}
+	_FORCE_INLINE_ Iterator end() const {
+		return Iterator();
+	}
+	_FORCE_INLINE_ Iterator last() const {
+		if (num_elements == 0) {
+			return Iterator();
+		}
+		return Iterator(keys, num_elements, num_elements - 1);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(keys, num_elements, pos);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(*p_iter);
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key) {
+		uint32_t pos = _insert(p_key);
+		return Iterator(keys, num_elements, pos);
+	}
+
+	/* Constructors */
+
+	SwissHashSet(const SwissHashSet &p_other) {
+		_init_from(p_other);
+	}
+
+	void operator=(const SwissHashSet &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		clear();
+		_free();
+		_init_from(p_other);
+	}
+
+	SwissHashSet(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	SwissHashSet() {}
+
+	void reset() {
+		clear();
+		_free();
+		capacity = SwissTable::GROUP_SIZE;
+	}
+
+	~SwissHashSet() {
+		clear();
+		_free();
+	}
+};
+
+#endif // SWISS_HASH_SET_H
@@ -0,0 +1,242 @@
+/**************************************************************************/
+/*  swiss_table.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SWISS_TABLE_H
+#define SWISS_TABLE_H
+
+#include "core/typedefs.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_TABLE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define SWISS_TABLE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * Shared building blocks for the SwissTable-style containers (SwissHashMap, SwissHashSet).
+ *
+ * Every slot of the table has a control byte: either EMPTY, DELETED, or the
+ * lower 7 bits of the hash of the key stored in it (H2). The table is probed
+ * in groups of 16 slots, and the control bytes of a whole group are compared
+ * at once with SSE2 or NEON (or a portable fallback), so only slots whose H2
+ * matches need their key compared.
+ */
+
+namespace SwissTable {
+
+static constexpr uint32_t GROUP_SIZE = 16;
+static constexpr int8_t CTRL_EMPTY = -128; // 0b10000000
+static constexpr int8_t CTRL_DELETED = -2; // 0b11111110
+
+_FORCE_INLINE_ uint32_t count_trailing_zeros(uint64_t p_value) {
+#if defined(__GNUC__)
+	return __builtin_ctzll(p_value);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	unsigned long index;
+	_BitScanForward64(&index, p_value);
+	return index;
+#elif defined(_MSC_VER)
+	unsigned long index;
+	if (_BitScanForward(&index, (uint32_t)p_value)) {
+		return index;
+	}
+	_BitScanForward(&index, (uint32_t)(p_value >> 32));
+	return index + 32;
+#else
+	uint32_t count = 0;
+	while (!(p_value & 1)) {
+		p_value >>= 1;
+		count++;
+	}
+	return count;
+#endif
+}
+
+// Set of matching slots within a group. Each slot takes (1 << Shift) bits, of which only one is set.
+template <uint32_t Shift>
+struct BitMask {
+	uint64_t mask = 0;
+
+	_FORCE_INLINE_ explicit operator bool() const { return mask != 0; }
+	_FORCE_INLINE_ uint32_t lowest() const { return count_trailing_zeros(mask) >> Shift; }
+	_FORCE_INLINE_ void clear_lowest() { mask &= mask - 1; }
+
+	_FORCE_INLINE_ explicit BitMask(uint64_t p_mask) :
+			mask(p_mask) {}
+};
+
+#if defined(SWISS_TABLE_SSE2)
+
+struct Group {
+	typedef BitMask<0> Mask;
+	__m128i ctrl;
+
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+		return Mask((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(p_h2), ctrl)));
+	}
+	_FORCE_INLINE_ Mask match_empty() const {
+		return match(CTRL_EMPTY);
+	}
+	// Both EMPTY and DELETED have the sign bit set, while full slots don't.
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		return Mask((uint32_t)_mm_movemask_epi8(ctrl));
+	}
+
+	_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+	}
+};
+
+#elif defined(SWISS_TABLE_NEON)
+
+struct Group {
+	typedef BitMask<2> Mask;
+	int8x16_t ctrl;
+
+	// Narrows a byte mask to 4 bits per slot, keeping a single one of them.
+	static _FORCE_INLINE_ uint64_t _to_mask(uint8x16_t p_bytes) {
+		uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(p_bytes), 4);
+		return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ULL;
+	}
+
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+		return Mask(_to_mask(vceqq_s8(vdupq_n_s8(p_h2), ctrl)));
+	}
+	_FORCE_INLINE_ Mask match_empty() const {
+		return match(CTRL_EMPTY);
+	}
+	// Both EMPTY and DELETED have the sign bit set, while full slots don't.
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		return Mask(_to_mask(vcltq_s8(ctrl, vdupq_n_s8(0))));
+	}
+
+	_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) {
+		ctrl = vld1q_s8(p_ctrl);
+	}
+};
+
+#else
+
+struct Group {
+	typedef BitMask<0> Mask;
+	const int8_t *ctrl;
+
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+		uint64_t mask = 0;
+		for (uint32_t i = 0; i < GROUP_SIZE; i++) {
+			mask |= uint64_t(ctrl[i] == p_h2) << i;
+		}
+		return Mask(mask);
+	}
+	_FORCE_INLINE_ Mask match_empty() const {
+		return match(CTRL_EMPTY);
+	}
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		uint64_t mask = 0;
+		for (uint32_t i = 0; i < GROUP_SIZE; i++) {
+			mask |= uint64_t(ctrl[i] < 0) << i;
+		}
+		return Mask(mask);
+	}
+
+	_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) {
+		ctrl = p_ctrl;
+	}
+};
+
+#endif
+
+_FORCE_INLINE_ int8_t get_h2(uint32_t p_hash) {
+	return int8_t(p_hash & 0x7F);
+}
+
+_FORCE_INLINE_ uint32_t get_h1(uint32_t p_hash) {
+	return p_hash >> 7;
+}
+
+// Maximum amount of elements before growing, for a 7/8 maximum load factor.
+_FORCE_INLINE_ uint32_t get_max_elements(uint32_t p_capacity) {
+	return p_capacity - p_capacity / 8;
+}
+
+// Smallest power-of-two capacity (in slots, at least one group) that fits the given amount of elements.
+_FORCE_INLINE_ uint32_t get_capacity_for(uint32_t p_elements) {
+	uint32_t capacity = GROUP_SIZE;
+	while (get_max_elements(capacity) < p_elements) {
+		capacity <<= 1;
+	}
+	return capacity;
+}
+
+// Triangular probing over groups, which visits every group when the group count is a power of two.
+struct ProbeSequence {
+	uint32_t group_mask;
+	uint32_t group;
+	uint32_t step = 0;
+
+	_FORCE_INLINE_ uint32_t offset() const { return group * GROUP_SIZE; }
+	_FORCE_INLINE_ void next() {
+		step++;
+		group = (group + step) & group_mask;
+	}
+
+	_FORCE_INLINE_ ProbeSequence(uint32_t p_hash, uint32_t p_capacity) {
+		group_mask = p_capacity / GROUP_SIZE - 1;
+		group = get_h1(p_hash) & group_mask;
+	}
+};
+
+// Returns the first slot where a key with the given hash can be inserted.
+_FORCE_INLINE_ uint32_t find_insert_slot(const int8_t *p_ctrl, uint32_t p_capacity, uint32_t p_hash) {
+	ProbeSequence seq(p_hash, p_capacity);
+	while (true) {
+		Group::Mask mask = Group(p_ctrl + seq.offset()).match_empty_or_deleted();
+		if (mask) {
+			return seq.offset() + mask.lowest();
+		}
+		seq.next();
+	}
+}
+
+// A slot can only go back to EMPTY if its group still has an empty slot, because then no probe
+// sequence ever went past this group. Otherwise it must become a DELETED tombstone.
+_FORCE_INLINE_ bool can_erase_to_empty(const int8_t *p_ctrl, uint32_t p_slot) {
+	return bool(Group(p_ctrl + (p_slot & ~(GROUP_SIZE - 1))).match_empty());
+}
+
+} // namespace SwissTable
+
+#endif // SWISS_TABLE_H
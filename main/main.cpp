@@ -473,6 +473,10 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  -d, --debug                       Debug (local stdout debugger).\n");
 	OS::get_singleton()->print("  -b, --breakpoints                 Breakpoint list as source::line comma-separated pairs, no spaces (use %%20 instead).\n");
 	OS::get_singleton()->print("  --profiling                       Enable profiling in the script debugger.\n");
+#if defined(DEBUG_ENABLED) && defined(MODULE_GDSCRIPT_ENABLED)
+	OS::get_singleton()->print("  --gdscript-sampling-profile <file> Sample GDScript call stacks, and write them to <file> on exit, in the folded format of flame graph tools.\n");
+	OS::get_singleton()->print("  --gdscript-sampling-interval <usec> Interval between samples for --gdscript-sampling-profile (default: 1000).\n");
+#endif
 	OS::get_singleton()->print("  --gpu-profile                     Show a GPU profile of the tasks that took the most time during frame rendering.\n");
 	OS::get_singleton()->print("  --gpu-validation                  Enable graphics API validation layers for debugging.\n");
 #if DEBUG_ENABLED
@@ -2846,6 +2850,14 @@ Error Main::setup2() {
 
 	OS::get_singleton()->benchmark_end_measure("Startup", "Platforms");
 
+	// Most classes are registered by now, so build their tables upfront. Tables of classes registered
+	// or changed later are built on their first lookup.
+	OS::get_singleton()->benchmark_begin_measure("Startup", "ClassDB Lookup Tables");
+
+	ClassDB::build_lookup_tables();
+
+	OS::get_singleton()->benchmark_end_measure("Startup", "ClassDB Lookup Tables");
+
 	GLOBAL_DEF_BASIC(PropertyInfo(Variant::STRING, "display/mouse_cursor/custom_image", PROPERTY_HINT_FILE, "*.png,*.webp"), String());
 	GLOBAL_DEF_BASIC("display/mouse_cursor/custom_image_hotspot", Vector2());
 	GLOBAL_DEF_BASIC("display/mouse_cursor/tooltip_position_offset", Point2(10, 10));
@@ -3739,6 +3751,8 @@ bool Main::iteration() {
 
 		Engine::get_singleton()->_in_physics = true;
 
+		MemoryTagScope physics_tag(Memory::TAG_PHYSICS);
+
 		uint64_t physics_begin = OS::get_singleton()->get_ticks_usec();
 
 		PhysicsServer3D::get_singleton()->sync();
@@ -3747,7 +3761,12 @@ bool Main::iteration() {
 		PhysicsServer2D::get_singleton()->sync();
 		PhysicsServer2D::get_singleton()->flush_queries();
 
-		if (OS::get_singleton()->get_main_loop()->physics_process(physics_step * time_scale)) {
+		bool physics_exit;
+		{
+			MemoryTagScope scene_tag(Memory::TAG_SCENE);
+			physics_exit = OS::get_singleton()->get_main_loop()->physics_process(physics_step * time_scale);
+		}
+		if (physics_exit) {
 			PhysicsServer3D::get_singleton()->end_sync();
 			PhysicsServer2D::get_singleton()->end_sync();
 
@@ -3757,7 +3776,10 @@ bool Main::iteration() {
 
 		uint64_t navigation_begin = OS::get_singleton()->get_ticks_usec();
 
-		NavigationServer3D::get_singleton()->process(physics_step * time_scale);
+		{
+			MemoryTagScope navigation_tag(Memory::TAG_NAVIGATION);
+			NavigationServer3D::get_singleton()->process(physics_step * time_scale);
+		}
 
 		navigation_process_ticks = MAX(navigation_process_ticks, OS::get_singleton()->get_ticks_usec() - navigation_begin); // keep the largest one for reference
 		navigation_process_max = MAX(OS::get_singleton()->get_ticks_usec() - navigation_begin, navigation_process_max);
@@ -3785,8 +3807,11 @@ bool Main::iteration() {
 
 	uint64_t process_begin = OS::get_singleton()->get_ticks_usec();
 
-	if (OS::get_singleton()->get_main_loop()->process(process_step * time_scale)) {
-		exit = true;
+	{
+		MemoryTagScope scene_tag(Memory::TAG_SCENE);
+		if (OS::get_singleton()->get_main_loop()->process(process_step * time_scale)) {
+			exit = true;
+		}
 	}
 	message_queue->flush();
 
@@ -3794,6 +3819,7 @@ bool Main::iteration() {
 
 	if (DisplayServer::get_singleton()->can_any_window_draw() &&
 			RenderingServer::get_singleton()->is_render_loop_enabled()) {
+		MemoryTagScope rendering_tag(Memory::TAG_RENDERING);
 		if ((!force_redraw_requested) && OS::get_singleton()->is_in_low_processor_usage_mode()) {
 			if (RenderingServer::get_singleton()->has_changed()) {
 				RenderingServer::get_singleton()->draw(true, scaled_step); // flush visual commands
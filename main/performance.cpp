@@ -85,6 +85,26 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_BYTES_FLUSHED);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_FLUSH_TIME);
+	BIND_ENUM_CONSTANT(STRING_NAME_TABLE_LOAD_FACTOR);
+	BIND_ENUM_CONSTANT(STRING_NAME_CONTENDED_USEC);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_DEFAULT);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_SCENE);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_PHYSICS);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_NAVIGATION);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_RENDERING);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_AUDIO);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_RESOURCE);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_ARENA);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_DEFAULT_ALLOCS);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_SCENE_ALLOCS);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_PHYSICS_ALLOCS);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_NAVIGATION_ALLOCS);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_RENDERING_ALLOCS);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_AUDIO_ALLOCS);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_RESOURCE_ALLOCS);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_ARENA_ALLOCS);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -133,6 +153,26 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"navigation/edges_merged",
 		"navigation/edges_connected",
 		"navigation/edges_free",
+		"message_queue/bytes_flushed",
+		"message_queue/flush_time",
+		"string_name/table_load_factor",
+		"string_name/contended_usec",
+		"memory/tag_default",
+		"memory/tag_scene",
+		"memory/tag_physics",
+		"memory/tag_navigation",
+		"memory/tag_rendering",
+		"memory/tag_audio",
+		"memory/tag_resource",
+		"memory/tag_arena",
+		"memory/tag_default_allocs",
+		"memory/tag_scene_allocs",
+		"memory/tag_physics_allocs",
+		"memory/tag_navigation_allocs",
+		"memory/tag_rendering_allocs",
+		"memory/tag_audio_allocs",
+		"memory/tag_resource_allocs",
+		"memory/tag_arena_allocs",
 
 	};
 
@@ -207,6 +247,32 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case MESSAGE_QUEUE_BYTES_FLUSHED:
+			return MessageQueue::get_singleton()->get_last_flush_bytes();
+		case MESSAGE_QUEUE_FLUSH_TIME:
+			return MessageQueue::get_singleton()->get_last_flush_usec() / 1000000.0;
+		case STRING_NAME_TABLE_LOAD_FACTOR:
+			return StringName::get_table_load_factor();
+		case STRING_NAME_CONTENDED_USEC:
+			return StringName::get_contended_usec();
+		case MEMORY_TAG_DEFAULT:
+		case MEMORY_TAG_SCENE:
+		case MEMORY_TAG_PHYSICS:
+		case MEMORY_TAG_NAVIGATION:
+		case MEMORY_TAG_RENDERING:
+		case MEMORY_TAG_AUDIO:
+		case MEMORY_TAG_RESOURCE:
+		case MEMORY_TAG_ARENA:
+			return Memory::get_tag_usage(Memory::Tag(Memory::TAG_DEFAULT + (p_monitor - MEMORY_TAG_DEFAULT)));
+		case MEMORY_TAG_DEFAULT_ALLOCS:
+		case MEMORY_TAG_SCENE_ALLOCS:
+		case MEMORY_TAG_PHYSICS_ALLOCS:
+		case MEMORY_TAG_NAVIGATION_ALLOCS:
+		case MEMORY_TAG_RENDERING_ALLOCS:
+		case MEMORY_TAG_AUDIO_ALLOCS:
+		case MEMORY_TAG_RESOURCE_ALLOCS:
+		case MEMORY_TAG_ARENA_ALLOCS:
+			return Memory::get_tag_alloc_count(Memory::Tag(Memory::TAG_DEFAULT + (p_monitor - MEMORY_TAG_DEFAULT_ALLOCS)));
 
 		default: {
 		}
@@ -252,6 +318,26 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
@@ -100,6 +100,26 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		MESSAGE_QUEUE_BYTES_FLUSHED,
+		MESSAGE_QUEUE_FLUSH_TIME,
+		STRING_NAME_TABLE_LOAD_FACTOR,
+		STRING_NAME_CONTENDED_USEC,
+		MEMORY_TAG_DEFAULT,
+		MEMORY_TAG_SCENE,
+		MEMORY_TAG_PHYSICS,
+		MEMORY_TAG_NAVIGATION,
+		MEMORY_TAG_RENDERING,
+		MEMORY_TAG_AUDIO,
+		MEMORY_TAG_RESOURCE,
+		MEMORY_TAG_ARENA,
+		MEMORY_TAG_DEFAULT_ALLOCS,
+		MEMORY_TAG_SCENE_ALLOCS,
+		MEMORY_TAG_PHYSICS_ALLOCS,
+		MEMORY_TAG_NAVIGATION_ALLOCS,
+		MEMORY_TAG_RENDERING_ALLOCS,
+		MEMORY_TAG_AUDIO_ALLOCS,
+		MEMORY_TAG_RESOURCE_ALLOCS,
+		MEMORY_TAG_ARENA_ALLOCS,
 		MONITOR_MAX
 	};
 
@@ -31,10 +31,12 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_warning.h"
 
 #ifdef TOOLS_ENABLED
@@ -688,6 +690,7 @@ Error GDScript::reload(bool p_keep_state) {
 		return OK;
 	}
 	reloading = true;
+	GDScriptLanguage::ScriptGenerationScope generation_scope;
 
 	bool has_instances;
 	{
@@ -736,9 +739,21 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	// Exported projects can ship the compiled script, which skips parsing and compiling entirely.
+	if (!has_instances && GDScriptBytecodeCache::is_enabled() && GDScriptBytecodeCache::load_script(this) == OK) {
+		reloading = false;
+		if (can_run) {
+			return _static_init();
+		}
+		return OK;
+	}
+
 	valid = false;
-	GDScriptParser parser;
-	Error err = parser.parse(source, path, false);
+	// The tree may already have been parsed on a worker thread while the project was loading.
+	Ref<GDScriptParserRef> preparsed = GDScriptCache::take_preparsed(path, source);
+	GDScriptParser local_parser;
+	GDScriptParser &parser = preparsed.is_valid() ? *preparsed->get_parser() : local_parser;
+	Error err = preparsed.is_valid() ? OK : parser.parse(source, path, false);
 	if (err) {
 		if (EngineDebugger::is_active()) {
 			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
@@ -1426,6 +1441,7 @@ void GDScript::clear(ClearData *p_clear_data) {
 		return;
 	}
 	clearing = true;
+	GDScriptLanguage::ScriptGenerationScope generation_scope;
 
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
@@ -1513,6 +1529,7 @@ GDScript::~GDScript() {
 		return;
 	}
 	destructing = true;
+	GDScriptLanguage::ScriptGenerationScope generation_scope;
 
 	if (is_print_verbose_enabled()) {
 		MutexLock lock(func_ptrs_to_update_mutex);
@@ -2101,6 +2118,24 @@ void GDScriptLanguage::init() {
 		_add_global(E.name, E.ptr);
 	}
 
+#ifdef DEBUG_ENABLED
+	GDScriptSamplingProfiler::initialize();
+#endif
+
+	// The editor and `--check-only` load most named classes right away, and they are what other scripts
+	// depend on, so parse them all in parallel up front. Analysis still happens on load, one script at a time.
+	if (Engine::get_singleton()->is_editor_hint() || OS::get_singleton()->get_cmdline_args().find("--check-only")) {
+		Vector<String> paths;
+		List<StringName> global_classes;
+		ScriptServer::get_global_class_list(&global_classes);
+		for (const StringName &class_name : global_classes) {
+			if (ScriptServer::get_global_class_language(class_name) == get_name()) {
+				paths.push_back(ScriptServer::get_global_class_path(class_name));
+			}
+		}
+		GDScriptCache::parse_scripts(paths);
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2115,6 +2150,10 @@ String GDScriptLanguage::get_extension() const {
 }
 
 void GDScriptLanguage::finish() {
+#ifdef DEBUG_ENABLED
+	GDScriptSamplingProfiler::finish();
+#endif
+
 	_call_stack.free();
 
 	// Clear the cache before parsing the script_list
@@ -2721,6 +2760,9 @@ GDScriptLanguage::GDScriptLanguage() {
 
 	int dmcs = GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 
+	GLOBAL_DEF("gdscript/optimization/export_bytecode_cache", true);
+	GDScriptFunction::tier_up_call_count = GLOBAL_DEF(PropertyInfo(Variant::INT, "gdscript/optimization/tier_up_call_count", PROPERTY_HINT_RANGE, "0,10000,1,or_greater"), 1000);
+
 	if (EngineDebugger::is_active()) {
 		//debugging enabled!
 
@@ -84,6 +84,7 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
@@ -443,7 +444,18 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	HashMap<String, ObjectID> orphan_subclasses;
 
+	// Incremented when a script starts and finishes being reloaded, cleared or freed. Invalidates the
+	// inline caches of the GDScript VM, which may hold its member infos and functions.
+	SafeNumeric<uint32_t> script_generation;
+
 public:
+	// Lookups made by other threads while the script changes are cached with the generation of the
+	// start, so it's incremented again at the end.
+	struct ScriptGenerationScope {
+		ScriptGenerationScope() { singleton->script_generation.increment(); }
+		~ScriptGenerationScope() { singleton->script_generation.increment(); }
+	};
+
 	int calls;
 
 	bool debug_break(const String &p_error, bool p_allow_continue = true);
@@ -514,6 +526,8 @@ public:
 
 	} strings;
 
+	_FORCE_INLINE_ uint32_t get_script_generation() const { return script_generation.get(); }
+
 	_FORCE_INLINE_ int get_global_array_size() const { return global_array.size(); }
 	_FORCE_INLINE_ Variant *get_global_array() { return _global_array; }
 	_FORCE_INLINE_ const HashMap<StringName, int> &get_global_map() const { return globals; }
@@ -2637,6 +2637,13 @@ void GDScriptAnalyzer::reduce_assignment(GDScriptParser::AssignmentNode *p_assig
 	reduce_expression(p_assignment->assignee);
 	reduce_expression(p_assignment->assigned_value);
 
+	if (p_assignment->assignee != nullptr && p_assignment->assignee->type == GDScriptParser::Node::IDENTIFIER) {
+		GDScriptParser::IdentifierNode *assignee_id = static_cast<GDScriptParser::IdentifierNode *>(p_assignment->assignee);
+		if (assignee_id->source == GDScriptParser::IdentifierNode::LOCAL_VARIABLE) {
+			assignee_id->variable_source->reassigned = true;
+		}
+	}
+
 	if (p_assignment->assigned_value == nullptr || p_assignment->assignee == nullptr) {
 		return;
 	}
@@ -3284,6 +3291,10 @@ void GDScriptAnalyzer::reduce_call(GDScriptParser::CallNode *p_call, bool p_is_a
 		if (base_id && GDScriptParser::get_builtin_type(base_id->name) < Variant::VARIANT_MAX) {
 			base_type = make_builtin_meta_type(GDScriptParser::get_builtin_type(base_id->name));
 		} else {
+			// Count the uses of a local as the callee of `.call()` within its own function, so the compiler can tell if a lambda stored in it escapes.
+			if (base_id && !base_id->reduced && base_id->source == GDScriptParser::IdentifierNode::LOCAL_VARIABLE && base_id->source_function == parser->current_function && p_call->function_name == SNAME("call")) {
+				base_id->variable_source->direct_call_usages++;
+			}
 			reduce_expression(subscript->base);
 			base_type = subscript->base->get_datatype();
 			is_self = subscript->base->type == GDScriptParser::Node::SELF;
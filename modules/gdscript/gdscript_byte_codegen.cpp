@@ -136,6 +136,9 @@ uint32_t GDScriptByteCodeGenerator::add_temporary(const GDScriptDataType &p_type
 void GDScriptByteCodeGenerator::pop_temporary() {
 	ERR_FAIL_COND(used_temporaries.is_empty());
 	int slot_idx = used_temporaries.back()->get();
+	if (pending_forward.temporary >= 0) {
+		_apply_pending_forward(slot_idx);
+	}
 	const StackSlot &slot = temporaries[slot_idx];
 	if (slot.type == Variant::NIL) {
 		// Avoid keeping in the stack long-lived references to objects,
@@ -186,13 +189,20 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 #endif
 	append_opcode(GDScriptFunction::OPCODE_END);
 
-	for (int i = 0; i < temporaries.size(); i++) {
-		int stack_index = i + max_locals + RESERVED_STACK;
-		for (int j = 0; j < temporaries[i].bytecode_indices.size(); j++) {
-			opcodes.write[temporaries[i].bytecode_indices[j]] = stack_index | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
-		}
-		if (temporaries[i].type != Variant::NIL) {
-			function->temporary_slots[stack_index] = temporaries[i].type;
+	// Untyped temporaries first, so the typed ones end up together at the end of the stack.
+	int stack_index = max_locals + RESERVED_STACK;
+	for (int typed = 0; typed < 2; typed++) {
+		for (int i = 0; i < temporaries.size(); i++) {
+			if ((temporaries[i].type != Variant::NIL) != bool(typed)) {
+				continue;
+			}
+			for (int j = 0; j < temporaries[i].bytecode_indices.size(); j++) {
+				opcodes.write[temporaries[i].bytecode_indices[j]] = stack_index | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
+			}
+			if (typed) {
+				function->temporary_slots[stack_index] = temporaries[i].type;
+			}
+			stack_index++;
 		}
 	}
 
@@ -400,6 +410,7 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 	}
 	function->_stack_size = RESERVED_STACK + max_locals + temporaries.size();
 	function->_instruction_args_size = instr_args_max;
+	function->_update_typed_stack();
 
 #ifdef DEBUG_ENABLED
 	function->operator_names = operator_names;
@@ -431,6 +442,65 @@ void GDScriptByteCodeGenerator::set_initial_line(int p_line) {
 #define IS_BUILTIN_TYPE(m_var, m_type) \
 	(m_var.type.has_type && m_var.type.kind == GDScriptDataType::BUILTIN && m_var.type.builtin_type == m_type)
 
+// Typed code computes every operation into a temporary, so `x = a + b` is an operator into a
+// temporary followed by a copy into `x`. When the temporary is popped right after that copy, the
+// operator writes to `x` directly instead. Only for locals of the same value type that were already
+// written by a typed instruction, since validated operators expect the destination to have the
+// result type. Never when `x` is also an operand, as in `x = x + y`: evaluators for arrays and
+// other non-trivial types write the destination before they are done reading the operands.
+void GDScriptByteCodeGenerator::_try_forward_operator_result(const Address &p_target, const Address &p_source) {
+	pending_forward.temporary = -1;
+	if (!_is_last_operator_into(p_source) || p_target.mode != Address::LOCAL_VARIABLE || !HAS_BUILTIN_TYPE(p_target)) {
+		return;
+	}
+	const StackSlot &temporary = temporaries[p_source.address];
+	if (temporary.type == Variant::NIL || temporary.type != last_operator_result || p_target.type.builtin_type != last_operator_result) {
+		return;
+	}
+	if (!locals[p_target.address - RESERVED_STACK].written) {
+		return;
+	}
+	const int target = address_of(p_target);
+	if (opcodes[last_operator_pos + 1] == target || opcodes[last_operator_pos + 2] == target) {
+		return;
+	}
+
+	pending_forward.operator_pos = last_operator_pos;
+	pending_forward.assign_pos = opcodes.size();
+	pending_forward.temporary = p_source.address;
+	pending_forward.target = target;
+}
+
+void GDScriptByteCodeGenerator::_apply_pending_forward(int p_temporary) {
+	const PendingForward forward = pending_forward;
+	pending_forward.temporary = -1;
+
+	// Nothing may have been emitted after the copy, which must be the last instruction.
+	if (forward.temporary != p_temporary || opcodes.size() != forward.assign_pos + 3) {
+		return;
+	}
+	Vector<int> &indices = temporaries.write[p_temporary].bytecode_indices;
+	if (indices.size() < 2 || indices[indices.size() - 1] != forward.assign_pos + 2 || indices[indices.size() - 2] != forward.operator_pos + 3) {
+		return;
+	}
+
+	indices.resize(indices.size() - 2);
+	opcodes.write[forward.operator_pos + 3] = forward.target;
+	opcodes.resize(forward.assign_pos);
+	last_operator_pos = -1;
+}
+
+// Fuses a comparison into a temporary followed by a jump on it, the condition of most `if` and
+// `while` statements.
+bool GDScriptByteCodeGenerator::_try_fuse_jump_if_not(const Address &p_condition) {
+	if (!_is_last_operator_into(p_condition) || last_operator_result != Variant::BOOL) {
+		return false;
+	}
+	opcodes.write[last_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+	last_operator_pos = -1;
+	return true;
+}
+
 void GDScriptByteCodeGenerator::write_type_adjust(const Address &p_target, Variant::Type p_new_type) {
 	switch (p_new_type) {
 		case Variant::BOOL:
@@ -556,6 +626,7 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
 
+		_set_last_operator(p_target, Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, Variant::NIL));
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(Address());
@@ -584,8 +655,8 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	// Avoid validated evaluator for modulo and division when operands are int, since there's no check for division by zero.
 	if (HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand) && ((p_operator != Variant::OP_DIVIDE && p_operator != Variant::OP_MODULE) || p_left_operand.type.builtin_type != Variant::INT || p_right_operand.type.builtin_type != Variant::INT)) {
+		Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 		if (p_target.mode == Address::TEMPORARY) {
-			Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 			Variant::Type temp_type = temporaries[p_target.address].type;
 			if (result_type != temp_type) {
 				write_type_adjust(p_target, result_type);
@@ -595,6 +666,7 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
+		_set_last_operator(p_target, result_type);
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
@@ -891,6 +963,7 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 				append(p_target);
 				append(p_source);
 				append(p_target.type.builtin_type);
+				_mark_local_written(p_target);
 			}
 		} break;
 		case GDScriptDataType::NATIVE: {
@@ -938,10 +1011,15 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 		append(p_target);
 		append(p_source);
 		append(p_target.type.builtin_type);
+		_mark_local_written(p_target);
 	} else {
+		_try_forward_operator_result(p_target, p_source);
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN);
 		append(p_target);
 		append(p_source);
+		if (HAS_BUILTIN_TYPE(p_target) && HAS_BUILTIN_TYPE(p_source)) {
+			_mark_local_written(p_target);
+		}
 	}
 }
 
@@ -967,6 +1045,7 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
+	function->global_positions.push_back(opcodes.size());
 	append(p_global_index);
 }
 
@@ -1307,7 +1386,24 @@ void GDScriptByteCodeGenerator::write_lambda(const Address &p_target, GDScriptFu
 	ct.cleanup();
 }
 
+void GDScriptByteCodeGenerator::write_call_lambda(const Address &p_target, GDScriptFunction *p_function, const Vector<Address> &p_arguments, bool p_use_self) {
+	append_opcode_and_argcount(p_use_self ? GDScriptFunction::OPCODE_CALL_SELF_LAMBDA : GDScriptFunction::OPCODE_CALL_LAMBDA, 1 + p_arguments.size());
+	for (int i = 0; i < p_arguments.size(); i++) {
+		append(p_arguments[i]);
+	}
+
+	CallTarget ct = get_call_target(p_target);
+	append(ct.target);
+	append(p_arguments.size());
+	append(p_function);
+	ct.cleanup();
+}
+
 void GDScriptByteCodeGenerator::write_construct(const Address &p_target, Variant::Type p_type, const Vector<Address> &p_arguments) {
+	if (HAS_BUILTIN_TYPE(p_target) && p_target.type.builtin_type == p_type) {
+		_mark_local_written(p_target);
+	}
+
 	// Try to find an appropriate constructor.
 	bool all_have_type = true;
 	Vector<Variant::Type> arg_types;
@@ -1408,8 +1504,10 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	if (!_try_fuse_jump_if_not(p_condition)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_condition);
+	}
 	if_jmp_addrs.push_back(opcodes.size());
 	append(0); // Jump destination, will be patched.
 }
@@ -1570,6 +1668,7 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 	// Next iteration.
 	int continue_addr = opcodes.size();
 	continue_addrs.push_back(continue_addr);
+	last_operator_pos = -1;
 	append_opcode(iterate_opcode);
 	append(counter);
 	append(container);
@@ -1612,12 +1711,15 @@ void GDScriptByteCodeGenerator::write_endfor() {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	last_operator_pos = -1;
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	if (!_try_fuse_jump_if_not(p_condition)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_condition);
+	}
 	while_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
 }
@@ -1732,10 +1834,25 @@ void GDScriptByteCodeGenerator::write_return(const Address &p_return_value) {
 	}
 }
 
+#ifdef DEBUG_ENABLED
+void GDScriptByteCodeGenerator::start_assert() {
+	// The whole assertion may be skipped, so nothing before it can be rewritten from inside it.
+	pending_forward.temporary = -1;
+	assert_start = opcodes.size();
+}
+#endif
+
 void GDScriptByteCodeGenerator::write_assert(const Address &p_test, const Address &p_message) {
 	append_opcode(GDScriptFunction::OPCODE_ASSERT);
 	append(p_test);
 	append(p_message);
+#ifdef DEBUG_ENABLED
+	if (assert_start >= 0) {
+		function->assert_ranges.push_back(assert_start);
+		function->assert_ranges.push_back(opcodes.size());
+		assert_start = -1;
+	}
+#endif
 }
 
 void GDScriptByteCodeGenerator::start_block() {
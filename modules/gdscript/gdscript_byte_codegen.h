@@ -39,6 +39,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	struct StackSlot {
 		Variant::Type type = Variant::NIL;
 		Vector<int> bytecode_indices;
+		bool written = false; // For locals, whether a write to it has been emitted since it was added.
 
 		StackSlot() = default;
 		StackSlot(Variant::Type p_type) :
@@ -157,6 +158,42 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<List<int>> current_breaks_to_patch;
 
+#ifdef DEBUG_ENABLED
+	int assert_start = -1;
+#endif
+
+	// Peephole state. Only valid while the validated operator is the last emitted instruction and
+	// nothing jumps to the address right after it.
+	int last_operator_pos = -1;
+	Address last_operator_target;
+	Variant::Type last_operator_result = Variant::NIL;
+
+	// An assignment from the result of the last operator, removed if its source is popped right after.
+	struct PendingForward {
+		int operator_pos = -1;
+		int assign_pos = -1;
+		int temporary = -1;
+		int target = 0;
+	} pending_forward;
+
+	bool _is_last_operator_into(const Address &p_address) const {
+		return last_operator_pos >= 0 && last_operator_pos + 5 == opcodes.size() && p_address.mode == Address::TEMPORARY && last_operator_target.mode == Address::TEMPORARY && last_operator_target.address == p_address.address;
+	}
+	void _set_last_operator(const Address &p_target, Variant::Type p_result) {
+		function->operator_positions.push_back(opcodes.size());
+		last_operator_pos = opcodes.size();
+		last_operator_target = p_target;
+		last_operator_result = p_result;
+	}
+	void _mark_local_written(const Address &p_target) {
+		if (p_target.mode == Address::LOCAL_VARIABLE) {
+			locals.write[p_target.address - RESERVED_STACK].written = true;
+		}
+	}
+	void _try_forward_operator_result(const Address &p_target, const Address &p_source);
+	void _apply_pending_forward(int p_temporary);
+	bool _try_fuse_jump_if_not(const Address &p_condition);
+
 	void add_stack_identifier(const StringName &p_id, int p_stackpos) {
 		if (locals.size() > max_locals) {
 			max_locals = locals.size();
@@ -445,6 +482,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		last_operator_pos = -1; // The next instruction is a jump target.
 	}
 
 public:
@@ -517,6 +555,7 @@ public:
 	virtual void write_call_self_async(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
 	virtual void write_call_script_function(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
 	virtual void write_lambda(const Address &p_target, GDScriptFunction *p_function, const Vector<Address> &p_captures, bool p_use_self) override;
+	virtual void write_call_lambda(const Address &p_target, GDScriptFunction *p_function, const Vector<Address> &p_arguments, bool p_use_self) override;
 	virtual void write_construct(const Address &p_target, Variant::Type p_type, const Vector<Address> &p_arguments) override;
 	virtual void write_construct_array(const Address &p_target, const Vector<Address> &p_arguments) override;
 	virtual void write_construct_typed_array(const Address &p_target, const GDScriptDataType &p_element_type, const Vector<Address> &p_arguments) override;
@@ -539,6 +578,9 @@ public:
 	virtual void write_breakpoint() override;
 	virtual void write_newline(int p_line) override;
 	virtual void write_return(const Address &p_return_value) override;
+#ifdef DEBUG_ENABLED
+	virtual void start_assert() override;
+#endif
 	virtual void write_assert(const Address &p_test, const Address &p_message) override;
 
 	virtual ~GDScriptByteCodeGenerator();
@@ -0,0 +1,1212 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+#include "core/version.h"
+#include "scene/resources/packed_scene.h"
+
+// A function referenced by compiled code, by its pointer.
+// Stored by name and types instead, which are the same in every build of the same engine version.
+struct GDScriptBytecodeCache::FunctionKey {
+	uint32_t type = 0;
+	uint32_t arg_a = 0;
+	uint32_t arg_b = 0;
+	StringName name;
+};
+
+#ifdef TOOLS_ENABLED
+
+struct GDScriptBytecodeCache::FunctionKeys {
+	RBMap<Variant::ValidatedOperatorEvaluator, FunctionKey> operators;
+	RBMap<Variant::ValidatedSetter, FunctionKey> setters;
+	RBMap<Variant::ValidatedGetter, FunctionKey> getters;
+	RBMap<Variant::ValidatedKeyedSetter, FunctionKey> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, FunctionKey> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, FunctionKey> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, FunctionKey> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, FunctionKey> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, FunctionKey> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, FunctionKey> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, FunctionKey> gds_utilities;
+	HashMap<int, StringName> globals;
+
+	FunctionKeys() {
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			Variant::Type type = Variant::Type(i);
+			FunctionKey key;
+			key.type = type;
+
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), type, Variant::Type(j));
+					if (evaluator && !operators.has(evaluator)) {
+						FunctionKey op_key;
+						op_key.type = op;
+						op_key.arg_a = type;
+						op_key.arg_b = j;
+						operators.insert(evaluator, op_key);
+					}
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &E : members) {
+				FunctionKey member_key = key;
+				member_key.name = E;
+				setters.insert(Variant::get_member_validated_setter(type, E), member_key);
+				getters.insert(Variant::get_member_validated_getter(type, E), member_key);
+			}
+
+			if (Variant::get_member_validated_keyed_setter(type)) {
+				keyed_setters.insert(Variant::get_member_validated_keyed_setter(type), key);
+				keyed_getters.insert(Variant::get_member_validated_keyed_getter(type), key);
+			}
+			if (Variant::get_member_validated_indexed_setter(type)) {
+				indexed_setters.insert(Variant::get_member_validated_indexed_setter(type), key);
+				indexed_getters.insert(Variant::get_member_validated_indexed_getter(type), key);
+			}
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &E : methods) {
+				FunctionKey method_key = key;
+				method_key.name = E;
+				builtin_methods.insert(Variant::get_validated_builtin_method(type, E), method_key);
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				FunctionKey constructor_key = key;
+				constructor_key.arg_a = j;
+				constructors.insert(Variant::get_validated_constructor(type, j), constructor_key);
+			}
+		}
+
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &E : functions) {
+			FunctionKey key;
+			key.name = E;
+			utilities.insert(Variant::get_validated_utility_function(E), key);
+		}
+
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &E : functions) {
+			FunctionKey key;
+			key.name = E;
+			gds_utilities.insert(GDScriptUtilityFunctions::get_function(E), key);
+		}
+
+		for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+			globals.insert(E.value, E.key);
+		}
+	}
+};
+
+#endif // TOOLS_ENABLED
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_script_path) {
+	// Built-in scripts are compiled with their scene.
+	if (!p_script_path.ends_with(".gd")) {
+		return String();
+	}
+	return p_script_path.get_basename() + ".gdbc";
+}
+
+uint32_t GDScriptBytecodeCache::get_engine_hash() {
+	// Code is only portable between identical builds: opcodes, operators, and function
+	// tables are all numbered by the engine and the same compiler has to produce it.
+	uint32_t hash = hash_murmur3_one_32(FORMAT_VERSION);
+	hash = hash_murmur3_one_32(String(VERSION_FULL_BUILD).hash(), hash);
+	hash = hash_murmur3_one_32(String(VERSION_HASH).hash(), hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::OPCODE_END, hash);
+	hash = hash_murmur3_one_32(Variant::VARIANT_MAX, hash);
+	hash = hash_murmur3_one_32(Variant::OP_MAX, hash);
+	hash = hash_murmur3_one_32(sizeof(real_t), hash);
+	// Not whether this is a debug build. The code comes from the editor, which always compiles line
+	// markers, breakpoints, and assertions. Release builds ignore the first two and skip assertions.
+	return hash_fmix32(hash);
+}
+
+bool GDScriptBytecodeCache::is_enabled() {
+	// The editor always compiles from source, scripts can change at any time there.
+	return !Engine::get_singleton()->is_editor_hint();
+}
+
+/* Reading */
+
+uint32_t GDScriptBytecodeCache::Reader::read_count() {
+	uint32_t count = buffer->get_u32();
+	// Every element takes at least one byte, don't allocate for corrupted sizes.
+	if ((int64_t)count > buffer->get_available_bytes()) {
+		fail(ERR_FILE_CORRUPT);
+		return 0;
+	}
+	return count;
+}
+
+StringName GDScriptBytecodeCache::Reader::read_name() {
+	String name = buffer->get_utf8_string();
+	return name.is_empty() ? StringName() : StringName(name);
+}
+
+GDScriptBytecodeCache::FunctionKey GDScriptBytecodeCache::Reader::read_key() {
+	FunctionKey key;
+	key.type = buffer->get_u32();
+	key.arg_a = buffer->get_u32();
+	key.arg_b = buffer->get_u32();
+	key.name = read_name();
+	return key;
+}
+
+Ref<Script> GDScriptBytecodeCache::Reader::read_script_ref(bool &r_is_local) {
+	r_is_local = false;
+	bool is_gdscript = buffer->get_u8();
+	String path = buffer->get_utf8_string();
+
+	if (!is_gdscript) {
+		Ref<Script> script = ResourceLoader::load(path, "Script");
+		if (script.is_null()) {
+			fail(ERR_CANT_RESOLVE);
+		}
+		return script;
+	}
+
+	String fully_qualified_name = buffer->get_utf8_string();
+	GDScript *script = nullptr;
+	if (path == root->path) {
+		r_is_local = true;
+		script = root->find_class(fully_qualified_name);
+	} else {
+		Error err = OK;
+		Ref<GDScript> other_root = GDScriptCache::get_shallow_script(path, err, root->path);
+		if (err == OK && other_root.is_valid()) {
+			script = other_root->find_class(fully_qualified_name);
+		}
+	}
+
+	if (script == nullptr) {
+		fail(ERR_CANT_RESOLVE);
+		return Ref<Script>();
+	}
+	return Ref<Script>(script);
+}
+
+Variant GDScriptBytecodeCache::Reader::read_variant() {
+	switch (buffer->get_u8()) {
+		case VARIANT_TAG_VALUE: {
+			return buffer->get_var();
+		}
+		case VARIANT_TAG_ARRAY: {
+			uint32_t typed_builtin = buffer->get_u32();
+			StringName typed_class_name = read_name();
+			Ref<Script> typed_script;
+			if (buffer->get_u8()) {
+				bool is_local = false;
+				typed_script = read_script_ref(is_local);
+			}
+			bool read_only = buffer->get_u8();
+
+			Array array;
+			uint32_t size = read_count();
+			array.resize(size);
+			for (uint32_t i = 0; i < size && error == OK; i++) {
+				array[i] = read_variant();
+			}
+			if (typed_builtin != Variant::NIL) {
+				array = Array(array, typed_builtin, typed_class_name, typed_script);
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			return array;
+		}
+		case VARIANT_TAG_DICTIONARY: {
+			bool read_only = buffer->get_u8();
+
+			Dictionary dictionary;
+			uint32_t size = read_count();
+			for (uint32_t i = 0; i < size && error == OK; i++) {
+				Variant key = read_variant();
+				dictionary[key] = read_variant();
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			return dictionary;
+		}
+		case VARIANT_TAG_NULL_OBJECT: {
+			return Variant((Object *)nullptr);
+		}
+		case VARIANT_TAG_NATIVE_CLASS: {
+			StringName name = read_name();
+			const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(name);
+			if (index == nullptr) {
+				fail(ERR_CANT_RESOLVE);
+				return Variant();
+			}
+			return GDScriptLanguage::get_singleton()->get_global_array()[*index];
+		}
+		case VARIANT_TAG_SCRIPT: {
+			bool is_local = false;
+			return read_script_ref(is_local);
+		}
+		case VARIANT_TAG_SINGLETON: {
+			Object *singleton = Engine::get_singleton()->get_singleton_object(read_name());
+			if (singleton == nullptr) {
+				fail(ERR_CANT_RESOLVE);
+			}
+			return singleton;
+		}
+		case VARIANT_TAG_RESOURCE: {
+			bool is_scene = buffer->get_u8();
+			String path = buffer->get_utf8_string();
+			Error err = OK;
+			Ref<Resource> resource;
+			if (is_scene) {
+				// Same as preloading a scene from source, which can depend on this script.
+				resource = GDScriptCache::get_packed_scene(path, err, root->path);
+			} else {
+				resource = ResourceLoader::load(path);
+			}
+			if (err != OK || resource.is_null()) {
+				fail(ERR_CANT_RESOLVE);
+			}
+			return resource;
+		}
+		default: {
+			fail(ERR_FILE_CORRUPT);
+			return Variant();
+		}
+	}
+}
+
+GDScriptDataType GDScriptBytecodeCache::Reader::read_data_type() {
+	GDScriptDataType type;
+	type.has_type = buffer->get_u8();
+	type.kind = GDScriptDataType::Kind(buffer->get_u8());
+	type.builtin_type = Variant::Type(buffer->get_u32());
+	type.native_type = read_name();
+	if (buffer->get_u8()) {
+		bool is_local = false;
+		Ref<Script> script = read_script_ref(is_local);
+		type.script_type = script.ptr();
+		// Same as the compiler, local classes are not referenced to avoid cycles.
+		if (!is_local) {
+			type.script_type_ref = script;
+		}
+	}
+	uint32_t element_count = read_count();
+	for (uint32_t i = 0; i < element_count && error == OK; i++) {
+		type.container_element_types.push_back(read_data_type());
+	}
+	if (type.builtin_type >= Variant::VARIANT_MAX) {
+		fail(ERR_FILE_CORRUPT);
+	}
+	return type;
+}
+
+PropertyInfo GDScriptBytecodeCache::Reader::read_property_info() {
+	PropertyInfo info;
+	info.type = Variant::Type(buffer->get_u32());
+	info.name = buffer->get_utf8_string();
+	info.class_name = read_name();
+	info.hint = PropertyHint(buffer->get_u32());
+	info.hint_string = buffer->get_utf8_string();
+	info.usage = buffer->get_u32();
+	return info;
+}
+
+MethodInfo GDScriptBytecodeCache::Reader::read_method_info() {
+	MethodInfo info;
+	info.name = buffer->get_utf8_string();
+	info.return_val = read_property_info();
+	info.flags = buffer->get_u32();
+	info.id = buffer->get_32();
+	uint32_t argument_count = read_count();
+	for (uint32_t i = 0; i < argument_count && error == OK; i++) {
+		info.arguments.push_back(read_property_info());
+	}
+	uint32_t default_count = read_count();
+	for (uint32_t i = 0; i < default_count && error == OK; i++) {
+		info.default_arguments.push_back(read_variant());
+	}
+	return info;
+}
+
+GDScriptFunction *GDScriptBytecodeCache::Reader::read_function(GDScript *p_script) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->name = read_name();
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	function->_static = buffer->get_u8();
+	function->rpc_config = read_variant();
+	function->return_type = read_data_type();
+	uint32_t argument_count = read_count();
+	for (uint32_t i = 0; i < argument_count && error == OK; i++) {
+		function->argument_types.push_back(read_data_type());
+	}
+	function->method_info = read_method_info();
+	function->_initial_line = buffer->get_32();
+	function->_argument_count = buffer->get_32();
+	function->_stack_size = buffer->get_32();
+	function->_instruction_args_size = buffer->get_32();
+
+	uint32_t default_argument_count = read_count();
+	for (uint32_t i = 0; i < default_argument_count && error == OK; i++) {
+		function->default_arguments.push_back(buffer->get_32());
+	}
+
+	uint32_t code_size = read_count();
+	function->code.resize(code_size);
+	for (uint32_t i = 0; i < code_size && error == OK; i++) {
+		function->code.write[i] = buffer->get_32();
+	}
+
+	uint32_t global_count = read_count();
+	for (uint32_t i = 0; i < global_count && error == OK; i++) {
+		uint32_t pos = buffer->get_u32();
+		const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(read_name());
+		if (pos >= code_size || index == nullptr) {
+			fail(ERR_CANT_RESOLVE);
+			break;
+		}
+		function->code.write[pos] = *index;
+		function->global_positions.push_back(pos);
+	}
+
+	uint32_t operator_count = read_count();
+	for (uint32_t i = 0; i < operator_count && error == OK; i++) {
+		function->operator_positions.push_back(buffer->get_u32());
+	}
+
+	uint32_t assert_count = read_count();
+	for (uint32_t i = 0; i < assert_count && error == OK; i++) {
+		uint32_t start = buffer->get_u32();
+		uint32_t end = buffer->get_u32();
+		if (start > end || end > code_size || end - start < 3) {
+			fail(ERR_FILE_CORRUPT);
+			break;
+		}
+#ifdef DEBUG_ENABLED
+		function->assert_ranges.push_back(start);
+		function->assert_ranges.push_back(end);
+#else
+		// The editor always compiles assertions. Release builds don't evaluate them, not even their
+		// condition, so jump over all of their code like it was never compiled.
+		function->code.write[start] = GDScriptFunction::OPCODE_JUMP;
+		function->code.write[start + 1] = end;
+#endif
+	}
+
+	uint32_t constant_count = read_count();
+	for (uint32_t i = 0; i < constant_count && error == OK; i++) {
+		function->constants.push_back(read_variant());
+	}
+
+	uint32_t name_count = read_count();
+	for (uint32_t i = 0; i < name_count && error == OK; i++) {
+		function->global_names.push_back(read_name());
+	}
+
+	uint32_t temporary_count = read_count();
+	for (uint32_t i = 0; i < temporary_count && error == OK; i++) {
+		int slot = buffer->get_32();
+		uint32_t type = buffer->get_u32();
+		if (slot < 0 || slot >= function->_stack_size || type == Variant::NIL || type >= Variant::VARIANT_MAX) {
+			fail(ERR_FILE_CORRUPT);
+			break;
+		}
+		function->temporary_slots[slot] = Variant::Type(type);
+	}
+	function->_update_typed_stack();
+
+	uint32_t stack_debug_count = read_count();
+	for (uint32_t i = 0; i < stack_debug_count && error == OK; i++) {
+		GDScriptFunction::StackDebug stack_debug;
+		stack_debug.line = buffer->get_32();
+		stack_debug.pos = buffer->get_32();
+		stack_debug.added = buffer->get_u8();
+		stack_debug.identifier = read_name();
+		function->stack_debug.push_back(stack_debug);
+	}
+
+#ifdef DEBUG_ENABLED
+#define ADD_DEBUG_NAME(m_names, m_name) function->m_names.push_back(m_name)
+#else
+#define ADD_DEBUG_NAME(m_names, m_name)
+#endif
+
+#define READ_FUNCTION_TABLE(m_table, m_lookup, m_add_name)   \
+	{                                                         \
+		uint32_t count = read_count();                        \
+		for (uint32_t i = 0; i < count && error == OK; i++) { \
+			FunctionKey key = read_key();                     \
+			function->m_table.push_back(m_lookup);            \
+			if (function->m_table[i] == nullptr) {            \
+				fail(ERR_CANT_RESOLVE);                       \
+			}                                                 \
+			m_add_name;                                       \
+		}                                                     \
+	}
+
+	READ_FUNCTION_TABLE(operator_funcs, Variant::get_validated_operator_evaluator(Variant::Operator(key.type), Variant::Type(key.arg_a), Variant::Type(key.arg_b)), ADD_DEBUG_NAME(operator_names, Variant::get_operator_name(Variant::Operator(key.type))));
+	READ_FUNCTION_TABLE(setters, Variant::get_member_validated_setter(Variant::Type(key.type), key.name), ADD_DEBUG_NAME(setter_names, key.name));
+	READ_FUNCTION_TABLE(getters, Variant::get_member_validated_getter(Variant::Type(key.type), key.name), ADD_DEBUG_NAME(getter_names, key.name));
+	READ_FUNCTION_TABLE(keyed_setters, Variant::get_member_validated_keyed_setter(Variant::Type(key.type)), (void)0);
+	READ_FUNCTION_TABLE(keyed_getters, Variant::get_member_validated_keyed_getter(Variant::Type(key.type)), (void)0);
+	READ_FUNCTION_TABLE(indexed_setters, Variant::get_member_validated_indexed_setter(Variant::Type(key.type)), (void)0);
+	READ_FUNCTION_TABLE(indexed_getters, Variant::get_member_validated_indexed_getter(Variant::Type(key.type)), (void)0);
+	READ_FUNCTION_TABLE(builtin_methods, Variant::get_validated_builtin_method(Variant::Type(key.type), key.name), ADD_DEBUG_NAME(builtin_methods_names, key.name));
+	READ_FUNCTION_TABLE(constructors, Variant::get_validated_constructor(Variant::Type(key.type), key.arg_a), ADD_DEBUG_NAME(constructors_names, Variant::get_type_name(Variant::Type(key.type))));
+	READ_FUNCTION_TABLE(utilities, Variant::get_validated_utility_function(key.name), ADD_DEBUG_NAME(utilities_names, key.name));
+	READ_FUNCTION_TABLE(gds_utilities, GDScriptUtilityFunctions::get_function(key.name), ADD_DEBUG_NAME(gds_utilities_names, key.name));
+
+#undef READ_FUNCTION_TABLE
+#undef ADD_DEBUG_NAME
+
+	uint32_t method_count = read_count();
+	for (uint32_t i = 0; i < method_count && error == OK; i++) {
+		StringName class_name = read_name();
+		MethodBind *method = ClassDB::get_method(class_name, read_name());
+		if (method == nullptr) {
+			fail(ERR_CANT_RESOLVE);
+		}
+		function->methods.push_back(method);
+	}
+
+	uint32_t lambda_count = read_count();
+	for (uint32_t i = 0; i < lambda_count && error == OK; i++) {
+		GDScript::LambdaInfo info;
+		info.capture_count = buffer->get_32();
+		info.use_self = buffer->get_u8();
+		GDScriptFunction *lambda = read_function(p_script);
+		if (lambda == nullptr) {
+			break;
+		}
+		function->lambdas.push_back(lambda);
+		p_script->lambda_info.insert(lambda, info);
+	}
+
+	for (int pos : function->operator_positions) {
+		if (pos < 0 || pos >= (int)code_size) {
+			fail(ERR_FILE_CORRUPT);
+		}
+	}
+
+	if (error != OK) {
+		// Lambdas read so far are owned by the function.
+		for (GDScriptFunction *lambda : function->lambdas) {
+			p_script->lambda_info.erase(lambda);
+		}
+		memdelete(function);
+		return nullptr;
+	}
+
+	// Same layout as GDScriptByteCodeGenerator::write_end().
+	function->_code_size = function->code.size();
+	function->_code_ptr = function->code.is_empty() ? nullptr : function->code.ptrw();
+	function->_default_arg_count = function->default_arguments.is_empty() ? 0 : function->default_arguments.size() - 1;
+	function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+
+#define SET_TABLE_POINTER(m_table, m_ptr, m_count)      \
+	function->m_count = function->m_table.size();       \
+	function->m_ptr = function->m_table.is_empty() ? nullptr : function->m_table.ptrw();
+
+	SET_TABLE_POINTER(constants, _constants_ptr, _constant_count);
+	SET_TABLE_POINTER(global_names, _global_names_ptr, _global_names_count);
+	SET_TABLE_POINTER(operator_funcs, _operator_funcs_ptr, _operator_funcs_count);
+	SET_TABLE_POINTER(setters, _setters_ptr, _setters_count);
+	SET_TABLE_POINTER(getters, _getters_ptr, _getters_count);
+	SET_TABLE_POINTER(keyed_setters, _keyed_setters_ptr, _keyed_setters_count);
+	SET_TABLE_POINTER(keyed_getters, _keyed_getters_ptr, _keyed_getters_count);
+	SET_TABLE_POINTER(indexed_setters, _indexed_setters_ptr, _indexed_setters_count);
+	SET_TABLE_POINTER(indexed_getters, _indexed_getters_ptr, _indexed_getters_count);
+	SET_TABLE_POINTER(builtin_methods, _builtin_methods_ptr, _builtin_methods_count);
+	SET_TABLE_POINTER(constructors, _constructors_ptr, _constructors_count);
+	SET_TABLE_POINTER(utilities, _utilities_ptr, _utilities_count);
+	SET_TABLE_POINTER(gds_utilities, _gds_utilities_ptr, _gds_utilities_count);
+	SET_TABLE_POINTER(methods, _methods_ptr, _methods_count);
+	SET_TABLE_POINTER(lambdas, _lambdas_ptr, _lambdas_count);
+
+#undef SET_TABLE_POINTER
+
+	return function;
+}
+
+void GDScriptBytecodeCache::Reader::read_class_tree(GDScript *p_script) {
+	p_script->fully_qualified_name = buffer->get_utf8_string();
+	p_script->local_name = read_name();
+	p_script->global_name = read_name();
+	p_script->simplified_icon_path = buffer->get_utf8_string();
+
+	uint32_t subclass_count = read_count();
+	for (uint32_t i = 0; i < subclass_count && error == OK; i++) {
+		StringName name = read_name();
+		Ref<GDScript> subclass;
+		if (p_script->subclasses.has(name)) {
+			subclass = p_script->subclasses[name];
+		} else {
+			subclass.instantiate();
+			subclass->_owner = p_script;
+			subclass->path = p_script->path;
+			p_script->subclasses.insert(name, subclass);
+		}
+		read_class_tree(subclass.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::Reader::read_class(GDScript *p_script) {
+	p_script->tool = buffer->get_u8();
+
+	if (buffer->get_u8()) {
+		bool is_local = false;
+		Ref<GDScript> base = Object::cast_to<GDScript>(read_script_ref(is_local).ptr());
+		if (base.is_null()) {
+			fail(ERR_CANT_RESOLVE);
+			return;
+		}
+		p_script->base = base;
+		p_script->_base = base.ptr();
+	}
+	p_script->native = Ref<GDScriptNativeClass>(read_variant());
+	if (p_script->native.is_null()) {
+		fail(ERR_CANT_RESOLVE);
+		return;
+	}
+
+	uint32_t member_count = read_count();
+	for (uint32_t i = 0; i < member_count && error == OK; i++) {
+		StringName name = read_name();
+		GDScript::MemberInfo info;
+		info.index = buffer->get_32();
+		info.setter = read_name();
+		info.getter = read_name();
+		info.data_type = read_data_type();
+		info.property_info = read_property_info();
+		p_script->member_indices[name] = info;
+	}
+
+	uint32_t own_member_count = read_count();
+	for (uint32_t i = 0; i < own_member_count && error == OK; i++) {
+		p_script->members.insert(read_name());
+	}
+
+	uint32_t static_count = read_count();
+	for (uint32_t i = 0; i < static_count && error == OK; i++) {
+		StringName name = read_name();
+		GDScript::MemberInfo info;
+		info.index = buffer->get_32();
+		info.setter = read_name();
+		info.getter = read_name();
+		info.data_type = read_data_type();
+		info.property_info = read_property_info();
+		p_script->static_variables_indices[name] = info;
+	}
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+	uint32_t constant_count = read_count();
+	for (uint32_t i = 0; i < constant_count && error == OK; i++) {
+		StringName name = read_name();
+		p_script->constants.insert(name, read_variant());
+	}
+
+	uint32_t signal_count = read_count();
+	for (uint32_t i = 0; i < signal_count && error == OK; i++) {
+		StringName name = read_name();
+		p_script->_signals[name] = read_method_info();
+	}
+
+	p_script->rpc_config = read_variant();
+
+	uint32_t function_count = read_count();
+	for (uint32_t i = 0; i < function_count && error == OK; i++) {
+		FunctionRole role = FunctionRole(buffer->get_u8());
+		GDScriptFunction *function = read_function(p_script);
+		if (function == nullptr) {
+			break;
+		}
+		switch (role) {
+			case FUNCTION_ROLE_MEMBER: {
+				p_script->member_functions[function->name] = function;
+				if (function->name == GDScriptLanguage::get_singleton()->strings._init) {
+					p_script->initializer = function;
+				}
+			} break;
+			case FUNCTION_ROLE_IMPLICIT_INITIALIZER: {
+				p_script->implicit_initializer = function;
+			} break;
+			case FUNCTION_ROLE_IMPLICIT_READY: {
+				p_script->implicit_ready = function;
+			} break;
+			case FUNCTION_ROLE_STATIC_INITIALIZER: {
+				p_script->static_initializer = function;
+			} break;
+		}
+	}
+
+	uint32_t subclass_count = read_count();
+	for (uint32_t i = 0; i < subclass_count && error == OK; i++) {
+		StringName name = read_name();
+		HashMap<StringName, Ref<GDScript>>::Iterator E = p_script->subclasses.find(name);
+		if (!E) {
+			fail(ERR_FILE_CORRUPT);
+			return;
+		}
+		read_class(E->value.ptr());
+		p_script->constants.insert(name, E->value);
+	}
+
+	if (error == OK) {
+		p_script->valid = true;
+	}
+}
+
+Error GDScriptBytecodeCache::_open(const String &p_script_path, Reader &r_reader) {
+	String cache_path = get_cache_path(p_script_path);
+	if (cache_path.is_empty() || !FileAccess::exists(cache_path)) {
+		return ERR_FILE_NOT_FOUND;
+	}
+
+	Error err = OK;
+	Vector<uint8_t> data = FileAccess::get_file_as_bytes(cache_path, &err);
+	if (err != OK) {
+		return err;
+	}
+
+	r_reader.buffer.instantiate();
+	r_reader.buffer->set_data_array(data);
+	if (r_reader.buffer->get_size() < 12) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	uint8_t magic[4] = {};
+	r_reader.buffer->get_data(magic, 4);
+	if (magic[0] != 'G' || magic[1] != 'D' || magic[2] != 'B' || magic[3] != 'C') {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	if (r_reader.buffer->get_u32() != FORMAT_VERSION || r_reader.buffer->get_u32() != get_engine_hash()) {
+		print_verbose(vformat(R"(GDScript: Bytecode cache "%s" was made by a different engine build, compiling from source instead.)", cache_path));
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	return OK;
+}
+
+void GDScriptBytecodeCache::_discard(GDScript *p_script) {
+	// Same as GDScriptCompiler::_prepare_compilation(), so the compiler doesn't get a half loaded script.
+	for (KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_discard(E.value.ptr());
+	}
+
+	p_script->valid = false;
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = nullptr;
+	p_script->members.clear();
+
+	// Constants can hold the last reference to a script that points back to this one.
+	HashMap<StringName, Variant> constants = p_script->constants;
+	p_script->constants.clear();
+	constants.clear();
+
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		memdelete(E.value);
+	}
+	p_script->member_functions.clear();
+	if (p_script->implicit_initializer) {
+		memdelete(p_script->implicit_initializer);
+	}
+	if (p_script->implicit_ready) {
+		memdelete(p_script->implicit_ready);
+	}
+	if (p_script->static_initializer) {
+		memdelete(p_script->static_initializer);
+	}
+	p_script->initializer = nullptr;
+	p_script->implicit_initializer = nullptr;
+	p_script->implicit_ready = nullptr;
+	p_script->static_initializer = nullptr;
+
+	p_script->member_indices.clear();
+	p_script->static_variables_indices.clear();
+	p_script->static_variables.clear();
+	p_script->_signals.clear();
+	p_script->rpc_config.clear();
+	p_script->lambda_info.clear();
+}
+
+Error GDScriptBytecodeCache::make_shallow_script(GDScript *p_script) {
+	Reader reader;
+	Error err = _open(p_script->path, reader);
+	if (err != OK) {
+		return err;
+	}
+
+	reader.root = p_script;
+	reader.buffer->get_u8(); // Static data flag, only needed when loading.
+	reader.read_class_tree(p_script);
+	return reader.error;
+}
+
+Error GDScriptBytecodeCache::load_script(GDScript *p_script) {
+	// Only fill scripts that were never compiled, the compiler takes care of everything else.
+	if (p_script->valid || !p_script->member_functions.is_empty() || p_script->implicit_initializer) {
+		return ERR_ALREADY_IN_USE;
+	}
+
+	Reader reader;
+	Error err = _open(p_script->path, reader);
+	if (err != OK) {
+		return err;
+	}
+
+	reader.root = p_script;
+	p_script->_owner = nullptr;
+	bool has_static_data = reader.buffer->get_u8();
+	reader.read_class_tree(p_script);
+	if (reader.error == OK) {
+		reader.read_class(p_script);
+	}
+
+	if (reader.error != OK) {
+		ERR_PRINT(vformat(R"(GDScript: Failed to load bytecode cache for "%s": %s. Compiling from source instead.)", p_script->path, error_names[reader.error]));
+		_discard(p_script);
+		return reader.error;
+	}
+
+	if (has_static_data) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+/* Writing */
+
+#ifdef TOOLS_ENABLED
+
+void GDScriptBytecodeCache::Writer::write_name(const StringName &p_name) {
+	buffer->put_utf8_string(p_name);
+}
+
+void GDScriptBytecodeCache::Writer::write_key(const FunctionKey *p_key) {
+	if (p_key == nullptr) {
+		fail(ERR_UNAVAILABLE);
+		return;
+	}
+	buffer->put_u32(p_key->type);
+	buffer->put_u32(p_key->arg_a);
+	buffer->put_u32(p_key->arg_b);
+	write_name(p_key->name);
+}
+
+template <typename T>
+void GDScriptBytecodeCache::Writer::write_function_table(const Vector<T> &p_table, const RBMap<T, FunctionKey> &p_keys) {
+	buffer->put_u32(p_table.size());
+	for (const T &E : p_table) {
+		const typename RBMap<T, FunctionKey>::Element *key = p_keys.find(E);
+		write_key(key ? &key->get() : nullptr);
+	}
+}
+
+void GDScriptBytecodeCache::Writer::write_script_ref(const Script *p_script) {
+	const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+	if (gdscript == nullptr) {
+		if (p_script->get_path().is_empty() || p_script->is_built_in()) {
+			fail(ERR_UNAVAILABLE);
+			return;
+		}
+		buffer->put_u8(false);
+		buffer->put_utf8_string(p_script->get_path());
+		return;
+	}
+
+	const GDScript *gdscript_root = const_cast<GDScript *>(gdscript)->get_root_script();
+	if (gdscript_root->path.is_empty() || gdscript_root->path.contains("::")) {
+		fail(ERR_UNAVAILABLE);
+		return;
+	}
+	buffer->put_u8(true);
+	buffer->put_utf8_string(gdscript_root->path);
+	buffer->put_utf8_string(gdscript->fully_qualified_name);
+}
+
+void GDScriptBytecodeCache::Writer::write_variant(const Variant &p_variant) {
+	switch (p_variant.get_type()) {
+		case Variant::ARRAY: {
+			Array array = p_variant;
+			buffer->put_u8(VARIANT_TAG_ARRAY);
+			buffer->put_u32(array.get_typed_builtin());
+			write_name(array.get_typed_class_name());
+			Ref<Script> typed_script = array.get_typed_script();
+			buffer->put_u8(typed_script.is_valid());
+			if (typed_script.is_valid()) {
+				write_script_ref(typed_script.ptr());
+			}
+			buffer->put_u8(array.is_read_only());
+			buffer->put_u32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				write_variant(array[i]);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dictionary = p_variant;
+			buffer->put_u8(VARIANT_TAG_DICTIONARY);
+			buffer->put_u8(dictionary.is_read_only());
+			buffer->put_u32(dictionary.size());
+			Array dictionary_keys = dictionary.keys();
+			for (int i = 0; i < dictionary_keys.size(); i++) {
+				write_variant(dictionary_keys[i]);
+				write_variant(dictionary[dictionary_keys[i]]);
+			}
+		} break;
+		case Variant::OBJECT: {
+			Object *object = p_variant.get_validated_object();
+			if (object == nullptr) {
+				buffer->put_u8(VARIANT_TAG_NULL_OBJECT);
+			} else if (GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(object)) {
+				buffer->put_u8(VARIANT_TAG_NATIVE_CLASS);
+				write_name(native_class->get_name());
+			} else if (Script *script = Object::cast_to<Script>(object)) {
+				buffer->put_u8(VARIANT_TAG_SCRIPT);
+				write_script_ref(script);
+			} else if (Resource *resource = Object::cast_to<Resource>(object)) {
+				if (resource->get_path().is_empty() || resource->is_built_in()) {
+					fail(ERR_UNAVAILABLE);
+					return;
+				}
+				buffer->put_u8(VARIANT_TAG_RESOURCE);
+				buffer->put_u8(Object::cast_to<PackedScene>(resource) != nullptr);
+				buffer->put_utf8_string(resource->get_path());
+			} else {
+				List<Engine::Singleton> singletons;
+				Engine::get_singleton()->get_singletons(&singletons);
+				for (const Engine::Singleton &E : singletons) {
+					if (E.ptr == object) {
+						buffer->put_u8(VARIANT_TAG_SINGLETON);
+						write_name(E.name);
+						return;
+					}
+				}
+				// Any other object only exists in this editor session.
+				fail(ERR_UNAVAILABLE);
+			}
+		} break;
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			fail(ERR_UNAVAILABLE);
+		} break;
+		default: {
+			buffer->put_u8(VARIANT_TAG_VALUE);
+			buffer->put_var(p_variant);
+		} break;
+	}
+}
+
+void GDScriptBytecodeCache::Writer::write_data_type(const GDScriptDataType &p_type) {
+	buffer->put_u8(p_type.has_type);
+	buffer->put_u8(p_type.kind);
+	buffer->put_u32(p_type.builtin_type);
+	write_name(p_type.native_type);
+	buffer->put_u8(p_type.script_type != nullptr);
+	if (p_type.script_type != nullptr) {
+		write_script_ref(p_type.script_type);
+	}
+	buffer->put_u32(p_type.container_element_types.size());
+	for (const GDScriptDataType &E : p_type.container_element_types) {
+		write_data_type(E);
+	}
+}
+
+void GDScriptBytecodeCache::Writer::write_property_info(const PropertyInfo &p_info) {
+	buffer->put_u32(p_info.type);
+	buffer->put_utf8_string(p_info.name);
+	write_name(p_info.class_name);
+	buffer->put_u32(p_info.hint);
+	buffer->put_utf8_string(p_info.hint_string);
+	buffer->put_u32(p_info.usage);
+}
+
+void GDScriptBytecodeCache::Writer::write_method_info(const MethodInfo &p_info) {
+	buffer->put_utf8_string(p_info.name);
+	write_property_info(p_info.return_val);
+	buffer->put_u32(p_info.flags);
+	buffer->put_32(p_info.id);
+	buffer->put_u32(p_info.arguments.size());
+	for (const PropertyInfo &E : p_info.arguments) {
+		write_property_info(E);
+	}
+	buffer->put_u32(p_info.default_arguments.size());
+	for (const Variant &E : p_info.default_arguments) {
+		write_variant(E);
+	}
+}
+
+void GDScriptBytecodeCache::Writer::write_member_info(const StringName &p_name, const GDScript::MemberInfo &p_info) {
+	write_name(p_name);
+	buffer->put_32(p_info.index);
+	write_name(p_info.setter);
+	write_name(p_info.getter);
+	write_data_type(p_info.data_type);
+	write_property_info(p_info.property_info);
+}
+
+void GDScriptBytecodeCache::Writer::write_function(const GDScriptFunction *p_function) {
+	write_name(p_function->name);
+	buffer->put_u8(p_function->_static);
+	write_variant(p_function->rpc_config);
+	write_data_type(p_function->return_type);
+	buffer->put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &E : p_function->argument_types) {
+		write_data_type(E);
+	}
+	write_method_info(p_function->method_info);
+	buffer->put_32(p_function->_initial_line);
+	buffer->put_32(p_function->_argument_count);
+	buffer->put_32(p_function->_stack_size);
+	buffer->put_32(p_function->_instruction_args_size);
+
+	buffer->put_u32(p_function->default_arguments.size());
+	for (int E : p_function->default_arguments) {
+		buffer->put_32(E);
+	}
+
+	// The original code, not the quickened one, which is only made for this session.
+	buffer->put_u32(p_function->code.size());
+	for (int E : p_function->code) {
+		buffer->put_32(E);
+	}
+
+	buffer->put_u32(p_function->global_positions.size());
+	for (int pos : p_function->global_positions) {
+		const StringName *name = keys->globals.getptr(p_function->code[pos]);
+		if (name == nullptr) {
+			fail(ERR_UNAVAILABLE);
+			return;
+		}
+		buffer->put_u32(pos);
+		write_name(*name);
+	}
+
+	buffer->put_u32(p_function->operator_positions.size());
+	for (int pos : p_function->operator_positions) {
+		buffer->put_u32(pos);
+	}
+
+	buffer->put_u32(p_function->assert_ranges.size() / 2);
+	for (int pos : p_function->assert_ranges) {
+		buffer->put_u32(pos);
+	}
+
+	buffer->put_u32(p_function->constants.size());
+	for (const Variant &E : p_function->constants) {
+		write_variant(E);
+	}
+
+	buffer->put_u32(p_function->global_names.size());
+	for (const StringName &E : p_function->global_names) {
+		write_name(E);
+	}
+
+	buffer->put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		buffer->put_32(E.key);
+		buffer->put_u32(E.value);
+	}
+
+	buffer->put_u32(p_function->stack_debug.size());
+	for (const GDScriptFunction::StackDebug &E : p_function->stack_debug) {
+		buffer->put_32(E.line);
+		buffer->put_32(E.pos);
+		buffer->put_u8(E.added);
+		write_name(E.identifier);
+	}
+
+	// Same order as the reader.
+	write_function_table(p_function->operator_funcs, keys->operators);
+	write_function_table(p_function->setters, keys->setters);
+	write_function_table(p_function->getters, keys->getters);
+	write_function_table(p_function->keyed_setters, keys->keyed_setters);
+	write_function_table(p_function->keyed_getters, keys->keyed_getters);
+	write_function_table(p_function->indexed_setters, keys->indexed_setters);
+	write_function_table(p_function->indexed_getters, keys->indexed_getters);
+	write_function_table(p_function->builtin_methods, keys->builtin_methods);
+	write_function_table(p_function->constructors, keys->constructors);
+	write_function_table(p_function->utilities, keys->utilities);
+	write_function_table(p_function->gds_utilities, keys->gds_utilities);
+
+	buffer->put_u32(p_function->methods.size());
+	for (const MethodBind *E : p_function->methods) {
+		write_name(E->get_instance_class());
+		write_name(E->get_name());
+	}
+
+	buffer->put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *E : p_function->lambdas) {
+		const GDScript::LambdaInfo *info = E->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(E));
+		if (info == nullptr) {
+			fail(ERR_BUG);
+			return;
+		}
+		buffer->put_32(info->capture_count);
+		buffer->put_u8(info->use_self);
+		write_function(E);
+	}
+}
+
+void GDScriptBytecodeCache::Writer::write_class_tree(const GDScript *p_script) {
+	buffer->put_utf8_string(p_script->fully_qualified_name);
+	write_name(p_script->local_name);
+	write_name(p_script->global_name);
+	buffer->put_utf8_string(p_script->simplified_icon_path);
+
+	buffer->put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		write_name(E.key);
+		write_class_tree(E.value.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::Writer::write_class(const GDScript *p_script) {
+	buffer->put_u8(p_script->tool);
+
+	buffer->put_u8(p_script->base.is_valid());
+	if (p_script->base.is_valid()) {
+		write_script_ref(p_script->base.ptr());
+	}
+	write_variant(p_script->native);
+
+	buffer->put_u32(p_script->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+		write_member_info(E.key, E.value);
+	}
+
+	buffer->put_u32(p_script->members.size());
+	for (const StringName &E : p_script->members) {
+		write_name(E);
+	}
+
+	buffer->put_u32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		write_member_info(E.key, E.value);
+	}
+
+	// Inner classes are also constants, the reader adds them back.
+	LocalVector<StringName> constants;
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		const Ref<GDScript> *subclass = p_script->subclasses.getptr(E.key);
+		if (subclass == nullptr || E.value.get_validated_object() != subclass->ptr()) {
+			constants.push_back(E.key);
+		}
+	}
+	buffer->put_u32(constants.size());
+	for (const StringName &E : constants) {
+		write_name(E);
+		write_variant(p_script->constants[E]);
+	}
+
+	buffer->put_u32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		write_name(E.key);
+		write_method_info(E.value);
+	}
+
+	write_variant(p_script->rpc_config);
+
+	LocalVector<Pair<FunctionRole, const GDScriptFunction *>> functions;
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		functions.push_back(Pair<FunctionRole, const GDScriptFunction *>(FUNCTION_ROLE_MEMBER, E.value));
+	}
+	if (p_script->implicit_initializer) {
+		functions.push_back(Pair<FunctionRole, const GDScriptFunction *>(FUNCTION_ROLE_IMPLICIT_INITIALIZER, p_script->implicit_initializer));
+	}
+	if (p_script->implicit_ready) {
+		functions.push_back(Pair<FunctionRole, const GDScriptFunction *>(FUNCTION_ROLE_IMPLICIT_READY, p_script->implicit_ready));
+	}
+	if (p_script->static_initializer) {
+		functions.push_back(Pair<FunctionRole, const GDScriptFunction *>(FUNCTION_ROLE_STATIC_INITIALIZER, p_script->static_initializer));
+	}
+	buffer->put_u32(functions.size());
+	for (const Pair<FunctionRole, const GDScriptFunction *> &E : functions) {
+		buffer->put_u8(E.first);
+		write_function(E.second);
+	}
+
+	buffer->put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		write_name(E.key);
+		write_class(E.value.ptr());
+	}
+}
+
+Error GDScriptBytecodeCache::save_script(const Ref<GDScript> &p_script, Vector<uint8_t> &r_buffer) {
+	ERR_FAIL_COND_V(p_script.is_null(), ERR_INVALID_PARAMETER);
+	if (!p_script->is_valid() || !p_script->is_root_script() || get_cache_path(p_script->path).is_empty()) {
+		return ERR_UNAVAILABLE;
+	}
+
+	FunctionKeys keys;
+	Writer writer;
+	writer.buffer.instantiate();
+	writer.keys = &keys;
+	writer.root = p_script.ptr();
+
+	writer.buffer->put_data((const uint8_t *)"GDBC", 4);
+	writer.buffer->put_u32(FORMAT_VERSION);
+	writer.buffer->put_u32(get_engine_hash());
+	{
+		MutexLock lock(GDScriptCache::singleton->mutex);
+		writer.buffer->put_u8(GDScriptCache::singleton->static_gdscript_cache.has(p_script->fully_qualified_name));
+	}
+	writer.write_class_tree(p_script.ptr());
+	writer.write_class(p_script.ptr());
+
+	if (writer.error != OK) {
+		return writer.error;
+	}
+	r_buffer = writer.buffer->get_data_array();
+	return OK;
+}
+
+#endif // TOOLS_ENABLED
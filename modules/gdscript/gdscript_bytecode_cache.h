@@ -0,0 +1,135 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "gdscript.h"
+
+#include "core/io/stream_peer.h"
+
+// Compiled scripts stored next to their source by the exporter, so exported projects can skip
+// the parser, analyzer, and compiler. The cache is only used when it was written by the exact
+// same engine build, otherwise scripts are compiled from source as usual.
+class GDScriptBytecodeCache {
+	static constexpr uint32_t FORMAT_VERSION = 2;
+
+	enum VariantTag {
+		VARIANT_TAG_VALUE,
+		VARIANT_TAG_ARRAY,
+		VARIANT_TAG_DICTIONARY,
+		VARIANT_TAG_NULL_OBJECT,
+		VARIANT_TAG_NATIVE_CLASS,
+		VARIANT_TAG_SCRIPT,
+		VARIANT_TAG_SINGLETON,
+		VARIANT_TAG_RESOURCE,
+	};
+
+	enum FunctionRole {
+		FUNCTION_ROLE_MEMBER,
+		FUNCTION_ROLE_IMPLICIT_INITIALIZER,
+		FUNCTION_ROLE_IMPLICIT_READY,
+		FUNCTION_ROLE_STATIC_INITIALIZER,
+	};
+
+	struct FunctionKey;
+#ifdef TOOLS_ENABLED
+	struct FunctionKeys;
+#endif
+
+	struct Reader {
+		Ref<StreamPeerBuffer> buffer;
+		GDScript *root = nullptr;
+		Error error = OK;
+
+		uint32_t read_count();
+		StringName read_name();
+		FunctionKey read_key();
+		Variant read_variant();
+		Ref<Script> read_script_ref(bool &r_is_local);
+		GDScriptDataType read_data_type();
+		PropertyInfo read_property_info();
+		MethodInfo read_method_info();
+		GDScriptFunction *read_function(GDScript *p_script);
+		void read_class_tree(GDScript *p_script);
+		void read_class(GDScript *p_script);
+		_FORCE_INLINE_ void fail(Error p_error) {
+			if (error == OK) {
+				error = p_error;
+			}
+		}
+	};
+
+#ifdef TOOLS_ENABLED
+	struct Writer {
+		Ref<StreamPeerBuffer> buffer;
+		const FunctionKeys *keys = nullptr;
+		const GDScript *root = nullptr;
+		Error error = OK;
+
+		void write_name(const StringName &p_name);
+		void write_key(const FunctionKey *p_key);
+		void write_variant(const Variant &p_variant);
+		void write_script_ref(const Script *p_script);
+		void write_data_type(const GDScriptDataType &p_type);
+		void write_property_info(const PropertyInfo &p_info);
+		void write_method_info(const MethodInfo &p_info);
+		void write_member_info(const StringName &p_name, const GDScript::MemberInfo &p_info);
+		template <typename T>
+		void write_function_table(const Vector<T> &p_table, const RBMap<T, FunctionKey> &p_keys);
+		void write_function(const GDScriptFunction *p_function);
+		void write_class_tree(const GDScript *p_script);
+		void write_class(const GDScript *p_script);
+		_FORCE_INLINE_ void fail(Error p_error) {
+			if (error == OK) {
+				error = p_error;
+			}
+		}
+	};
+#endif
+
+	static Error _open(const String &p_script_path, Reader &r_reader);
+	static void _discard(GDScript *p_script);
+
+public:
+	static String get_cache_path(const String &p_script_path);
+	static uint32_t get_engine_hash();
+	static bool is_enabled();
+
+	// Creates the script and its inner classes without any members, like GDScriptCompiler::make_scripts().
+	static Error make_shallow_script(GDScript *p_script);
+	// Fills an empty script with the cached classes and functions.
+	static Error load_script(GDScript *p_script);
+#ifdef TOOLS_ENABLED
+	static Error save_script(const Ref<GDScript> &p_script, Vector<uint8_t> &r_buffer);
+#endif
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
@@ -32,11 +32,15 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
+#include "servers/text_server.h"
 #include "scene/resources/packed_scene.h"
 
 bool GDScriptParserRef::is_valid() const {
@@ -150,6 +154,7 @@ void GDScriptCache::move_script(const String &p_from, const String &p_to) {
 		singleton->parser_map[p_to] = singleton->parser_map[p_from];
 	}
 	singleton->parser_map.erase(p_from);
+	singleton->preparsed.erase(p_from);
 
 	if (singleton->shallow_gdscript_cache.has(p_from) && !p_from.is_empty()) {
 		singleton->shallow_gdscript_cache[p_to] = singleton->shallow_gdscript_cache[p_from];
@@ -186,6 +191,7 @@ void GDScriptCache::remove_script(const String &p_path) {
 		singleton->parser_map[p_path]->clear();
 		singleton->parser_map.erase(p_path);
 	}
+	singleton->preparsed.erase(p_path);
 
 	singleton->dependencies.erase(p_path);
 	singleton->shallow_gdscript_cache.erase(p_path);
@@ -260,6 +266,11 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
+	if (GDScriptBytecodeCache::is_enabled() && GDScriptBytecodeCache::make_shallow_script(script.ptr()) == OK) {
+		singleton->shallow_gdscript_cache[p_path] = script;
+		return script;
+	}
+
 	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
 	if (r_error == OK) {
 		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
@@ -361,6 +372,119 @@ void GDScriptCache::remove_static_script(const String &p_fqcn) {
 	singleton->static_gdscript_cache.erase(p_fqcn);
 }
 
+void GDScriptCache::_parse_script_task(void *p_userdata, uint32_t p_index) {
+	PreparsedScript &script = ((PreparsedScript *)p_userdata)[p_index];
+	GDScriptParserRef *ref = script.parser_ref.ptr();
+
+	script.source = get_source_code(ref->path);
+	ref->status = GDScriptParserRef::PARSED;
+	ref->result = ref->parser->parse(script.source, ref->path, false);
+}
+
+void GDScriptCache::parse_scripts(const Vector<String> &p_paths) {
+	ERR_FAIL_NULL(singleton);
+
+	LocalVector<PreparsedScript> scripts;
+	{
+		MutexLock lock(singleton->mutex);
+		if (singleton->cleared) {
+			return;
+		}
+
+		HashSet<String> seen;
+		for (const String &path : p_paths) {
+			if (path.is_empty() || seen.has(path)) {
+				continue;
+			}
+			seen.insert(path);
+			if (singleton->parser_map.has(path) || singleton->full_gdscript_cache.has(path) || singleton->preparsed.has(path) || !FileAccess::exists(path)) {
+				continue;
+			}
+
+			PreparsedScript script;
+			script.parser_ref.instantiate();
+			script.parser_ref->parser = memnew(GDScriptParser);
+			script.parser_ref->path = path;
+			scripts.push_back(script);
+		}
+	}
+
+	if (scripts.is_empty()) {
+		return;
+	}
+
+	// Parsing only reads thread-safe global state, but a few lookup tables are filled lazily on first use.
+	// Fill them now so the workers don't race on them.
+	GDScriptParser::get_builtin_type(StringName());
+#ifdef DEBUG_ENABLED
+	if (TS.is_valid() && TS->has_feature(TextServer::FEATURE_UNICODE_SECURITY)) {
+		TS->spoof_check(String());
+		TS->is_confusable(String(), PackedStringArray());
+	}
+#endif
+
+	WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&_parse_script_task, scripts.ptr(), scripts.size(), -1, false, "Parse GDScript files");
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+
+	// Trees only become visible to the rest of the cache once complete, so nobody analyzes a half-parsed script.
+	MutexLock lock(singleton->mutex);
+	for (PreparsedScript &script : scripts) {
+		const String path = script.parser_ref->path;
+		if (singleton->cleared || singleton->parser_map.has(path)) {
+			// Someone else parsed it in the meantime, keep theirs.
+			script.parser_ref->path = String();
+			continue;
+		}
+		singleton->parser_map[path] = script.parser_ref.ptr();
+		singleton->preparsed[path] = script;
+	}
+}
+
+Ref<GDScriptParserRef> GDScriptCache::take_preparsed(const String &p_path, const String &p_source) {
+	if (singleton == nullptr || p_path.is_empty()) {
+		return Ref<GDScriptParserRef>();
+	}
+
+	MutexLock lock(singleton->mutex);
+
+	HashMap<String, PreparsedScript>::Iterator E = singleton->preparsed.find(p_path);
+	if (!E) {
+		return Ref<GDScriptParserRef>();
+	}
+
+	Ref<GDScriptParserRef> ref = E->value.parser_ref;
+	// The tree can only be handed over if nobody else is using or analyzing it, and if it matches the source being reloaded.
+	bool usable = ref->status == GDScriptParserRef::PARSED && ref->result == OK && ref->get_reference_count() == 2 && E->value.source == p_source;
+	singleton->preparsed.remove(E);
+	if (!usable) {
+		return Ref<GDScriptParserRef>();
+	}
+
+	if (singleton->parser_map.has(p_path) && singleton->parser_map[p_path] == ref.ptr()) {
+		singleton->parser_map.erase(p_path);
+	}
+	ref->path = String();
+	return ref;
+}
+
+void GDScriptCache::discard_preparsed() {
+	if (singleton == nullptr) {
+		return;
+	}
+
+	LocalVector<Ref<GDScriptParserRef>> unclaimed;
+	{
+		MutexLock lock(singleton->mutex);
+		for (KeyValue<String, PreparsedScript> &E : singleton->preparsed) {
+			unclaimed.push_back(E.value.parser_ref);
+		}
+		singleton->preparsed.clear();
+	}
+	// Trees nobody else uses are freed here, outside of the lock, which also removes them from the parser map.
+	// The ones held by an analyzer stay in the parser map like any other tree.
+	unclaimed.clear();
+}
+
 Ref<PackedScene> GDScriptCache::get_packed_scene(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
@@ -444,6 +568,7 @@ void GDScriptCache::clear() {
 
 	parser_map_refs.clear();
 	singleton->parser_map.clear();
+	singleton->preparsed.clear();
 	singleton->shallow_gdscript_cache.clear();
 	singleton->full_gdscript_cache.clear();
 
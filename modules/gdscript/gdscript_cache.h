@@ -84,7 +84,16 @@ class GDScriptCache {
 	HashMap<String, Ref<PackedScene>> packed_scene_cache;
 	HashMap<String, HashSet<String>> packed_scene_dependencies;
 
+	struct PreparsedScript {
+		Ref<GDScriptParserRef> parser_ref;
+		String source;
+	};
+	// Trees made ahead of time by parse_scripts(), waiting for their script to be reloaded.
+	// The editor drops the unclaimed ones with discard_preparsed() after loading the project.
+	HashMap<String, PreparsedScript> preparsed;
+
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 
@@ -94,6 +103,8 @@ class GDScriptCache {
 
 	Mutex mutex;
 
+	static void _parse_script_task(void *p_userdata, uint32_t p_index);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
@@ -106,6 +117,10 @@ public:
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
 
+	static void parse_scripts(const Vector<String> &p_paths);
+	static Ref<GDScriptParserRef> take_preparsed(const String &p_path, const String &p_source);
+	static void discard_preparsed();
+
 	static Ref<PackedScene> get_packed_scene(const String &p_path, Error &r_error, const String &p_owner = "");
 	static void clear_unreferenced_packed_scenes();
 
@@ -249,6 +249,24 @@ static bool _can_use_validate_call(const MethodBind *p_method, const Vector<GDSc
 	return true;
 }
 
+// A local initialized with a lambda that is only ever called, in the function that declares it, never lets the lambda escape.
+// Such lambdas are called directly and don't need a Callable at all.
+static bool _is_direct_lambda(const GDScriptParser::VariableNode *p_variable) {
+	if (p_variable->initializer == nullptr || p_variable->initializer->type != GDScriptParser::Node::LAMBDA) {
+		return false;
+	}
+	const GDScriptParser::LambdaNode *lambda = static_cast<const GDScriptParser::LambdaNode *>(p_variable->initializer);
+	if (lambda->function == nullptr || lambda->function->is_coroutine || !lambda->captures.is_empty()) {
+		// Captures are bound when the lambda is created, so they can't be read at the call instead.
+		return false;
+	}
+	if (p_variable->reassigned || p_variable->direct_call_usages == 0 || p_variable->usages != p_variable->direct_call_usages) {
+		return false;
+	}
+	// Keep the Callable around so it shows up in the debugger.
+	return !EngineDebugger::is_active();
+}
+
 GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root, bool p_initializer, const GDScriptCodeGenerator::Address &p_index_addr) {
 	if (p_expression->is_constant && !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS)) {
 		return codegen.add_constant(p_expression->reduced_value);
@@ -673,6 +691,12 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 									ClassDB::class_exists(static_cast<GDScriptParser::IdentifierNode *>(subscript->base)->name) && !Engine::get_singleton()->has_singleton(static_cast<GDScriptParser::IdentifierNode *>(subscript->base)->name)) {
 								// It's a static native method call.
 								gen->write_call_native_static(result, static_cast<GDScriptParser::IdentifierNode *>(subscript->base)->name, subscript->attribute->name, arguments);
+							} else if (!call->is_super && subscript->base->type == GDScriptParser::Node::IDENTIFIER && static_cast<GDScriptParser::IdentifierNode *>(subscript->base)->source == GDScriptParser::IdentifierNode::LOCAL_VARIABLE &&
+									call->function_name == SNAME("call") && codegen.direct_lambdas.has(static_cast<GDScriptParser::IdentifierNode *>(subscript->base)->variable_source)) {
+								// Lambda that never escaped, call it directly.
+								const GDScriptParser::VariableNode *variable = static_cast<GDScriptParser::IdentifierNode *>(subscript->base)->variable_source;
+								const GDScriptParser::LambdaNode *lambda = static_cast<const GDScriptParser::LambdaNode *>(variable->initializer);
+								gen->write_call_lambda(result, codegen.direct_lambdas[variable], arguments, lambda->use_self);
 							} else {
 								GDScriptCodeGenerator::Address base = _parse_expression(codegen, r_error, subscript->base);
 								if (r_error) {
@@ -2086,6 +2110,7 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 #ifdef DEBUG_ENABLED
 				const GDScriptParser::AssertNode *as = static_cast<const GDScriptParser::AssertNode *>(s);
 
+				gen->start_assert();
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, as->condition);
 				if (err) {
 					return err;
@@ -2121,7 +2146,17 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 				GDScriptDataType local_type = _gdtype_from_datatype(lv->get_datatype(), codegen.script);
 
 				bool initialized = false;
-				if (lv->initializer != nullptr) {
+				if (_is_direct_lambda(lv)) {
+					// Only compile the lambda, calls go straight to it and the local is never read.
+					const GDScriptParser::LambdaNode *lambda = static_cast<const GDScriptParser::LambdaNode *>(lv->initializer);
+					GDScriptFunction *function = _parse_function(err, codegen.script, codegen.class_node, lambda->function, false, true);
+					if (err) {
+						return err;
+					}
+					codegen.script->lambda_info.insert(function, { 0, lambda->use_self });
+					codegen.direct_lambdas[lv] = function;
+					initialized = true;
+				} else if (lv->initializer != nullptr) {
 					GDScriptCodeGenerator::Address src_address = _parse_expression(codegen, err, lv->initializer);
 					if (err) {
 						return err;
@@ -81,6 +81,7 @@ class GDScriptCompiler {
 		HashMap<StringName, GDScriptCodeGenerator::Address> parameters;
 		HashMap<StringName, GDScriptCodeGenerator::Address> locals;
 		List<HashMap<StringName, GDScriptCodeGenerator::Address>> locals_stack;
+		HashMap<const GDScriptParser::VariableNode *, GDScriptFunction *> direct_lambdas;
 		bool is_static = false;
 
 		GDScriptCodeGenerator::Address add_local(const StringName &p_name, const GDScriptDataType &p_type) {
@@ -35,6 +35,19 @@
 
 #include "core/string/string_builder.h"
 
+static const char *_quick_operator_names[GDScriptFunction::QUICK_MAX] = {
+	"+",
+	"-",
+	"*",
+	"/",
+	"==",
+	"!=",
+	"<",
+	"<=",
+	">",
+	">=",
+};
+
 static String _get_variant_string(const Variant &p_variant) {
 	String txt;
 	if (p_variant.get_type() == Variant::STRING) {
@@ -141,6 +154,43 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				text += "validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += ", jump-if-not to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr += 6;
+			} break;
+			case OPCODE_OPERATOR_INT:
+			case OPCODE_OPERATOR_FLOAT:
+			case OPCODE_OPERATOR_INT_JUMP_IF_NOT:
+			case OPCODE_OPERATOR_FLOAT_JUMP_IF_NOT: {
+				const bool is_int = _code_ptr[ip] == OPCODE_OPERATOR_INT || _code_ptr[ip] == OPCODE_OPERATOR_INT_JUMP_IF_NOT;
+				text += is_int ? "int operator " : "float operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += _quick_operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+
+				incr += 5;
+				if (_code_ptr[ip] == OPCODE_OPERATOR_INT_JUMP_IF_NOT || _code_ptr[ip] == OPCODE_OPERATOR_FLOAT_JUMP_IF_NOT) {
+					text += ", jump-if-not to ";
+					text += itos(_code_ptr[ip + 5]);
+					incr += 1;
+				}
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -872,6 +922,27 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 4 + captures_count;
 			} break;
+			case OPCODE_CALL_LAMBDA:
+			case OPCODE_CALL_SELF_LAMBDA: {
+				int instr_var_args = _code_ptr[++ip];
+				int argc = _code_ptr[ip + 1 + instr_var_args];
+				GDScriptFunction *lambda = _lambdas_ptr[_code_ptr[ip + 2 + instr_var_args]];
+
+				text += opcode == OPCODE_CALL_SELF_LAMBDA ? "call self lambda " : "call lambda ";
+				text += DADDR(1 + argc) + " = ";
+				text += lambda->name.operator String();
+				text += "(";
+
+				for (int i = 0; i < argc; i++) {
+					if (i > 0) {
+						text += ", ";
+					}
+					text += DADDR(1 + i);
+				}
+				text += ")";
+
+				incr = 4 + argc;
+			} break;
 			case OPCODE_JUMP: {
 				text += "jump ";
 				text += itos(_code_ptr[ip + 1]);
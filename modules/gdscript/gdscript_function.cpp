@@ -32,6 +32,8 @@
 
 #include "gdscript.h"
 
+uint32_t GDScriptFunction::tier_up_call_count = 1000;
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -104,6 +106,76 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+void GDScriptFunction::_tier_up() {
+	bool expected = false;
+	if (!tier_up_started.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+		return; // Another call is tiering up.
+	}
+
+	static const Variant::Operator quick_operators[QUICK_MAX] = {
+		Variant::OP_ADD,
+		Variant::OP_SUBTRACT,
+		Variant::OP_MULTIPLY,
+		Variant::OP_DIVIDE,
+		Variant::OP_EQUAL,
+		Variant::OP_NOT_EQUAL,
+		Variant::OP_LESS,
+		Variant::OP_LESS_EQUAL,
+		Variant::OP_GREATER,
+		Variant::OP_GREATER_EQUAL,
+	};
+
+	quickened_code = code;
+	int *quickened = quickened_code.ptrw();
+	int quickened_count = 0;
+
+	for (const int &pos : operator_positions) {
+		const int opcode = quickened[pos];
+		if (opcode != OPCODE_OPERATOR_VALIDATED && opcode != OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+			continue;
+		}
+		const Variant::ValidatedOperatorEvaluator evaluator = _operator_funcs_ptr[quickened[pos + 4]];
+		const bool jump = opcode == OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+
+		for (int i = 0; i < QUICK_MAX; i++) {
+			if (jump && i < QUICK_EQUAL) {
+				continue; // Only comparisons are fused with jumps.
+			}
+			if (i != QUICK_DIVIDE && evaluator == Variant::get_validated_operator_evaluator(quick_operators[i], Variant::INT, Variant::INT)) {
+				quickened[pos] = jump ? OPCODE_OPERATOR_INT_JUMP_IF_NOT : OPCODE_OPERATOR_INT;
+			} else if (evaluator == Variant::get_validated_operator_evaluator(quick_operators[i], Variant::FLOAT, Variant::FLOAT)) {
+				quickened[pos] = jump ? OPCODE_OPERATOR_FLOAT_JUMP_IF_NOT : OPCODE_OPERATOR_FLOAT;
+			} else {
+				continue;
+			}
+			quickened[pos + 4] = i;
+			quickened_count++;
+			break;
+		}
+	}
+
+	if (quickened_count == 0) {
+		quickened_code.clear();
+	} else {
+		quickened_code_ptr.store(quickened, std::memory_order_release);
+	}
+	tiered_up.set();
+}
+
+void GDScriptFunction::_update_typed_stack() {
+	_typed_stack_start = _stack_size;
+	for (const KeyValue<int, Variant::Type> &E : temporary_slots) {
+		_typed_stack_start = MIN(_typed_stack_start, E.key);
+	}
+
+	typed_stack_types.resize(_stack_size - _typed_stack_start);
+	for (int i = _typed_stack_start; i < _stack_size; i++) {
+		// Untyped slots in between, if any, are constructed as null.
+		const Variant::Type *type = temporary_slots.getptr(i);
+		typed_stack_types.write[i - _typed_stack_start] = type ? *type : Variant::NIL;
+	}
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -126,6 +198,17 @@ GDScriptFunction::~GDScriptFunction() {
 	}
 	return_type.script_type_ref = Ref<Script>();
 
+	std::atomic<InlineCacheSite *> *sites = inline_cache_sites.load(std::memory_order_acquire);
+	if (sites) {
+		for (int i = 0; i < _global_names_count * INLINE_CACHE_OP_MAX; i++) {
+			InlineCacheSite *site = sites[i].load(std::memory_order_relaxed);
+			if (site) {
+				memdelete(site);
+			}
+		}
+		memdelete_arr(sites);
+	}
+
 #ifdef DEBUG_ENABLED
 	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 	GDScriptLanguage::get_singleton()->function_list.remove(&function_list);
@@ -38,9 +38,12 @@
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
 
@@ -199,6 +202,11 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, // Superinstruction: validated operator, then jump if its result is false.
+		OPCODE_OPERATOR_INT, // Only in quickened code, see _tier_up().
+		OPCODE_OPERATOR_FLOAT,
+		OPCODE_OPERATOR_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_FLOAT_JUMP_IF_NOT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_NATIVE,
@@ -250,6 +258,8 @@ public:
 		OPCODE_AWAIT_RESUME,
 		OPCODE_CREATE_LAMBDA,
 		OPCODE_CREATE_SELF_LAMBDA,
+		OPCODE_CALL_LAMBDA,
+		OPCODE_CALL_SELF_LAMBDA,
 		OPCODE_JUMP,
 		OPCODE_JUMP_IF,
 		OPCODE_JUMP_IF_NOT,
@@ -345,6 +355,21 @@ public:
 		OPCODE_END
 	};
 
+	// Operators evaluated inline by the quickened opcodes, in place of the operator function index.
+	enum QuickOperator {
+		QUICK_ADD,
+		QUICK_SUBTRACT,
+		QUICK_MULTIPLY,
+		QUICK_DIVIDE, // Float only, integer division has to check for zero.
+		QUICK_EQUAL,
+		QUICK_NOT_EQUAL,
+		QUICK_LESS,
+		QUICK_LESS_EQUAL,
+		QUICK_GREATER,
+		QUICK_GREATER_EQUAL,
+		QUICK_MAX,
+	};
+
 	enum Address {
 		ADDR_BITS = 24,
 		ADDR_MASK = ((1 << ADDR_BITS) - 1),
@@ -376,6 +401,7 @@ private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptLanguage;
 
 	StringName name;
@@ -397,6 +423,13 @@ private:
 	HashMap<int, Variant::Type> temporary_slots;
 	List<StackDebug> stack_debug;
 
+	// The code generator puts typed temporaries at the end of the stack, so a call can initialize them
+	// straight to their type from this flat list, instead of constructing them as null first.
+	Vector<Variant::Type> typed_stack_types;
+	int _typed_stack_start = 0;
+
+	void _update_typed_stack();
+
 	Vector<int> code;
 	Vector<int> default_arguments;
 	Vector<Variant> constants;
@@ -451,6 +484,92 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// Indices into the global array differ between builds, so the bytecode cache remaps them.
+	Vector<int> global_positions; // Of all global array indices in the code.
+#ifdef DEBUG_ENABLED
+	// Pairs of the start and end of the code of each assertion, including its condition and message.
+	// Release builds don't evaluate assertions, so the cache loader jumps over them there.
+	Vector<int> assert_ranges;
+#endif
+
+	// Second tier. After tier_up_call_count calls, the validated integer and float operators are
+	// replaced by opcodes that evaluate them inline, in a copy of the code which then gets executed.
+	Vector<int> operator_positions; // Of all validated operators, filled by the code generator.
+	// Only the call that claims tier_up_started builds the quickened code, and publishes it through
+	// quickened_code_ptr with release. Calls load the code pointer once, so a call that started in
+	// the original code keeps running it, which is fine as both have the same layout.
+	Vector<int> quickened_code;
+	std::atomic<int *> quickened_code_ptr = { nullptr };
+	std::atomic<uint32_t> call_count_to_tier_up = { 0 }; // Relaxed, it only decides when to tier up.
+	std::atomic<bool> tier_up_started = { false };
+	SafeFlag tiered_up;
+
+	void _tier_up();
+	_FORCE_INLINE_ int *_get_code_ptr() const {
+		int *quickened = quickened_code_ptr.load(std::memory_order_acquire);
+		return quickened ? quickened : _code_ptr;
+	}
+
+	// Inline caches of the untyped named get, set and call instructions on objects. There is a site
+	// for each name used by each of these instructions, allocated when first executed. It remembers
+	// how the name resolved for the last INLINE_CACHE_ENTRIES object classes and scripts, until a
+	// script is reloaded or freed, or classes are registered.
+	enum InlineCacheOp {
+		INLINE_CACHE_GET,
+		INLINE_CACHE_SET,
+		INLINE_CACHE_CALL,
+		INLINE_CACHE_OP_MAX,
+	};
+
+	enum InlineCacheKind {
+		INLINE_CACHE_UNCACHED, // Takes the generic path, like getters or names a script can intercept.
+		INLINE_CACHE_SCRIPT_MEMBER, // Target is the GDScript::MemberInfo.
+		INLINE_CACHE_SCRIPT_FUNCTION, // Target is the GDScriptFunction.
+		INLINE_CACHE_NATIVE_PROPERTY, // Target is the setter or getter MethodBind, index the property index.
+		INLINE_CACHE_NATIVE_METHOD, // Target is the MethodBind.
+	};
+
+	enum {
+		INLINE_CACHE_ENTRIES = 4,
+		INLINE_CACHE_MAX_MISSES = 64, // Sites evicting this many live entries become megamorphic.
+	};
+
+	// The same function can run on several threads, so entries are written under a sequence lock.
+	// Readers that see a write in progress take the generic path instead of waiting.
+	struct InlineCacheEntry {
+		std::atomic<uint32_t> sequence = { 0 }; // Odd while being written.
+		std::atomic<const void *> class_name = { nullptr }; // StringName::data_unique_pointer().
+		std::atomic<const GDScript *> script = { nullptr };
+		std::atomic<uint32_t> script_generation = { 0 };
+		std::atomic<uint32_t> class_generation = { 0 };
+		std::atomic<int> kind = { INLINE_CACHE_UNCACHED };
+		std::atomic<void *> target = { nullptr };
+		std::atomic<int> index = { 0 };
+	};
+
+	struct InlineCacheSite {
+		InlineCacheEntry entries[INLINE_CACHE_ENTRIES];
+		std::atomic<uint32_t> next_entry = { 0 };
+		std::atomic<uint32_t> misses = { 0 };
+	};
+
+	struct InlineCacheHit {
+		InlineCacheKind kind = INLINE_CACHE_UNCACHED;
+		void *target = nullptr;
+		int index = 0;
+	};
+
+	std::atomic<std::atomic<InlineCacheSite *> *> inline_cache_sites = { nullptr }; // _global_names_count * INLINE_CACHE_OP_MAX.
+
+	InlineCacheSite *_get_inline_cache_site(int p_name, InlineCacheOp p_op);
+	InlineCacheHit _resolve_inline_cache(const StringName &p_name, InlineCacheOp p_op, Object *p_object, GDScriptInstance *p_instance) const;
+	bool _inline_cache_lookup(int p_name, InlineCacheOp p_op, Object *p_object, GDScriptInstance *p_instance, InlineCacheHit &r_hit);
+	// These return false when the generic path should handle the access instead. Once they have
+	// called the member, they return true and report its failure in r_valid or r_err.
+	bool _inline_get(int p_name, const Variant *p_base, Variant &r_ret, bool &r_valid);
+	bool _inline_set(int p_name, const Variant *p_base, const Variant *p_value, bool &r_valid);
+	bool _inline_call(int p_name, const Variant *p_base, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -489,6 +608,7 @@ private:
 
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
+	static uint32_t tier_up_call_count; // Zero disables the second tier.
 
 	struct CallState {
 		GDScript *script = nullptr;
@@ -513,6 +633,7 @@ public:
 	_FORCE_INLINE_ MethodInfo get_method_info() const { return method_info; }
 	_FORCE_INLINE_ Variant get_rpc_config() const { return rpc_config; }
 	_FORCE_INLINE_ int get_max_stack_size() const { return _stack_size; }
+	_FORCE_INLINE_ bool is_tiered_up() const { return tiered_up.is_set(); }
 
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
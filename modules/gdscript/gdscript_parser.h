@@ -1252,6 +1252,9 @@ public:
 		PropertyInfo export_info;
 		int assignments = 0;
 		bool is_static = false;
+		// Set by the analyzer for locals. A lambda initializer doesn't escape when every use is a `.call()` in the same function.
+		int direct_call_usages = 0;
+		bool reassigned = false;
 #ifdef TOOLS_ENABLED
 		MemberDocData doc_data;
 #endif // TOOLS_ENABLED
@@ -0,0 +1,212 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "gdscript.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+thread_local GDScriptSamplingProfiler::ThreadState GDScriptSamplingProfiler::thread_state;
+
+SafeFlag GDScriptSamplingProfiler::active;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::tick;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::session;
+uint32_t GDScriptSamplingProfiler::interval_usec = GDScriptSamplingProfiler::DEFAULT_INTERVAL_USEC;
+Thread GDScriptSamplingProfiler::sampler_thread;
+
+Mutex GDScriptSamplingProfiler::mutex;
+HashMap<String, uint64_t> GDScriptSamplingProfiler::stacks;
+uint64_t GDScriptSamplingProfiler::sample_count = 0;
+String GDScriptSamplingProfiler::output_path;
+
+void GDScriptSamplingProfiler::_sampler_thread_func(void *p_userdata) {
+	while (active.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		tick.increment();
+	}
+}
+
+void GDScriptSamplingProfiler::_record(uint32_t p_ticks, const StringName &p_native_class, const StringName &p_native_method) {
+	const Thread::ID thread_id = Thread::get_caller_id();
+	String stack = thread_id == Thread::get_main_id() ? String("Main Thread") : "Thread " + itos(thread_id);
+	for (const GDScriptFunction *function : thread_state.frames) {
+		stack += ";" + function->get_script()->get_script_path() + ":" + function->get_name();
+	}
+	if (p_native_method != StringName()) {
+		stack += ";" + (p_native_class == StringName() ? String(p_native_method) : String(p_native_class) + "." + p_native_method);
+	}
+
+	MutexLock lock(mutex);
+	HashMap<String, uint64_t>::Iterator E = stacks.find(stack);
+	if (E) {
+		E->value += p_ticks;
+	} else {
+		stacks.insert(stack, p_ticks);
+	}
+	sample_count += p_ticks;
+}
+
+void GDScriptSamplingProfiler::_poll(const StringName &p_native_class, const StringName &p_native_method) {
+	ThreadState &state = thread_state;
+	const uint32_t current_tick = tick.get();
+	const uint32_t current_session = session.get();
+
+	// Ticks from before this thread entered a function, or from another session, weren't spent here.
+	if (state.session == current_session && !state.frames.is_empty() && active.is_set()) {
+		_record(current_tick - state.last_tick, p_native_class, p_native_method);
+	}
+	state.session = current_session;
+	state.last_tick = current_tick;
+}
+
+void GDScriptSamplingProfiler::_debugger_toggle(void *p_user, bool p_enable, const Array &p_opts) {
+	if (p_enable) {
+		clear();
+		start(p_opts.size() > 0 ? uint32_t(MAX(int(p_opts[0]), 1)) : DEFAULT_INTERVAL_USEC);
+		return;
+	}
+
+	stop();
+	if (EngineDebugger::get_singleton()) {
+		Array data;
+		data.push_back(get_folded_stacks());
+		data.push_back(get_sample_count());
+		data.push_back(interval_usec);
+		EngineDebugger::get_singleton()->send_message("gdscript_sampler:folded", data);
+	}
+}
+
+void GDScriptSamplingProfiler::start(uint32_t p_interval_usec) {
+	ERR_FAIL_COND_MSG(p_interval_usec == 0, "The sampling interval must be greater than zero.");
+	if (active.is_set()) {
+		return;
+	}
+
+	interval_usec = p_interval_usec;
+	session.increment();
+	active.set();
+
+	Thread::Settings settings;
+	settings.priority = Thread::PRIORITY_HIGH;
+	sampler_thread.start(_sampler_thread_func, nullptr, settings);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!active.is_set()) {
+		return;
+	}
+	active.clear();
+	sampler_thread.wait_to_finish();
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	stacks.clear();
+	sample_count = 0;
+}
+
+void GDScriptSamplingProfiler::enter_function(const GDScriptFunction *p_function) {
+	poll();
+	thread_state.frames.push_back(p_function);
+}
+
+void GDScriptSamplingProfiler::exit_function() {
+	poll();
+	ERR_FAIL_COND(thread_state.frames.is_empty());
+	thread_state.frames.resize(thread_state.frames.size() - 1);
+}
+
+uint64_t GDScriptSamplingProfiler::get_sample_count() {
+	MutexLock lock(mutex);
+	return sample_count;
+}
+
+String GDScriptSamplingProfiler::get_folded_stacks() {
+	Vector<String> lines;
+	{
+		MutexLock lock(mutex);
+		lines.resize(stacks.size());
+		int i = 0;
+		for (const KeyValue<String, uint64_t> &E : stacks) {
+			lines.write[i++] = E.key + " " + itos(E.value);
+		}
+	}
+	lines.sort();
+
+	String folded;
+	for (const String &line : lines) {
+		folded += line + "\n";
+	}
+	return folded;
+}
+
+void GDScriptSamplingProfiler::initialize() {
+	EngineDebugger::register_profiler("gdscript_sampler", EngineDebugger::Profiler(nullptr, _debugger_toggle, nullptr, nullptr));
+
+	uint32_t interval = DEFAULT_INTERVAL_USEC;
+	List<String> cmdline_args = OS::get_singleton()->get_cmdline_args();
+	for (List<String>::Element *E = cmdline_args.front(); E; E = E->next()) {
+		if (!E->next()) {
+			break;
+		}
+		if (E->get() == "--gdscript-sampling-profile") {
+			output_path = E->next()->get();
+		} else if (E->get() == "--gdscript-sampling-interval") {
+			interval = MAX(E->next()->get().to_int(), 1);
+		}
+	}
+
+	if (!output_path.is_empty()) {
+		start(interval);
+	}
+}
+
+void GDScriptSamplingProfiler::finish() {
+	if (EngineDebugger::has_profiler("gdscript_sampler")) {
+		EngineDebugger::unregister_profiler("gdscript_sampler");
+	}
+	stop();
+
+	if (!output_path.is_empty()) {
+		Ref<FileAccess> file = FileAccess::open(output_path, FileAccess::WRITE);
+		ERR_FAIL_COND_MSG(file.is_null(), "Cannot write the GDScript sampling profile to: " + output_path);
+		file->store_string(get_folded_stacks());
+		print_line(vformat("GDScript sampling profile with %d samples written to: %s", get_sample_count(), output_path));
+		output_path = String();
+	}
+	clear();
+}
+
+#endif // DEBUG_ENABLED
@@ -0,0 +1,115 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#ifdef DEBUG_ENABLED
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptFunction;
+
+// Samples the GDScript call stacks of all threads running scripts, with much less overhead than
+// the instrumenting profiler of GDScriptLanguage. A sampler thread advances a tick at a fixed
+// interval, and threads check for new ticks when entering and leaving functions, on each line,
+// and around native calls. The ticks a thread missed are counted for its current stack, so time
+// spent in native code goes to that native method.
+//
+// The stacks are aggregated in the folded format of flame graph tools, one "frame;frame;... count"
+// line per stack, with the thread as the root frame. They are sent to the debugger when the
+// "gdscript_sampler" profiler is stopped, and can be written to a file when running headless with
+// the --gdscript-sampling-profile <file> command line argument.
+class GDScriptSamplingProfiler {
+	struct ThreadState {
+		LocalVector<const GDScriptFunction *> frames;
+		uint32_t last_tick = 0;
+		uint32_t session = 0;
+	};
+
+	static thread_local ThreadState thread_state;
+
+	static SafeFlag active;
+	static SafeNumeric<uint32_t> tick;
+	static SafeNumeric<uint32_t> session;
+	static uint32_t interval_usec;
+	static Thread sampler_thread;
+
+	static Mutex mutex;
+	static HashMap<String, uint64_t> stacks;
+	static uint64_t sample_count;
+	static String output_path;
+
+	static void _sampler_thread_func(void *p_userdata);
+	static void _record(uint32_t p_ticks, const StringName &p_native_class, const StringName &p_native_method);
+	static void _poll(const StringName &p_native_class, const StringName &p_native_method);
+
+	static void _debugger_toggle(void *p_user, bool p_enable, const Array &p_opts);
+
+public:
+	static constexpr uint32_t DEFAULT_INTERVAL_USEC = 1000;
+
+	_FORCE_INLINE_ static bool is_active() { return active.is_set(); }
+
+	static void start(uint32_t p_interval_usec = DEFAULT_INTERVAL_USEC);
+	static void stop();
+	static void clear();
+
+	static void enter_function(const GDScriptFunction *p_function);
+	static void exit_function();
+
+	_FORCE_INLINE_ static void poll() {
+		if (unlikely(tick.get() != thread_state.last_tick)) {
+			_poll(StringName(), StringName());
+		}
+	}
+
+	// After a native call, so the ticks spent in it are counted for the method.
+	_FORCE_INLINE_ static void poll_native(const StringName &p_class, const StringName &p_method) {
+		if (unlikely(tick.get() != thread_state.last_tick)) {
+			_poll(p_class, p_method);
+		}
+	}
+
+	static uint64_t get_sample_count();
+	static String get_folded_stacks();
+
+	static void initialize(); // Registers the debugger profiler, and handles the command line.
+	static void finish();
+};
+
+#endif // DEBUG_ENABLED
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
@@ -31,7 +31,9 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampling_profiler.h"
 
+#include "core/config/engine.h"
 #include "core/core_string_names.h"
 #include "core/os/os.h"
 
@@ -215,6 +217,11 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {          \
 		&&OPCODE_OPERATOR,                             \
 		&&OPCODE_OPERATOR_VALIDATED,                   \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,       \
+		&&OPCODE_OPERATOR_INT,                         \
+		&&OPCODE_OPERATOR_FLOAT,                       \
+		&&OPCODE_OPERATOR_INT_JUMP_IF_NOT,             \
+		&&OPCODE_OPERATOR_FLOAT_JUMP_IF_NOT,           \
 		&&OPCODE_TYPE_TEST_BUILTIN,                    \
 		&&OPCODE_TYPE_TEST_ARRAY,                      \
 		&&OPCODE_TYPE_TEST_NATIVE,                     \
@@ -266,6 +273,8 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_AWAIT_RESUME,                         \
 		&&OPCODE_CREATE_LAMBDA,                        \
 		&&OPCODE_CREATE_SELF_LAMBDA,                   \
+		&&OPCODE_CALL_LAMBDA,                          \
+		&&OPCODE_CALL_SELF_LAMBDA,                     \
 		&&OPCODE_JUMP,                                 \
 		&&OPCODE_JUMP_IF,                              \
 		&&OPCODE_JUMP_IF_NOT,                          \
@@ -372,10 +381,10 @@ void (*type_init_function_table[])(Variant *) = {
 #define OPCODE_SWITCH(m_test) goto *switch_table_ops[m_test];
 #ifdef DEBUG_ENABLED
 #define DISPATCH_OPCODE          \
-	last_opcode = _code_ptr[ip]; \
+	last_opcode = exec_code[ip]; \
 	goto *switch_table_ops[last_opcode]
 #else
-#define DISPATCH_OPCODE goto *switch_table_ops[_code_ptr[ip]]
+#define DISPATCH_OPCODE goto *switch_table_ops[exec_code[ip]]
 #endif
 #define OPCODE_BREAK goto OPSEXIT
 #define OPCODE_OUT goto OPSOUT
@@ -436,6 +445,322 @@ void (*type_init_function_table[])(Variant *) = {
 #define OP_GET_RID get_rid
 
 #define METHOD_CALL_ON_NULL_VALUE_ERROR(method_pointer) "Cannot call method '" + (method_pointer)->get_name() + "' on a null value."
+// Evaluates the operators of the quickened opcodes. The operands have the type T, as the code
+// generator only emitted validated operators for them.
+template <typename T>
+static _FORCE_INLINE_ void _evaluate_quick_operator(int p_operator, const Variant *p_a, const Variant *p_b, Variant *r_dst) {
+	const T a = *VariantGetInternalPtr<T>::get_ptr(p_a);
+	const T b = *VariantGetInternalPtr<T>::get_ptr(p_b);
+	T *dst = VariantGetInternalPtr<T>::get_ptr(r_dst);
+	switch (p_operator) {
+		case GDScriptFunction::QUICK_ADD:
+			*dst = a + b;
+			break;
+		case GDScriptFunction::QUICK_SUBTRACT:
+			*dst = a - b;
+			break;
+		case GDScriptFunction::QUICK_MULTIPLY:
+			*dst = a * b;
+			break;
+		case GDScriptFunction::QUICK_DIVIDE:
+			*dst = a / b;
+			break;
+		case GDScriptFunction::QUICK_EQUAL:
+			*VariantInternal::get_bool(r_dst) = a == b;
+			break;
+		case GDScriptFunction::QUICK_NOT_EQUAL:
+			*VariantInternal::get_bool(r_dst) = a != b;
+			break;
+		case GDScriptFunction::QUICK_LESS:
+			*VariantInternal::get_bool(r_dst) = a < b;
+			break;
+		case GDScriptFunction::QUICK_LESS_EQUAL:
+			*VariantInternal::get_bool(r_dst) = a <= b;
+			break;
+		case GDScriptFunction::QUICK_GREATER:
+			*VariantInternal::get_bool(r_dst) = a > b;
+			break;
+		case GDScriptFunction::QUICK_GREATER_EQUAL:
+			*VariantInternal::get_bool(r_dst) = a >= b;
+			break;
+	}
+}
+
+GDScriptFunction::InlineCacheSite *GDScriptFunction::_get_inline_cache_site(int p_name, InlineCacheOp p_op) {
+	std::atomic<InlineCacheSite *> *sites = inline_cache_sites.load(std::memory_order_acquire);
+	if (unlikely(!sites)) {
+		const int count = _global_names_count * INLINE_CACHE_OP_MAX;
+		std::atomic<InlineCacheSite *> *new_sites = memnew_arr(std::atomic<InlineCacheSite *>, count);
+		for (int i = 0; i < count; i++) {
+			new_sites[i].store(nullptr, std::memory_order_relaxed);
+		}
+		if (inline_cache_sites.compare_exchange_strong(sites, new_sites, std::memory_order_acq_rel)) {
+			sites = new_sites;
+		} else {
+			memdelete_arr(new_sites); // Another thread was first, and sites is now its array.
+		}
+	}
+
+	std::atomic<InlineCacheSite *> &slot = sites[p_name * INLINE_CACHE_OP_MAX + p_op];
+	InlineCacheSite *site = slot.load(std::memory_order_acquire);
+	if (unlikely(!site)) {
+		InlineCacheSite *new_site = memnew(InlineCacheSite);
+		if (slot.compare_exchange_strong(site, new_site, std::memory_order_acq_rel)) {
+			site = new_site;
+		} else {
+			memdelete(new_site);
+		}
+	}
+	return site;
+}
+
+GDScriptFunction::InlineCacheHit GDScriptFunction::_resolve_inline_cache(const StringName &p_name, InlineCacheOp p_op, Object *p_object, GDScriptInstance *p_instance) const {
+	InlineCacheHit hit;
+	const GDScript *script = p_instance ? p_instance->script.ptr() : nullptr;
+
+	if (p_op == INLINE_CACHE_CALL) {
+		// Object::callp() handles free() before anything else, and GDScriptInstance::callp() runs the
+		// implicit ready functions before _ready().
+		if (p_name == CoreStringNames::get_singleton()->_free || (script && p_name == SNAME("_ready"))) {
+			return hit;
+		}
+		for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+			HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_name);
+			if (E) {
+				hit.kind = INLINE_CACHE_SCRIPT_FUNCTION;
+				hit.target = E->value;
+				return hit;
+			}
+		}
+		MethodBind *method = ClassDB::get_method(p_object->get_class_name(), p_name);
+		if (method) {
+			hit.kind = INLINE_CACHE_NATIVE_METHOD;
+			hit.target = method;
+		}
+		return hit;
+	}
+
+#ifdef TOOLS_ENABLED
+	// Object::set() marks the object as edited, which only matters (and only works) on the generic path.
+	if (p_op == INLINE_CACHE_SET && Engine::get_singleton()->is_editor_hint()) {
+		return hit;
+	}
+#endif
+
+	if (script) {
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+		if (E) {
+			const StringName &accessor = p_op == INLINE_CACHE_GET ? E->value.getter : E->value.setter;
+			if (accessor == StringName()) {
+				hit.kind = INLINE_CACHE_SCRIPT_MEMBER;
+				hit.target = const_cast<GDScript::MemberInfo *>(&E->value);
+				hit.index = E->value.index;
+			}
+			return hit;
+		}
+
+		// Anything else the script finds under the name comes before the native property, as well as
+		// whatever _get() and _set() do.
+		const GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+		for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+			if (sptr->constants.has(p_name) || sptr->static_variables_indices.has(p_name) || sptr->_signals.has(p_name) || sptr->member_functions.has(p_name) || sptr->subclasses.has(p_name)) {
+				return hit;
+			}
+			if (sptr->member_functions.has(language->strings._get) || sptr->member_functions.has(language->strings._set)) {
+				return hit;
+			}
+		}
+	}
+
+	const ClassDB::APIType api = ClassDB::get_api_type(p_object->get_class_name());
+	if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+		return hit; // Extension instances can intercept any property.
+	}
+
+	const ClassDB::PropertySetGet *psg = ClassDB::get_property_setget(p_object->get_class_name(), p_name);
+	MethodBind *accessor = nullptr;
+	if (psg) {
+		accessor = p_op == INLINE_CACHE_GET ? psg->_getptr : psg->_setptr;
+	}
+	if (accessor) {
+		hit.kind = INLINE_CACHE_NATIVE_PROPERTY;
+		hit.target = accessor;
+		hit.index = psg->index;
+	}
+	return hit;
+}
+
+bool GDScriptFunction::_inline_cache_lookup(int p_name, InlineCacheOp p_op, Object *p_object, GDScriptInstance *p_instance, InlineCacheHit &r_hit) {
+	InlineCacheSite *site = _get_inline_cache_site(p_name, p_op);
+	const void *class_name = p_object->get_class_name().data_unique_pointer();
+	const GDScript *script = p_instance ? p_instance->script.ptr() : nullptr;
+	const uint32_t script_generation = GDScriptLanguage::get_singleton()->get_script_generation();
+	const uint32_t class_generation = ClassDB::get_lookup_generation();
+
+	InlineCacheEntry *stale = nullptr;
+	for (InlineCacheEntry &entry : site->entries) {
+		const uint32_t sequence = entry.sequence.load(std::memory_order_acquire);
+		if (sequence & 1) {
+			continue;
+		}
+		const void *entry_class_name = entry.class_name.load(std::memory_order_relaxed);
+		const bool matches = entry_class_name == class_name && entry.script.load(std::memory_order_relaxed) == script;
+		const bool current = entry.script_generation.load(std::memory_order_relaxed) == script_generation && entry.class_generation.load(std::memory_order_relaxed) == class_generation;
+		r_hit.kind = InlineCacheKind(entry.kind.load(std::memory_order_relaxed));
+		r_hit.target = entry.target.load(std::memory_order_relaxed);
+		r_hit.index = entry.index.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (entry.sequence.load(std::memory_order_relaxed) != sequence) {
+			continue; // Rewritten while reading it.
+		}
+		if (matches && current) {
+			return r_hit.kind != INLINE_CACHE_UNCACHED;
+		}
+		if ((!current || !entry_class_name) && !stale) {
+			stale = &entry;
+		}
+	}
+
+	if (site->misses.load(std::memory_order_relaxed) >= INLINE_CACHE_MAX_MISSES) {
+		return false; // Megamorphic.
+	}
+
+	r_hit = _resolve_inline_cache(_global_names_ptr[p_name], p_op, p_object, p_instance);
+
+	// Entries of an older generation (or never written) go first, then the oldest entry.
+	InlineCacheEntry *entry = stale;
+	if (!entry) {
+		entry = &site->entries[site->next_entry.fetch_add(1, std::memory_order_relaxed) % INLINE_CACHE_ENTRIES];
+		site->misses.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint32_t sequence = entry->sequence.load(std::memory_order_relaxed);
+	if (!(sequence & 1) && entry->sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+		std::atomic_thread_fence(std::memory_order_release);
+		entry->class_name.store(class_name, std::memory_order_relaxed);
+		entry->script.store(script, std::memory_order_relaxed);
+		entry->script_generation.store(script_generation, std::memory_order_relaxed);
+		entry->class_generation.store(class_generation, std::memory_order_relaxed);
+		entry->kind.store(r_hit.kind, std::memory_order_relaxed);
+		entry->target.store(r_hit.target, std::memory_order_relaxed);
+		entry->index.store(r_hit.index, std::memory_order_relaxed);
+		entry->sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	return r_hit.kind != INLINE_CACHE_UNCACHED;
+}
+
+// The object of a base value the inline caches can handle, which is any object without a script
+// instance, or with a GDScript one.
+static _FORCE_INLINE_ Object *_get_inline_cache_object(const Variant *p_base, GDScriptInstance *&r_instance) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return nullptr;
+	}
+	Object *object = p_base->get_validated_object();
+	if (!object) {
+		return nullptr;
+	}
+
+	ScriptInstance *script_instance = object->get_script_instance();
+	if (script_instance) {
+		if (script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+			return nullptr;
+		}
+		r_instance = static_cast<GDScriptInstance *>(script_instance);
+	} else {
+		r_instance = nullptr;
+	}
+	return object;
+}
+
+bool GDScriptFunction::_inline_get(int p_name, const Variant *p_base, Variant &r_ret, bool &r_valid) {
+	GDScriptInstance *instance = nullptr;
+	Object *object = _get_inline_cache_object(p_base, instance);
+	InlineCacheHit hit;
+	if (!object || !_inline_cache_lookup(p_name, INLINE_CACHE_GET, object, instance, hit)) {
+		return false;
+	}
+
+	if (hit.kind == INLINE_CACHE_SCRIPT_MEMBER) {
+		r_ret = instance->members[hit.index];
+		r_valid = true;
+		return true;
+	}
+
+	MethodBind *getter = static_cast<MethodBind *>(hit.target);
+	Callable::CallError ce;
+	if (hit.index >= 0) {
+		Variant index = hit.index;
+		const Variant *args[1] = { &index };
+		r_ret = getter->call(object, args, 1, ce);
+	} else {
+		r_ret = getter->call(object, nullptr, 0, ce);
+	}
+	r_valid = ce.error == Callable::CallError::CALL_OK;
+	return true;
+}
+
+bool GDScriptFunction::_inline_set(int p_name, const Variant *p_base, const Variant *p_value, bool &r_valid) {
+	GDScriptInstance *instance = nullptr;
+	Object *object = _get_inline_cache_object(p_base, instance);
+	InlineCacheHit hit;
+	if (!object || !_inline_cache_lookup(p_name, INLINE_CACHE_SET, object, instance, hit)) {
+		return false;
+	}
+
+	if (hit.kind == INLINE_CACHE_SCRIPT_MEMBER) {
+		const GDScript::MemberInfo *member = static_cast<const GDScript::MemberInfo *>(hit.target);
+		if (member->data_type.has_type && !member->data_type.is_type(*p_value)) {
+			return false; // Let the generic path convert it.
+		}
+		instance->members.write[hit.index] = *p_value;
+		r_valid = true;
+		return true;
+	}
+
+	MethodBind *setter = static_cast<MethodBind *>(hit.target);
+	Callable::CallError ce;
+	if (hit.index >= 0) {
+		Variant index = hit.index;
+		const Variant *args[2] = { &index, p_value };
+		setter->call(object, args, 2, ce);
+	} else if (!setter->has_return() && !setter->is_vararg() && p_value->get_type() != Variant::OBJECT && setter->get_argument_type(0) == p_value->get_type()) {
+		// Objects still go through call(), which checks their class.
+		const Variant *args[1] = { p_value };
+		setter->validated_call(object, args, nullptr);
+	} else {
+		const Variant *args[1] = { p_value };
+		setter->call(object, args, 1, ce);
+	}
+	r_valid = ce.error == Callable::CallError::CALL_OK;
+	return true;
+}
+
+bool GDScriptFunction::_inline_call(int p_name, const Variant *p_base, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	GDScriptInstance *instance = nullptr;
+	Object *object = _get_inline_cache_object(p_base, instance);
+	InlineCacheHit hit;
+	if (!object || !_inline_cache_lookup(p_name, INLINE_CACHE_CALL, object, instance, hit)) {
+		return false;
+	}
+
+	r_err.error = Callable::CallError::CALL_OK;
+	Variant ret;
+	{
+#ifdef DEBUG_ENABLED
+		_ObjectDebugLock lock(object);
+#endif
+		if (hit.kind == INLINE_CACHE_SCRIPT_FUNCTION) {
+			ret = static_cast<GDScriptFunction *>(hit.target)->call(instance, p_args, p_argcount, r_err);
+		} else {
+			ret = static_cast<MethodBind *>(hit.target)->call(object, p_args, p_argcount, r_err);
+		}
+	}
+	// Assigned after the lock is released, as the return value may be stored over the base.
+	r_ret = ret;
+	return true;
+}
+
 #define METHOD_CALL_ON_FREED_INSTANCE_ERROR(method_pointer) "Cannot call method '" + (method_pointer)->get_name() + "' on a previously freed instance."
 
 Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state) {
@@ -445,6 +770,14 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		return _get_default_variant_for_data_type(return_type);
 	}
 
+	if (unlikely(!tiered_up.is_set()) && tier_up_call_count > 0 && !operator_positions.is_empty()) {
+		if (call_count_to_tier_up.fetch_add(1, std::memory_order_relaxed) + 1 >= tier_up_call_count) {
+			_tier_up();
+		}
+	}
+
+	int *exec_code = _get_code_ptr();
+
 	r_err.error = Callable::CallError::CALL_OK;
 
 	static thread_local int call_depth = 0;
@@ -550,19 +883,24 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				memnew_placement(&stack[i + 3], Variant(*p_args[i]));
 			}
 		}
-		for (int i = p_argcount + 3; i < _stack_size; i++) {
+		for (int i = p_argcount + 3; i < _typed_stack_start; i++) {
 			memnew_placement(&stack[i], Variant);
 		}
+		const Variant::Type *typed_stack_types_ptr = typed_stack_types.ptr();
+		for (int i = _typed_stack_start; i < _stack_size; i++) {
+			const Variant::Type type = typed_stack_types_ptr[i - _typed_stack_start];
+			if (type == Variant::NIL) {
+				memnew_placement(&stack[i], Variant);
+			} else {
+				type_init_function_table[type](&stack[i]);
+			}
+		}
 
 		if (_instruction_args_size) {
 			instruction_args = (Variant **)&aptr[sizeof(Variant) * _stack_size];
 		} else {
 			instruction_args = nullptr;
 		}
-
-		for (const KeyValue<int, Variant::Type> &E : temporary_slots) {
-			type_init_function_table[E.value](&stack[E.key]);
-		}
 	}
 
 	if (p_instance) {
@@ -597,7 +935,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #define GET_VARIANT_PTR(m_v, m_code_ofs)                                                            \
 	Variant *m_v;                                                                                   \
 	{                                                                                               \
-		int address = _code_ptr[ip + 1 + (m_code_ofs)];                                             \
+		int address = exec_code[ip + 1 + (m_code_ofs)];                                             \
 		int address_type = (address & ADDR_TYPE_MASK) >> ADDR_BITS;                                 \
 		if (unlikely(address_type < 0 || address_type >= ADDR_TYPE_MAX)) {                          \
 			err_text = "Bad address type.";                                                         \
@@ -624,7 +962,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #define GET_VARIANT_PTR(m_v, m_code_ofs)                                                        \
 	Variant *m_v;                                                                               \
 	{                                                                                           \
-		int address = _code_ptr[ip + 1 + (m_code_ofs)];                                         \
+		int address = exec_code[ip + 1 + (m_code_ofs)];                                         \
 		m_v = &variant_addresses[(address & ADDR_TYPE_MASK) >> ADDR_BITS][address & ADDR_MASK]; \
 		if (unlikely(!m_v))                                                                     \
 			OPCODE_BREAK;                                                                       \
@@ -633,7 +971,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 #define LOAD_INSTRUCTION_ARGS                   \
-	int instr_arg_count = _code_ptr[ip + 1];    \
+	int instr_arg_count = exec_code[ip + 1];    \
 	for (int i = 0; i < instr_arg_count; i++) { \
 		GET_VARIANT_PTR(v, i + 1);              \
 		instruction_args[i] = v;                \
@@ -653,6 +991,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		profile.call_count.increment();
 		profile.frame_call_count.increment();
 	}
+	const bool sampled = GDScriptSamplingProfiler::is_active(); // Stays the same for the whole call, so frames are balanced.
+	if (unlikely(sampled)) {
+		GDScriptSamplingProfiler::enter_function(this);
+	}
 	bool exit_ok = false;
 	bool awaited = false;
 	int variant_address_limits[ADDR_TYPE_MAX] = { _stack_size, _constant_count, p_instance ? p_instance->members.size() : 0 };
@@ -662,32 +1004,32 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
-		int last_opcode = _code_ptr[ip];
+		int last_opcode = exec_code[ip];
 #else
 	OPCODE_WHILE(true) {
 #endif
 
-		OPCODE_SWITCH(_code_ptr[ip]) {
+		OPCODE_SWITCH(exec_code[ip]) {
 			OPCODE(OPCODE_OPERATOR) {
-				constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*_code_ptr);
+				constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*exec_code);
 				CHECK_SPACE(7 + _pointer_size);
 
 				bool valid;
-				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 4];
+				Variant::Operator op = (Variant::Operator)exec_code[ip + 4];
 				GD_ERR_BREAK(op >= Variant::OP_MAX);
 
 				GET_VARIANT_PTR(a, 0);
 				GET_VARIANT_PTR(b, 1);
 				GET_VARIANT_PTR(dst, 2);
 				// Compute signatures (types of operands) so it can be optimized when matching.
-				uint32_t op_signature = _code_ptr[ip + 5];
+				uint32_t op_signature = exec_code[ip + 5];
 				uint32_t actual_signature = (a->get_type() << 8) | (b->get_type());
 
 #ifdef DEBUG_ENABLED
 				if (op == Variant::OP_DIVIDE || op == Variant::OP_MODULE) {
 					// Don't optimize division and modulo since there's not check for division by zero with validated calls.
 					op_signature = 0xFFFF;
-					_code_ptr[ip + 5] = op_signature;
+					exec_code[ip + 5] = op_signature;
 				}
 #endif
 
@@ -712,18 +1054,18 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						op_func(a, b, dst);
 
 						// Check again in case another thread already set it.
-						if (_code_ptr[ip + 5] == 0) {
-							_code_ptr[ip + 5] = actual_signature;
-							_code_ptr[ip + 6] = static_cast<int>(ret_type);
-							Variant::ValidatedOperatorEvaluator *tmp = reinterpret_cast<Variant::ValidatedOperatorEvaluator *>(&_code_ptr[ip + 7]);
+						if (exec_code[ip + 5] == 0) {
+							exec_code[ip + 5] = actual_signature;
+							exec_code[ip + 6] = static_cast<int>(ret_type);
+							Variant::ValidatedOperatorEvaluator *tmp = reinterpret_cast<Variant::ValidatedOperatorEvaluator *>(&exec_code[ip + 7]);
 							*tmp = op_func;
 						}
 					}
 					initializer_mutex.unlock();
 				} else if (likely(op_signature == actual_signature)) {
 					// If the signature matches, we can use the optimized path.
-					Variant::Type ret_type = static_cast<Variant::Type>(_code_ptr[ip + 6]);
-					Variant::ValidatedOperatorEvaluator op_func = *reinterpret_cast<Variant::ValidatedOperatorEvaluator *>(&_code_ptr[ip + 7]);
+					Variant::Type ret_type = static_cast<Variant::Type>(exec_code[ip + 6]);
+					Variant::ValidatedOperatorEvaluator op_func = *reinterpret_cast<Variant::ValidatedOperatorEvaluator *>(&exec_code[ip + 7]);
 
 					// Make sure the return value has the correct type.
 					VariantInternal::initialize(dst, ret_type);
@@ -758,7 +1100,24 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_OPERATOR_VALIDATED) {
 				CHECK_SPACE(5);
 
-				int operator_idx = _code_ptr[ip + 4];
+				int operator_idx = exec_code[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				int operator_idx = exec_code[ip + 4];
 				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
 				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
 
@@ -768,17 +1127,88 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				operator_func(a, b, dst);
 
+				// The result is always a bool, see GDScriptByteCodeGenerator::_try_fuse_jump_if_not().
+				if (!*VariantInternal::get_bool(dst)) {
+					int to = exec_code[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_INT) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				_evaluate_quick_operator<int64_t>(exec_code[ip + 4], a, b, dst);
+
 				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_FLOAT) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				_evaluate_quick_operator<double>(exec_code[ip + 4], a, b, dst);
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_INT_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				_evaluate_quick_operator<int64_t>(exec_code[ip + 4], a, b, dst);
+
+				if (!*VariantInternal::get_bool(dst)) {
+					int to = exec_code[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_FLOAT_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				_evaluate_quick_operator<double>(exec_code[ip + 4], a, b, dst);
+
+				if (!*VariantInternal::get_bool(dst)) {
+					int to = exec_code[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
 
-				Variant::Type builtin_type = (Variant::Type)_code_ptr[ip + 3];
+				Variant::Type builtin_type = (Variant::Type)exec_code[ip + 3];
 				GD_ERR_BREAK(builtin_type < 0 || builtin_type >= Variant::VARIANT_MAX);
 
 				*dst = value->get_type() == builtin_type;
@@ -793,8 +1223,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(value, 1);
 
 				GET_VARIANT_PTR(script_type, 2);
-				Variant::Type builtin_type = (Variant::Type)_code_ptr[ip + 4];
-				int native_type_idx = _code_ptr[ip + 5];
+				Variant::Type builtin_type = (Variant::Type)exec_code[ip + 4];
+				int native_type_idx = exec_code[ip + 5];
 				GD_ERR_BREAK(native_type_idx < 0 || native_type_idx >= _global_names_count);
 				const StringName native_type = _global_names_ptr[native_type_idx];
 
@@ -815,7 +1245,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
 
-				int native_type_idx = _code_ptr[ip + 3];
+				int native_type_idx = exec_code[ip + 3];
 				GD_ERR_BREAK(native_type_idx < 0 || native_type_idx >= _global_names_count);
 				const StringName native_type = _global_names_ptr[native_type_idx];
 
@@ -914,7 +1344,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(index, 1);
 				GET_VARIANT_PTR(value, 2);
 
-				int index_setter = _code_ptr[ip + 4];
+				int index_setter = exec_code[ip + 4];
 				GD_ERR_BREAK(index_setter < 0 || index_setter >= _keyed_setters_count);
 				const Variant::ValidatedKeyedSetter setter = _keyed_setters_ptr[index_setter];
 
@@ -944,7 +1374,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(index, 1);
 				GET_VARIANT_PTR(value, 2);
 
-				int index_setter = _code_ptr[ip + 4];
+				int index_setter = exec_code[ip + 4];
 				GD_ERR_BREAK(index_setter < 0 || index_setter >= _indexed_setters_count);
 				const Variant::ValidatedIndexedSetter setter = _indexed_setters_ptr[index_setter];
 
@@ -1012,7 +1442,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(key, 1);
 				GET_VARIANT_PTR(dst, 2);
 
-				int index_getter = _code_ptr[ip + 4];
+				int index_getter = exec_code[ip + 4];
 				GD_ERR_BREAK(index_getter < 0 || index_getter >= _keyed_getters_count);
 				const Variant::ValidatedKeyedGetter getter = _keyed_getters_ptr[index_getter];
 
@@ -1048,7 +1478,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(index, 1);
 				GET_VARIANT_PTR(dst, 2);
 
-				int index_getter = _code_ptr[ip + 4];
+				int index_getter = exec_code[ip + 4];
 				GD_ERR_BREAK(index_getter < 0 || index_getter >= _indexed_getters_count);
 				const Variant::ValidatedIndexedGetter getter = _indexed_getters_ptr[index_getter];
 
@@ -1079,13 +1509,15 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
 
-				int indexname = _code_ptr[ip + 3];
+				int indexname = exec_code[ip + 3];
 
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				if (!_inline_set(indexname, dst, value, valid)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1112,7 +1544,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
 
-				int index_setter = _code_ptr[ip + 3];
+				int index_setter = exec_code[ip + 3];
 				GD_ERR_BREAK(index_setter < 0 || index_setter >= _setters_count);
 				const Variant::ValidatedSetter setter = _setters_ptr[index_setter];
 
@@ -1127,26 +1559,24 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
 
-				int indexname = _code_ptr[ip + 3];
+				int indexname = exec_code[ip + 3];
 
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				// Also allows a better error message in cases where src and dst are the same stack position.
+				Variant ret;
 				bool valid;
-#ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
-
-#else
-				*dst = src->get_named(*index, valid);
-#endif
+				if (!_inline_get(indexname, src, ret, valid)) {
+					ret = src->get_named(*index, valid);
+				}
 #ifdef DEBUG_ENABLED
 				if (!valid) {
 					err_text = "Invalid access to property or key '" + index->operator String() + "' on a base object of type '" + _get_var_type(src) + "'.";
 					OPCODE_BREAK;
 				}
-				*dst = ret;
 #endif
+				*dst = ret;
 				ip += 4;
 			}
 			DISPATCH_OPCODE;
@@ -1157,7 +1587,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
 
-				int index_getter = _code_ptr[ip + 3];
+				int index_getter = exec_code[ip + 3];
 				GD_ERR_BREAK(index_getter < 0 || index_getter >= _getters_count);
 				const Variant::ValidatedGetter getter = _getters_ptr[index_getter];
 
@@ -1169,7 +1599,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_SET_MEMBER) {
 				CHECK_SPACE(3);
 				GET_VARIANT_PTR(src, 0);
-				int indexname = _code_ptr[ip + 2];
+				int indexname = exec_code[ip + 2];
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
@@ -1193,7 +1623,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_GET_MEMBER) {
 				CHECK_SPACE(3);
 				GET_VARIANT_PTR(dst, 0);
-				int indexname = _code_ptr[ip + 2];
+				int indexname = exec_code[ip + 2];
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 #ifndef DEBUG_ENABLED
@@ -1218,7 +1648,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GDScript *gdscript = Object::cast_to<GDScript>(_class->operator Object *());
 				GD_ERR_BREAK(!gdscript);
 
-				int index = _code_ptr[ip + 3];
+				int index = exec_code[ip + 3];
 				GD_ERR_BREAK(index < 0 || index >= gdscript->static_variables.size());
 
 				gdscript->static_variables.write[index] = *value;
@@ -1236,7 +1666,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GDScript *gdscript = Object::cast_to<GDScript>(_class->operator Object *());
 				GD_ERR_BREAK(!gdscript);
 
-				int index = _code_ptr[ip + 3];
+				int index = exec_code[ip + 3];
 				GD_ERR_BREAK(index < 0 || index >= gdscript->static_variables.size());
 
 				*target = gdscript->static_variables[index];
@@ -1281,7 +1711,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(src, 1);
 
-				Variant::Type var_type = (Variant::Type)_code_ptr[ip + 3];
+				Variant::Type var_type = (Variant::Type)exec_code[ip + 3];
 				GD_ERR_BREAK(var_type < 0 || var_type >= Variant::VARIANT_MAX);
 
 				if (src->get_type() != var_type) {
@@ -1311,8 +1741,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(src, 1);
 
 				GET_VARIANT_PTR(script_type, 2);
-				Variant::Type builtin_type = (Variant::Type)_code_ptr[ip + 4];
-				int native_type_idx = _code_ptr[ip + 5];
+				Variant::Type builtin_type = (Variant::Type)exec_code[ip + 4];
+				int native_type_idx = exec_code[ip + 5];
 				GD_ERR_BREAK(native_type_idx < 0 || native_type_idx >= _global_names_count);
 				const StringName native_type = _global_names_ptr[native_type_idx];
 
@@ -1438,7 +1868,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				CHECK_SPACE(4);
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
-				Variant::Type to_type = (Variant::Type)_code_ptr[ip + 3];
+				Variant::Type to_type = (Variant::Type)exec_code[ip + 3];
 
 				GD_ERR_BREAK(to_type < 0 || to_type >= Variant::VARIANT_MAX);
 
@@ -1549,9 +1979,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 
-				Variant::Type t = Variant::Type(_code_ptr[ip + 2]);
+				Variant::Type t = Variant::Type(exec_code[ip + 2]);
 
 				Variant **argptrs = instruction_args;
 
@@ -1576,9 +2006,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				CHECK_SPACE(2 + instr_arg_count);
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 
-				int constructor_idx = _code_ptr[ip + 2];
+				int constructor_idx = exec_code[ip + 2];
 				GD_ERR_BREAK(constructor_idx < 0 || constructor_idx >= _constructors_count);
 				Variant::ValidatedConstructor constructor = _constructors_ptr[constructor_idx];
 
@@ -1597,7 +2027,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				CHECK_SPACE(1 + instr_arg_count);
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 				Array array;
 				array.resize(argc);
 
@@ -1619,11 +2049,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				CHECK_SPACE(3 + instr_arg_count);
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 
 				GET_INSTRUCTION_ARG(script_type, argc + 1);
-				Variant::Type builtin_type = (Variant::Type)_code_ptr[ip + 2];
-				int native_type_idx = _code_ptr[ip + 3];
+				Variant::Type builtin_type = (Variant::Type)exec_code[ip + 2];
+				int native_type_idx = exec_code[ip + 3];
 				GD_ERR_BREAK(native_type_idx < 0 || native_type_idx >= _global_names_count);
 				const StringName native_type = _global_names_ptr[native_type_idx];
 
@@ -1648,7 +2078,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 				Dictionary dict;
 
 				for (int i = 0; i < argc; i++) {
@@ -1668,19 +2098,19 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_CALL_ASYNC)
 			OPCODE(OPCODE_CALL_RETURN)
 			OPCODE(OPCODE_CALL) {
-				bool call_ret = (_code_ptr[ip]) != OPCODE_CALL;
+				bool call_ret = (exec_code[ip]) != OPCODE_CALL;
 #ifdef DEBUG_ENABLED
-				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
+				bool call_async = (exec_code[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
 				CHECK_SPACE(3 + instr_arg_count);
 
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 				GD_ERR_BREAK(argc < 0);
 
-				int methodname_idx = _code_ptr[ip + 2];
+				int methodname_idx = exec_code[ip + 2];
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
@@ -1693,6 +2123,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					call_time = OS::get_singleton()->get_ticks_usec();
 				}
+				if (unlikely(sampled)) {
+					GDScriptSamplingProfiler::poll();
+				}
 				Variant::Type base_type = base->get_type();
 				Object *base_obj = base->get_validated_object();
 				StringName base_class = base_obj ? base_obj->get_class_name() : StringName();
@@ -1701,7 +2134,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					if (!_inline_call(methodname_idx, base, (const Variant **)argptrs, argc, *ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					}
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
 						if (base_type == Variant::OBJECT) {
@@ -1731,7 +2166,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				} else {
 					Variant ret;
-					base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					if (!_inline_call(methodname_idx, base, (const Variant **)argptrs, argc, ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					}
 				}
 #ifdef DEBUG_ENABLED
 
@@ -1742,6 +2179,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 					function_call_time += t_taken;
 				}
+				if (unlikely(sampled)) {
+					GDScriptSamplingProfiler::poll_native(base_class, *methodname);
+				}
 
 				if (err.error != Callable::CallError::CALL_OK) {
 					String methodstr = *methodname;
@@ -1787,16 +2227,16 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 			OPCODE(OPCODE_CALL_METHOD_BIND)
 			OPCODE(OPCODE_CALL_METHOD_BIND_RET) {
-				bool call_ret = (_code_ptr[ip]) == OPCODE_CALL_METHOD_BIND_RET;
+				bool call_ret = (exec_code[ip]) == OPCODE_CALL_METHOD_BIND_RET;
 				LOAD_INSTRUCTION_ARGS
 				CHECK_SPACE(3 + instr_arg_count);
 
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 				GD_ERR_BREAK(argc < 0);
-				GD_ERR_BREAK(_code_ptr[ip + 2] < 0 || _code_ptr[ip + 2] >= _methods_count);
-				MethodBind *method = _methods_ptr[_code_ptr[ip + 2]];
+				GD_ERR_BREAK(exec_code[ip + 2] < 0 || exec_code[ip + 2] >= _methods_count);
+				MethodBind *method = _methods_ptr[exec_code[ip + 2]];
 
 				GET_INSTRUCTION_ARG(base, argc);
 
@@ -1820,6 +2260,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling && GDScriptLanguage::get_singleton()->profile_native_calls) {
 					call_time = OS::get_singleton()->get_ticks_usec();
 				}
+				if (unlikely(sampled)) {
+					GDScriptSamplingProfiler::poll();
+				}
 #endif
 
 				Callable::CallError err;
@@ -1837,6 +2280,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					_profile_native_call(t_taken, method->get_name(), method->get_instance_class());
 					function_call_time += t_taken;
 				}
+				if (unlikely(sampled)) {
+					GDScriptSamplingProfiler::poll_native(method->get_instance_class(), method->get_name());
+				}
 
 				if (err.error != Callable::CallError::CALL_OK) {
 					String methodstr = method->get_name();
@@ -1874,14 +2320,14 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				GD_ERR_BREAK(_code_ptr[ip + 1] < 0 || _code_ptr[ip + 1] >= Variant::VARIANT_MAX);
-				Variant::Type builtin_type = (Variant::Type)_code_ptr[ip + 1];
+				GD_ERR_BREAK(exec_code[ip + 1] < 0 || exec_code[ip + 1] >= Variant::VARIANT_MAX);
+				Variant::Type builtin_type = (Variant::Type)exec_code[ip + 1];
 
-				int methodname_idx = _code_ptr[ip + 2];
+				int methodname_idx = exec_code[ip + 2];
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
-				int argc = _code_ptr[ip + 3];
+				int argc = exec_code[ip + 3];
 				GD_ERR_BREAK(argc < 0);
 
 				GET_INSTRUCTION_ARG(ret, argc);
@@ -1908,10 +2354,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				GD_ERR_BREAK(_code_ptr[ip + 1] < 0 || _code_ptr[ip + 1] >= _methods_count);
-				MethodBind *method = _methods_ptr[_code_ptr[ip + 1]];
+				GD_ERR_BREAK(exec_code[ip + 1] < 0 || exec_code[ip + 1] >= _methods_count);
+				MethodBind *method = _methods_ptr[exec_code[ip + 1]];
 
-				int argc = _code_ptr[ip + 2];
+				int argc = exec_code[ip + 2];
 				GD_ERR_BREAK(argc < 0);
 
 				GET_INSTRUCTION_ARG(ret, argc);
@@ -1923,6 +2369,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling && GDScriptLanguage::get_singleton()->profile_native_calls) {
 					call_time = OS::get_singleton()->get_ticks_usec();
 				}
+				if (unlikely(sampled)) {
+					GDScriptSamplingProfiler::poll();
+				}
 #endif
 
 				Callable::CallError err;
@@ -1934,6 +2383,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					_profile_native_call(t_taken, method->get_name(), method->get_instance_class());
 					function_call_time += t_taken;
 				}
+				if (unlikely(sampled)) {
+					GDScriptSamplingProfiler::poll_native(method->get_instance_class(), method->get_name());
+				}
 #endif
 
 				if (err.error != Callable::CallError::CALL_OK) {
@@ -1951,11 +2403,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 				GD_ERR_BREAK(argc < 0);
 
-				GD_ERR_BREAK(_code_ptr[ip + 2] < 0 || _code_ptr[ip + 2] >= _methods_count);
-				MethodBind *method = _methods_ptr[_code_ptr[ip + 2]];
+				GD_ERR_BREAK(exec_code[ip + 2] < 0 || exec_code[ip + 2] >= _methods_count);
+				MethodBind *method = _methods_ptr[exec_code[ip + 2]];
 
 				GET_INSTRUCTION_ARG(base, argc);
 
@@ -1980,6 +2432,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling && GDScriptLanguage::get_singleton()->profile_native_calls) {
 					call_time = OS::get_singleton()->get_ticks_usec();
 				}
+				if (unlikely(sampled)) {
+					GDScriptSamplingProfiler::poll();
+				}
 #endif
 
 				GET_INSTRUCTION_ARG(ret, argc + 1);
@@ -1991,6 +2446,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					_profile_native_call(t_taken, method->get_name(), method->get_instance_class());
 					function_call_time += t_taken;
 				}
+				if (unlikely(sampled)) {
+					GDScriptSamplingProfiler::poll_native(method->get_instance_class(), method->get_name());
+				}
 #endif
 
 				ip += 3;
@@ -2003,11 +2461,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 				GD_ERR_BREAK(argc < 0);
 
-				GD_ERR_BREAK(_code_ptr[ip + 2] < 0 || _code_ptr[ip + 2] >= _methods_count);
-				MethodBind *method = _methods_ptr[_code_ptr[ip + 2]];
+				GD_ERR_BREAK(exec_code[ip + 2] < 0 || exec_code[ip + 2] >= _methods_count);
+				MethodBind *method = _methods_ptr[exec_code[ip + 2]];
 
 				GET_INSTRUCTION_ARG(base, argc);
 #ifdef DEBUG_ENABLED
@@ -2029,6 +2487,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling && GDScriptLanguage::get_singleton()->profile_native_calls) {
 					call_time = OS::get_singleton()->get_ticks_usec();
 				}
+				if (unlikely(sampled)) {
+					GDScriptSamplingProfiler::poll();
+				}
 #endif
 
 				GET_INSTRUCTION_ARG(ret, argc + 1);
@@ -2041,6 +2502,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					_profile_native_call(t_taken, method->get_name(), method->get_instance_class());
 					function_call_time += t_taken;
 				}
+				if (unlikely(sampled)) {
+					GDScriptSamplingProfiler::poll_native(method->get_instance_class(), method->get_name());
+				}
 #endif
 
 				ip += 3;
@@ -2054,13 +2518,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 				GD_ERR_BREAK(argc < 0);
 
 				GET_INSTRUCTION_ARG(base, argc);
 
-				GD_ERR_BREAK(_code_ptr[ip + 2] < 0 || _code_ptr[ip + 2] >= _builtin_methods_count);
-				Variant::ValidatedBuiltInMethod method = _builtin_methods_ptr[_code_ptr[ip + 2]];
+				GD_ERR_BREAK(exec_code[ip + 2] < 0 || exec_code[ip + 2] >= _builtin_methods_count);
+				Variant::ValidatedBuiltInMethod method = _builtin_methods_ptr[exec_code[ip + 2]];
 				Variant **argptrs = instruction_args;
 
 				GET_INSTRUCTION_ARG(ret, argc + 1);
@@ -2076,11 +2540,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 				GD_ERR_BREAK(argc < 0);
 
-				GD_ERR_BREAK(_code_ptr[ip + 2] < 0 || _code_ptr[ip + 2] >= _global_names_count);
-				StringName function = _global_names_ptr[_code_ptr[ip + 2]];
+				GD_ERR_BREAK(exec_code[ip + 2] < 0 || exec_code[ip + 2] >= _global_names_count);
+				StringName function = _global_names_ptr[exec_code[ip + 2]];
 
 				Variant **argptrs = instruction_args;
 
@@ -2111,11 +2575,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 				GD_ERR_BREAK(argc < 0);
 
-				GD_ERR_BREAK(_code_ptr[ip + 2] < 0 || _code_ptr[ip + 2] >= _utilities_count);
-				Variant::ValidatedUtilityFunction function = _utilities_ptr[_code_ptr[ip + 2]];
+				GD_ERR_BREAK(exec_code[ip + 2] < 0 || exec_code[ip + 2] >= _utilities_count);
+				Variant::ValidatedUtilityFunction function = _utilities_ptr[exec_code[ip + 2]];
 
 				Variant **argptrs = instruction_args;
 
@@ -2133,11 +2597,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 				GD_ERR_BREAK(argc < 0);
 
-				GD_ERR_BREAK(_code_ptr[ip + 2] < 0 || _code_ptr[ip + 2] >= _gds_utilities_count);
-				GDScriptUtilityFunctions::FunctionPtr function = _gds_utilities_ptr[_code_ptr[ip + 2]];
+				GD_ERR_BREAK(exec_code[ip + 2] < 0 || exec_code[ip + 2] >= _gds_utilities_count);
+				GDScriptUtilityFunctions::FunctionPtr function = _gds_utilities_ptr[exec_code[ip + 2]];
 
 				Variant **argptrs = instruction_args;
 
@@ -2148,7 +2612,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #ifdef DEBUG_ENABLED
 				if (err.error != Callable::CallError::CALL_OK) {
-					String methodstr = gds_utilities_names[_code_ptr[ip + 2]];
+					String methodstr = gds_utilities_names[exec_code[ip + 2]];
 					if (dst->get_type() == Variant::STRING && !dst->operator String().is_empty()) {
 						// Call provided error string.
 						err_text = vformat(R"*(Error calling GDScript utility function "%s()": %s)*", methodstr, *dst);
@@ -2168,10 +2632,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				int argc = _code_ptr[ip + 1];
+				int argc = exec_code[ip + 1];
 				GD_ERR_BREAK(argc < 0);
 
-				int self_fun = _code_ptr[ip + 2];
+				int self_fun = exec_code[ip + 2];
 #ifdef DEBUG_ENABLED
 				if (self_fun < 0 || self_fun >= _global_names_count) {
 					err_text = "compiler bug, function name not found";
@@ -2338,10 +2802,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				int captures_count = _code_ptr[ip + 1];
+				int captures_count = exec_code[ip + 1];
 				GD_ERR_BREAK(captures_count < 0);
 
-				int lambda_index = _code_ptr[ip + 2];
+				int lambda_index = exec_code[ip + 2];
 				GD_ERR_BREAK(lambda_index < 0 || lambda_index >= _lambdas_count);
 				GDScriptFunction *lambda = _lambdas_ptr[lambda_index];
 
@@ -2369,10 +2833,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += instr_arg_count;
 
-				int captures_count = _code_ptr[ip + 1];
+				int captures_count = exec_code[ip + 1];
 				GD_ERR_BREAK(captures_count < 0);
 
-				int lambda_index = _code_ptr[ip + 2];
+				int lambda_index = exec_code[ip + 2];
 				GD_ERR_BREAK(lambda_index < 0 || lambda_index >= _lambdas_count);
 				GDScriptFunction *lambda = _lambdas_ptr[lambda_index];
 
@@ -2397,9 +2861,44 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_CALL_SELF_LAMBDA)
+			OPCODE(OPCODE_CALL_LAMBDA) {
+				// A lambda that never escapes its function is called directly, without making a Callable for it.
+				bool use_self = (exec_code[ip]) == OPCODE_CALL_SELF_LAMBDA;
+				LOAD_INSTRUCTION_ARGS
+				CHECK_SPACE(3 + instr_arg_count);
+
+				ip += instr_arg_count;
+
+				int argc = exec_code[ip + 1];
+				GD_ERR_BREAK(argc < 0);
+
+				int lambda_index = exec_code[ip + 2];
+				GD_ERR_BREAK(lambda_index < 0 || lambda_index >= _lambdas_count);
+				GDScriptFunction *lambda = _lambdas_ptr[lambda_index];
+
+				GD_ERR_BREAK(use_self && p_instance == nullptr);
+
+				Variant **argptrs = instruction_args;
+
+				GET_INSTRUCTION_ARG(dst, argc);
+
+				Callable::CallError err;
+				*dst = lambda->call(use_self ? p_instance : nullptr, (const Variant **)argptrs, argc, err);
+
+#ifdef DEBUG_ENABLED
+				if (err.error != Callable::CallError::CALL_OK) {
+					err_text = _get_call_error(err, "function '" + lambda->get_name().operator String() + "' (Callable)", (const Variant **)argptrs);
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 3;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_JUMP) {
 				CHECK_SPACE(2);
-				int to = _code_ptr[ip + 1];
+				int to = exec_code[ip + 1];
 
 				GD_ERR_BREAK(to < 0 || to > _code_size);
 				ip = to;
@@ -2414,7 +2913,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool result = test->booleanize();
 
 				if (result) {
-					int to = _code_ptr[ip + 2];
+					int to = exec_code[ip + 2];
 					GD_ERR_BREAK(to < 0 || to > _code_size);
 					ip = to;
 				} else {
@@ -2431,7 +2930,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool result = test->booleanize();
 
 				if (!result) {
-					int to = _code_ptr[ip + 2];
+					int to = exec_code[ip + 2];
 					GD_ERR_BREAK(to < 0 || to > _code_size);
 					ip = to;
 				} else {
@@ -2452,7 +2951,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(val, 0);
 
 				if (val->is_shared()) {
-					int to = _code_ptr[ip + 2];
+					int to = exec_code[ip + 2];
 					GD_ERR_BREAK(to < 0 || to > _code_size);
 					ip = to;
 				} else {
@@ -2475,7 +2974,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				CHECK_SPACE(3);
 				GET_VARIANT_PTR(r, 0);
 
-				Variant::Type ret_type = (Variant::Type)_code_ptr[ip + 2];
+				Variant::Type ret_type = (Variant::Type)exec_code[ip + 2];
 				GD_ERR_BREAK(ret_type < 0 || ret_type >= Variant::VARIANT_MAX);
 
 				if (r->get_type() != ret_type) {
@@ -2507,8 +3006,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(r, 0);
 
 				GET_VARIANT_PTR(script_type, 1);
-				Variant::Type builtin_type = (Variant::Type)_code_ptr[ip + 3];
-				int native_type_idx = _code_ptr[ip + 4];
+				Variant::Type builtin_type = (Variant::Type)exec_code[ip + 3];
+				int native_type_idx = exec_code[ip + 4];
 				GD_ERR_BREAK(native_type_idx < 0 || native_type_idx >= _global_names_count);
 				const StringName native_type = _global_names_ptr[native_type_idx];
 
@@ -2657,7 +3156,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						OPCODE_BREAK;
 					}
 #endif
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -2695,7 +3194,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					ip += 5;
 				} else {
 					// Jump to end of loop.
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				}
@@ -2722,7 +3221,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					ip += 5;
 				} else {
 					// Jump to end of loop.
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				}
@@ -2749,7 +3248,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					ip += 5;
 				} else {
 					// Jump to end of loop.
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				}
@@ -2776,7 +3275,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					ip += 5;
 				} else {
 					// Jump to end of loop.
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				}
@@ -2808,7 +3307,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					ip += 5;
 				} else {
 					// Jump to end of loop.
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				}
@@ -2840,7 +3339,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					ip += 5;
 				} else {
 					// Jump to end of loop.
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				}
@@ -2867,7 +3366,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					ip += 5;
 				} else {
 					// Jump to end of loop.
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				}
@@ -2892,7 +3391,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					ip += 5;
 				} else {
 					// Jump to end of loop.
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				}
@@ -2918,7 +3417,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					ip += 5;
 				} else {
 					// Jump to end of loop.
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				}
@@ -2940,7 +3439,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			*it = array->get(0);                                                                                           \
 			ip += 5;                                                                                                       \
 		} else {                                                                                                           \
-			int jumpto = _code_ptr[ip + 4];                                                                                \
+			int jumpto = exec_code[ip + 4];                                                                                \
 			GD_ERR_BREAK(jumpto<0 || jumpto> _code_size);                                                                  \
 			ip = jumpto;                                                                                                   \
 		}                                                                                                                  \
@@ -2995,7 +3494,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 				if (!has_next.booleanize()) {
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -3027,7 +3526,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						OPCODE_BREAK;
 					}
 #endif
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -3057,7 +3556,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				(*count)++;
 
 				if (*count >= size) {
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -3081,7 +3580,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				(*count)++;
 
 				if (*count >= size) {
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -3105,7 +3604,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				(*count)++;
 
 				if (*count >= bounds->y) {
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -3129,7 +3628,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				(*count)++;
 
 				if (*count >= bounds->y) {
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -3153,7 +3652,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				*count += bounds->z;
 
 				if ((bounds->z < 0 && *count <= bounds->y) || (bounds->z > 0 && *count >= bounds->y)) {
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -3177,7 +3676,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				*count += bounds->z;
 
 				if ((bounds->z < 0 && *count <= bounds->y) || (bounds->z > 0 && *count >= bounds->y)) {
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -3200,7 +3699,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				(*idx)++;
 
 				if (*idx >= str->length()) {
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -3222,7 +3721,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				const Variant *next = dict->next(counter);
 
 				if (!next) {
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -3246,7 +3745,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				(*idx)++;
 
 				if (*idx >= array->size()) {
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -3267,7 +3766,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		int64_t *idx = VariantInternal::get_int(counter);                                           \
 		(*idx)++;                                                                                   \
 		if (*idx >= array->size()) {                                                                \
-			int jumpto = _code_ptr[ip + 4];                                                         \
+			int jumpto = exec_code[ip + 4];                                                         \
 			GD_ERR_BREAK(jumpto<0 || jumpto> _code_size);                                           \
 			ip = jumpto;                                                                            \
 		} else {                                                                                    \
@@ -3326,7 +3825,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 				if (!has_next.booleanize()) {
-					int jumpto = _code_ptr[ip + 4];
+					int jumpto = exec_code[ip + 4];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
@@ -3346,7 +3845,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 			OPCODE(OPCODE_STORE_GLOBAL) {
 				CHECK_SPACE(3);
-				int global_idx = _code_ptr[ip + 2];
+				int global_idx = exec_code[ip + 2];
 				GD_ERR_BREAK(global_idx < 0 || global_idx >= GDScriptLanguage::get_singleton()->get_global_array_size());
 
 				GET_VARIANT_PTR(dst, 0);
@@ -3358,7 +3857,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 			OPCODE(OPCODE_STORE_NAMED_GLOBAL) {
 				CHECK_SPACE(3);
-				int globalname_idx = _code_ptr[ip + 2];
+				int globalname_idx = exec_code[ip + 2];
 				GD_ERR_BREAK(globalname_idx < 0 || globalname_idx >= _global_names_count);
 				const StringName *globalname = &_global_names_ptr[globalname_idx];
 				GD_ERR_BREAK(!GDScriptLanguage::get_singleton()->get_named_globals_map().has(*globalname));
@@ -3426,7 +3925,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				if (!result) {
 					String message_str;
-					if (_code_ptr[ip + 2] != 0) {
+					if (exec_code[ip + 2] != 0) {
 						GET_VARIANT_PTR(message, 1);
 						Variant message_var = *message;
 						if (message->get_type() != Variant::NIL) {
@@ -3459,9 +3958,15 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
-				line = _code_ptr[ip + 1];
+				line = exec_code[ip + 1];
 				ip += 2;
 
+#ifdef DEBUG_ENABLED
+				if (unlikely(sampled)) {
+					GDScriptSamplingProfiler::poll();
+				}
+#endif
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -3497,7 +4002,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #if 0 // Enable for debugging.
 			default: {
-				err_text = "Illegal opcode " + itos(_code_ptr[ip]) + " at address " + itos(ip);
+				err_text = "Illegal opcode " + itos(exec_code[ip]) + " at address " + itos(ip);
 				OPCODE_BREAK;
 			}
 #endif
@@ -3554,6 +4059,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			GDScriptLanguage::get_singleton()->script_frame_time += time_taken - function_call_time;
 		}
 	}
+	if (unlikely(sampled)) {
+		GDScriptSamplingProfiler::exit_function();
+	}
 
 	// Check if this is not the last time it was interrupted by `await` or if it's the first time executing.
 	// If that is the case then we exit the function as normal. Otherwise we postpone it until the last `await` is completed.
@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_utility_functions.h"
@@ -49,12 +50,14 @@
 #include "tests/test_gdscript.h"
 #endif
 
+#include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/resource_loader.h"
 
 #ifdef TOOLS_ENABLED
+#include "editor/editor_file_system.h"
 #include "editor/editor_node.h"
 #include "editor/editor_settings.h"
 #include "editor/editor_translation_parser.h"
@@ -81,7 +84,14 @@ Ref<GDScriptEditorTranslationParserPlugin> gdscript_translation_parser_plugin;
 class EditorExportGDScript : public EditorExportPlugin {
 	GDCLASS(EditorExportGDScript, EditorExportPlugin);
 
+	bool export_bytecode_cache = false;
+
 public:
+	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
+		// Debug and release export templates both load the code compiled by the editor.
+		export_bytecode_cache = GLOBAL_GET("gdscript/optimization/export_bytecode_cache");
+	}
+
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
 		String script_key;
 
@@ -95,13 +105,33 @@ public:
 			return;
 		}
 
+		if (export_bytecode_cache) {
+			// The source is still exported, it's used when the cache can't be loaded.
+			Ref<GDScript> script = ResourceLoader::load(p_path, "GDScript");
+			Vector<uint8_t> data;
+			Error err = script.is_valid() ? GDScriptBytecodeCache::save_script(script, data) : ERR_CANT_OPEN;
+			if (err == OK) {
+				add_file(GDScriptBytecodeCache::get_cache_path(p_path), data, false);
+			} else {
+				print_verbose(vformat(R"(GDScript: Not exporting bytecode cache for "%s": %s.)", p_path, error_names[err]));
+			}
+		}
+
 		return;
 	}
 
 	virtual String get_name() const override { return "GDScript"; }
 };
 
+static void _editor_first_scan_done(bool p_exist) {
+	// The project and its main scene are loaded by now, so the remaining preparsed scripts weren't needed.
+	GDScriptCache::discard_preparsed();
+}
+
 static void _editor_init() {
+	// Connected after the editor itself, so this runs once it has loaded the project.
+	EditorFileSystem::get_singleton()->connect("sources_changed", callable_mp_static(&_editor_first_scan_done), Object::CONNECT_ONE_SHOT);
+
 	Ref<EditorExportGDScript> gd_export;
 	gd_export.instantiate();
 	EditorExport::get_singleton()->add_export_plugin(gd_export);
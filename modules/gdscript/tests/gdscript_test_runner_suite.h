@@ -33,6 +33,11 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_sampling_profiler.h"
+
+#include "core/io/dir_access.h"
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -71,6 +76,322 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[Modules][GDScript] Quickened functions give the same results") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func compute(n: int) -> Array:
+	var total: int = 0
+	var ratio: float = 0.0
+	var i: int = 0
+	while i < n:
+		total = total + i * i - 3
+		if i % 2 == 0 and total >= 10:
+			ratio = ratio + float(total) / 7.0
+		i += 1
+	return [total, ratio, total != 0, ratio <= 1.5]
+)");
+	const Error error = gdscript->reload();
+	REQUIRE(error == OK);
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	GDScriptFunction *function = gdscript->get_member_functions()["compute"];
+	REQUIRE(function != nullptr);
+
+	// Restores the threshold even if a check below aborts the test case.
+	struct TierUpCallCountOverride {
+		const uint32_t previous = GDScriptFunction::tier_up_call_count;
+		TierUpCallCountOverride(uint32_t p_count) { GDScriptFunction::tier_up_call_count = p_count; }
+		~TierUpCallCountOverride() { GDScriptFunction::tier_up_call_count = previous; }
+	} tier_up_call_count_override(2);
+
+	const Variant interpreted = ref_counted->call("compute", 20);
+	CHECK_FALSE(function->is_tiered_up());
+	ref_counted->call("compute", 20);
+	CHECK(function->is_tiered_up());
+	const Variant quickened = ref_counted->call("compute", 20);
+	CHECK(quickened == interpreted);
+}
+
+static Ref<GDScript> _make_script(const String &p_source) {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(p_source);
+	const Error error = gdscript->reload();
+	CHECK(error == OK);
+	return gdscript;
+}
+
+TEST_CASE("[Modules][GDScript] Lambdas that don't escape give the same results") {
+	Ref<GDScript> gdscript = _make_script(R"(
+extends RefCounted
+
+var offset := 10
+
+func direct(n: int) -> int:
+	var add := func(a: int, b: int) -> int: return a + b + offset
+	var total := 0
+	for i in n:
+		total = add.call(total, i)
+	return total
+
+func escaping() -> Callable:
+	var twice := func(x): return x * 2
+	twice.call(1)
+	return twice
+
+func reassigned() -> int:
+	var f := func(): return 1
+	f = func(): return 2
+	return f.call()
+
+func captured(n: int) -> int:
+	var square := func(x): return x * x
+	var apply := func(): return square.call(n)
+	return apply.call()
+
+func typed_temporaries(n: int) -> Array:
+	var text := "value: "
+	var position := Vector2(1, 2) * n
+	return [text + str(n), position.x + position.y, float(n) / 2.0]
+)");
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	CHECK(ref_counted->call("direct", 4) == Variant(46));
+	const Callable twice = ref_counted->call("escaping");
+	CHECK(twice.call(21) == Variant(42));
+	CHECK(ref_counted->call("reassigned") == Variant(2));
+	CHECK(ref_counted->call("captured", 5) == Variant(25));
+
+	const Array temporaries = ref_counted->call("typed_temporaries", 3);
+	CHECK(temporaries[0] == Variant("value: 3"));
+	CHECK(temporaries[1] == Variant(9.0));
+	CHECK(temporaries[2] == Variant(1.5));
+}
+
+TEST_CASE("[Modules][GDScript] Inline caches follow the receiver and script reloads") {
+	Ref<GDScript> caller = _make_script(R"(
+extends RefCounted
+
+func probe(target):
+	target.value = target.value + 1
+	return [target.value, target.describe()]
+
+func probe_native(target):
+	target.resource_name = target.resource_name + "x"
+	return [target.resource_name, target.get_class()]
+)");
+	const String first_source = R"(
+extends RefCounted
+var value = 10
+func describe():
+	return "first"
+)";
+	Ref<GDScript> first_script = _make_script(first_source);
+	Ref<GDScript> second_script = _make_script(R"(
+extends RefCounted
+var other = 0
+var value = 20
+func describe():
+	return "second"
+)");
+
+	Ref<RefCounted> probe = memnew(RefCounted);
+	probe->set_script(caller);
+	Ref<RefCounted> first = memnew(RefCounted);
+	first->set_script(first_script);
+	Ref<RefCounted> second = memnew(RefCounted);
+	second->set_script(second_script);
+
+	// Polymorphic sites, with members at different indices.
+	for (int i = 1; i <= 3; i++) {
+		CHECK(probe->call("probe", first) == Variant(varray(10 + i, "first")));
+		CHECK(probe->call("probe", second) == Variant(varray(20 + i, "second")));
+	}
+
+	Ref<Resource> resource = memnew(Resource);
+	CHECK(probe->call("probe_native", resource) == Variant(varray("x", "Resource")));
+	CHECK(probe->call("probe_native", resource) == Variant(varray("xx", "Resource")));
+
+	// The script keeps its address across reloads, but not its members and functions.
+	first.unref();
+	first_script->set_source_code(R"(
+extends RefCounted
+var extra = 5
+var value = 100
+func describe():
+	return "reloaded"
+)");
+	REQUIRE(first_script->reload() == OK);
+	first.instantiate();
+	first->set_script(first_script);
+	CHECK(probe->call("probe", first) == Variant(varray(101, "reloaded")));
+	CHECK(probe->call("probe", second) == Variant(varray(24, "second")));
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache gives the same results as the source") {
+	const String script_path = OS::get_singleton()->get_cache_path().path_join("test_bytecode_cache.gd");
+	const String cache_path = GDScriptBytecodeCache::get_cache_path(script_path);
+
+	Ref<GDScript> compiled = memnew(GDScript);
+	compiled->set_path(script_path);
+	compiled->set_source_code(R"(
+extends RefCounted
+
+const PRIMES: Array[int] = [2, 3, 5, 7]
+const NAMES = { "a": 1, "b": 2 }
+
+class Accumulator:
+	var total := 0
+
+	func add(value: int) -> void:
+		total += value
+
+static func compute(n: int) -> Array:
+	assert(absi(n) == n, "Negative: %d" % n)
+	var accumulator := Accumulator.new()
+	for i in n:
+		accumulator.add(i * PRIMES[i % PRIMES.size()])
+	var double := func(value: int) -> int: return value * 2
+	var text := str(accumulator.total).pad_zeros(6)
+	var vector := Vector2(n, 1.5)
+	var object := RefCounted.new()
+	return [double.call(accumulator.total), text, vector.length(), NAMES["b"], absi(-n), object.get_class()]
+)");
+	REQUIRE(compiled->reload() == OK);
+
+	Vector<uint8_t> data;
+	REQUIRE(GDScriptBytecodeCache::save_script(compiled, data) == OK);
+	{
+		Ref<FileAccess> file = FileAccess::open(cache_path, FileAccess::WRITE);
+		REQUIRE(file.is_valid());
+		file->store_buffer(data);
+	}
+
+	Ref<GDScript> loaded = memnew(GDScript);
+	loaded->set_path(script_path, true);
+	CHECK(GDScriptBytecodeCache::load_script(loaded.ptr()) == OK);
+	CHECK(loaded->is_valid());
+	CHECK(loaded->get_subclasses().has("Accumulator"));
+	CHECK(loaded->call("compute", 11) == compiled->call("compute", 11));
+
+	// A cache that breaks partway leaves nothing behind for the compiler.
+	{
+		Ref<FileAccess> file = FileAccess::open(cache_path, FileAccess::WRITE);
+		file->store_buffer(data.slice(0, data.size() - 16));
+	}
+	Ref<GDScript> truncated = memnew(GDScript);
+	truncated->set_path(script_path, true);
+	ERR_PRINT_OFF;
+	CHECK(GDScriptBytecodeCache::load_script(truncated.ptr()) != OK);
+	ERR_PRINT_ON;
+	CHECK_FALSE(truncated->is_valid());
+	CHECK(truncated->get_member_functions().is_empty());
+	HashMap<StringName, Variant> truncated_constants;
+	truncated->get_constants(&truncated_constants);
+	CHECK(truncated_constants.is_empty());
+
+	// A cache from another build is rejected, so the script gets compiled from source instead.
+	data.write[4] += 1;
+	{
+		Ref<FileAccess> file = FileAccess::open(cache_path, FileAccess::WRITE);
+		file->store_buffer(data);
+	}
+	Ref<GDScript> outdated = memnew(GDScript);
+	outdated->set_path(script_path, true);
+	CHECK(GDScriptBytecodeCache::load_script(outdated.ptr()) != OK);
+	CHECK_FALSE(outdated->is_valid());
+
+	DirAccess::remove_absolute(cache_path);
+}
+
+TEST_CASE("[Modules][GDScript] Scripts parsed in parallel load like the ones parsed on demand") {
+	const String base_dir = OS::get_singleton()->get_cache_path();
+	const String base_path = base_dir.path_join("test_parse_scripts_base.gd");
+	const String derived_path = base_dir.path_join("test_parse_scripts_derived.gd");
+	const String edited_path = base_dir.path_join("test_parse_scripts_edited.gd");
+	const String sources[3] = {
+		"extends RefCounted\n\nfunc value() -> int:\n\treturn 2\n",
+		"extends \"" + base_path + "\"\n\nfunc value() -> int:\n\treturn super() * 21\n",
+		"extends RefCounted\n\nfunc value() -> int:\n\treturn 1\n",
+	};
+	const String paths[3] = { base_path, derived_path, edited_path };
+	for (int i = 0; i < 3; i++) {
+		Ref<FileAccess> file = FileAccess::open(paths[i], FileAccess::WRITE);
+		REQUIRE(file.is_valid());
+		file->store_string(sources[i]);
+	}
+
+	GDScriptCache::parse_scripts(Vector<String>({ base_path, derived_path, edited_path }));
+
+	// A file changed after it was parsed is parsed again on load.
+	{
+		Ref<FileAccess> file = FileAccess::open(edited_path, FileAccess::WRITE);
+		file->store_string("extends RefCounted\n\nfunc value() -> int:\n\treturn 3\n");
+	}
+
+	Error err = OK;
+	Ref<GDScript> derived = GDScriptCache::get_full_script(derived_path, err);
+	REQUIRE(err == OK);
+	Ref<GDScript> edited = GDScriptCache::get_full_script(edited_path, err);
+	REQUIRE(err == OK);
+
+	Ref<RefCounted> derived_instance = memnew(RefCounted);
+	derived_instance->set_script(derived);
+	CHECK(derived_instance->call("value") == Variant(42));
+	Ref<RefCounted> edited_instance = memnew(RefCounted);
+	edited_instance->set_script(edited);
+	CHECK(edited_instance->call("value") == Variant(3));
+
+	// Every tree made ahead of time was either used or dropped.
+	CHECK(GDScriptCache::take_preparsed(base_path, sources[0]).is_null());
+	CHECK(GDScriptCache::take_preparsed(derived_path, sources[1]).is_null());
+
+	// Unclaimed trees are dropped on request.
+	GDScriptCache::remove_script(base_path);
+	GDScriptCache::parse_scripts(Vector<String>({ base_path }));
+	GDScriptCache::discard_preparsed();
+	CHECK(GDScriptCache::take_preparsed(base_path, sources[0]).is_null());
+
+	for (int i = 0; i < 3; i++) {
+		GDScriptCache::remove_script(paths[i]);
+		DirAccess::remove_absolute(paths[i]);
+	}
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][GDScript] Sampling profiler folds script and native frames") {
+	Ref<GDScript> gdscript = _make_script(R"(
+extends RefCounted
+
+func outer():
+	inner()
+
+func inner():
+	OS.delay_msec(50)
+)");
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	GDScriptSamplingProfiler::clear();
+	GDScriptSamplingProfiler::start(1000);
+	ref_counted->call("outer");
+	GDScriptSamplingProfiler::stop();
+
+	CHECK(GDScriptSamplingProfiler::get_sample_count() > 0);
+	const String folded = GDScriptSamplingProfiler::get_folded_stacks();
+	CHECK(folded.contains("Main Thread;:outer;:inner;OS.delay_msec "));
+
+	// Calls after stopping aren't sampled.
+	const uint64_t sample_count = GDScriptSamplingProfiler::get_sample_count();
+	ref_counted->call("outer");
+	CHECK(GDScriptSamplingProfiler::get_sample_count() == sample_count);
+	GDScriptSamplingProfiler::clear();
+}
+#endif
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,66 @@
+# Typed operators can write straight into locals, and comparisons can be fused with
+# the jump of `if` and `while`. Results must match the unfused bytecode.
+
+func sum_of_squares(n: int) -> int:
+	var total: int = 0
+	var i: int = 0
+	while i < n:
+		total = total + i * i
+		i += 1
+	return total
+
+func test():
+	# The declaration assigns the first value, later assignments may be forwarded.
+	var x: int = 3 + 4
+	print(x)
+	x = x * x + x
+	print(x)
+	x -= 6
+	print(x)
+
+	var f: float = 1.5
+	f = f * 2.0 - 0.5
+	print(f)
+
+	var v := Vector2(1, 2)
+	v = v * 2.0 + Vector2(0.5, 0.5)
+	print(v)
+
+	# The target is also an operand. Array operators write their result before reading the operands.
+	var arr: Array = [1]
+	arr = arr + [2]
+	print(arr)
+	var other: Array = [0]
+	arr = other + arr
+	print(arr)
+
+	var p := PackedInt32Array([1, 2])
+	var q := PackedInt32Array([3])
+	p = q + p
+	print(p)
+	p = p + q
+	print(p)
+
+	# Loop variables are declared again on every iteration.
+	for i in 3:
+		var y: int = i * 10
+		y = y + i
+		print(y)
+
+	print(sum_of_squares(10))
+
+	var a := 5
+	var b := 7
+	if a < b:
+		print("a < b")
+	if a > b:
+		print("a > b")
+	else:
+		print("not a > b")
+	if not (a == b):
+		print("a != b")
+
+	var count := 0
+	while count * 2 < 9:
+		count += 1
+	print(count)
@@ -42,6 +42,21 @@ Object *MultiplayerSynchronizer::_get_prop_target(Object *p_obj, const NodePath
 	return node->get_node(p_path);
 }
 
+Object *MultiplayerSynchronizer::_get_accessor_target(Object *p_obj, const NodePath &p_prop, LocalVector<NodePathAccessor> &r_accessors, uint32_t p_index) {
+	NodePathAccessor &accessor = r_accessors[p_index];
+	if (accessor.get_path() != p_prop) {
+		accessor.set_path(p_prop);
+	}
+	if (p_prop.get_name_count() == 0) {
+		return p_obj;
+	}
+	Node *node = Object::cast_to<Node>(p_obj);
+	ERR_FAIL_NULL_V_MSG(node, nullptr, vformat("Node '%s' not found.", p_prop));
+	Node *target = accessor.get_target(node);
+	ERR_FAIL_NULL_V_MSG(target, nullptr, vformat("Node '%s' not found.", p_prop));
+	return target;
+}
+
 void MultiplayerSynchronizer::_stop() {
 #ifdef TOOLS_ENABLED
 	if (Engine::get_singleton()->is_editor_hint()) {
@@ -153,16 +168,25 @@ PackedStringArray MultiplayerSynchronizer::get_configuration_warnings() const {
 	return warnings;
 }
 
-Error MultiplayerSynchronizer::get_state(const List<NodePath> &p_properties, Object *p_obj, Vector<Variant> &r_variant, Vector<const Variant *> &r_variant_ptrs) {
+Error MultiplayerSynchronizer::get_state(const List<NodePath> &p_properties, Object *p_obj, Vector<Variant> &r_variant, Vector<const Variant *> &r_variant_ptrs, LocalVector<NodePathAccessor> *r_accessors) {
 	ERR_FAIL_NULL_V(p_obj, ERR_INVALID_PARAMETER);
 	r_variant.resize(p_properties.size());
 	r_variant_ptrs.resize(r_variant.size());
+	if (r_accessors) {
+		r_accessors->resize(p_properties.size());
+	}
 	int i = 0;
 	for (const NodePath &prop : p_properties) {
 		bool valid = false;
-		const Object *obj = _get_prop_target(p_obj, prop);
-		ERR_FAIL_NULL_V(obj, FAILED);
-		r_variant.write[i] = obj->get_indexed(prop.get_subnames(), &valid);
+		if (r_accessors) {
+			Object *obj = _get_accessor_target(p_obj, prop, *r_accessors, i);
+			ERR_FAIL_NULL_V(obj, FAILED);
+			r_variant.write[i] = (*r_accessors)[i].get(obj, &valid);
+		} else {
+			const Object *obj = _get_prop_target(p_obj, prop);
+			ERR_FAIL_NULL_V(obj, FAILED);
+			r_variant.write[i] = obj->get_indexed(prop.get_subnames(), &valid);
+		}
 		r_variant_ptrs.write[i] = &r_variant[i];
 		ERR_FAIL_COND_V_MSG(!valid, ERR_INVALID_DATA, vformat("Property '%s' not found.", prop));
 		i++;
@@ -170,13 +194,22 @@ Error MultiplayerSynchronizer::get_state(const List<NodePath> &p_properties, Obj
 	return OK;
 }
 
-Error MultiplayerSynchronizer::set_state(const List<NodePath> &p_properties, Object *p_obj, const Vector<Variant> &p_state) {
+Error MultiplayerSynchronizer::set_state(const List<NodePath> &p_properties, Object *p_obj, const Vector<Variant> &p_state, LocalVector<NodePathAccessor> *r_accessors) {
 	ERR_FAIL_NULL_V(p_obj, ERR_INVALID_PARAMETER);
+	if (r_accessors) {
+		r_accessors->resize(p_properties.size());
+	}
 	int i = 0;
 	for (const NodePath &prop : p_properties) {
-		Object *obj = _get_prop_target(p_obj, prop);
-		ERR_FAIL_NULL_V(obj, FAILED);
-		obj->set_indexed(prop.get_subnames(), p_state[i]);
+		if (r_accessors) {
+			Object *obj = _get_accessor_target(p_obj, prop, *r_accessors, i);
+			ERR_FAIL_NULL_V(obj, FAILED);
+			(*r_accessors)[i].set(obj, p_state[i]);
+		} else {
+			Object *obj = _get_prop_target(p_obj, prop);
+			ERR_FAIL_NULL_V(obj, FAILED);
+			obj->set_indexed(prop.get_subnames(), p_state[i]);
+		}
 		i += 1;
 	}
 	return OK;
@@ -385,11 +418,14 @@ Error MultiplayerSynchronizer::_watch_changes(uint64_t p_usec) {
 	for (const NodePath &prop : props) {
 		idx++;
 		bool valid = false;
-		const Object *obj = _get_prop_target(node, prop);
+		Watcher &w = ptr[idx];
+		if (w.accessor.get_path() != prop) {
+			w.accessor.set_path(prop);
+		}
+		Node *obj = w.accessor.get_target(node);
 		ERR_CONTINUE_MSG(!obj, vformat("Node not found for property '%s'.", prop));
-		Variant v = obj->get_indexed(prop.get_subnames(), &valid);
+		Variant v = w.accessor.get(obj, &valid);
 		ERR_CONTINUE_MSG(!valid, vformat("Property '%s' not found.", prop));
-		Watcher &w = ptr[idx];
 		if (w.prop != prop) {
 			w.prop = prop;
 			w.value = v.duplicate(true);
@@ -34,6 +34,7 @@
 #include "scene_replication_config.h"
 
 #include "scene/main/node.h"
+#include "scene/main/node_path_accessor.h"
 
 class MultiplayerSynchronizer : public Node {
 	GDCLASS(MultiplayerSynchronizer, Node);
@@ -48,6 +49,7 @@ public:
 private:
 	struct Watcher {
 		NodePath prop;
+		NodePathAccessor accessor;
 		uint64_t last_change_usec = 0;
 		Variant value;
 	};
@@ -60,6 +62,7 @@ private:
 	HashSet<Callable> visibility_filters;
 	HashSet<int> peer_visibility;
 	Vector<Watcher> watchers;
+	LocalVector<NodePathAccessor> sync_accessors;
 	uint64_t last_watch_usec = 0;
 
 	ObjectID root_node_cache;
@@ -69,6 +72,7 @@ private:
 	bool sync_started = false;
 
 	static Object *_get_prop_target(Object *p_obj, const NodePath &p_prop);
+	static Object *_get_accessor_target(Object *p_obj, const NodePath &p_prop, LocalVector<NodePathAccessor> &r_accessors, uint32_t p_index);
 	void _start();
 	void _stop();
 	void _update_process();
@@ -79,8 +83,10 @@ protected:
 	void _notification(int p_what);
 
 public:
-	static Error get_state(const List<NodePath> &p_properties, Object *p_obj, Vector<Variant> &r_variant, Vector<const Variant *> &r_variant_ptrs);
-	static Error set_state(const List<NodePath> &p_properties, Object *p_obj, const Vector<Variant> &p_state);
+	// When r_accessors is given, it caches the resolved targets and property binds across calls.
+	static Error get_state(const List<NodePath> &p_properties, Object *p_obj, Vector<Variant> &r_variant, Vector<const Variant *> &r_variant_ptrs, LocalVector<NodePathAccessor> *r_accessors = nullptr);
+	static Error set_state(const List<NodePath> &p_properties, Object *p_obj, const Vector<Variant> &p_state, LocalVector<NodePathAccessor> *r_accessors = nullptr);
+	LocalVector<NodePathAccessor> *get_sync_accessors() { return &sync_accessors; }
 
 	void reset();
 	Node *get_root_node();
@@ -661,7 +661,7 @@ bool AnimationMixer::_update_caches() {
 							track_value->is_using_angle = false;
 						}
 
-						track_value->subpath = leftover_path;
+						track_value->subpath.set_names(leftover_path);
 
 						track = track_value;
 
@@ -1413,7 +1413,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 							value = post_process_key_value(a, i, value, t->object_id);
 							Object *t_obj = ObjectDB::get_instance(t->object_id);
 							if (t_obj) {
-								t_obj->set_indexed(t->subpath, value);
+								t->subpath.set(t_obj, value);
 							}
 						} else {
 							List<int> indices;
@@ -1423,7 +1423,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 								value = post_process_key_value(a, i, value, t->object_id);
 								Object *t_obj = ObjectDB::get_instance(t->object_id);
 								if (t_obj) {
-									t_obj->set_indexed(t->subpath, value);
+									t->subpath.set(t_obj, value);
 								}
 							}
 						}
@@ -1697,7 +1697,7 @@ void AnimationMixer::_blend_apply() {
 
 				Object *t_obj = ObjectDB::get_instance(t->object_id);
 				if (t_obj) {
-					t_obj->set_indexed(t->subpath, Animation::cast_from_blendwise(t->value, t->init_value.get_type()));
+					t->subpath.set(t_obj, Animation::cast_from_blendwise(t->value, t->init_value.get_type()));
 				}
 
 			} break;
@@ -1914,7 +1914,7 @@ void AnimationMixer::_build_backup_track_cache() {
 				TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
 				Object *t_obj = ObjectDB::get_instance(t->object_id);
 				if (t_obj) {
-					t->value = t_obj->get_indexed(t->subpath);
+					t->value = t->subpath.get(t_obj);
 				}
 				t->is_continuous = true;
 			} break;
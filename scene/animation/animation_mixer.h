@@ -31,6 +31,7 @@
 #ifndef ANIMATION_MIXER_H
 #define ANIMATION_MIXER_H
 
+#include "core/object/property_accessor.h"
 #include "scene/main/node.h"
 #include "scene/resources/animation.h"
 #include "scene/resources/animation_library.h"
@@ -213,7 +214,7 @@ protected:
 	struct TrackCacheValue : public TrackCache {
 		Variant init_value;
 		Variant value;
-		Vector<StringName> subpath;
+		PropertyAccessor subpath;
 		bool is_continuous = false;
 		bool is_using_angle = false;
 		Variant element_size;
@@ -31,6 +31,7 @@
 #ifndef TWEEN_H
 #define TWEEN_H
 
+#include "core/object/property_accessor.h"
 #include "core/object/ref_counted.h"
 
 class Tween;
@@ -211,7 +212,7 @@ protected:
 
 private:
 	ObjectID target;
-	Vector<StringName> property;
+	PropertyAccessor property;
 	Variant initial_val;
 	Variant base_final_val;
 	Variant final_val;
@@ -0,0 +1,70 @@
+/**************************************************************************/
+/*  node_path_accessor.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "node_path_accessor.h"
+
+#include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+
+void NodePathAccessor::set_path(const NodePath &p_path) {
+	path = p_path;
+	node_path = NodePath(p_path.get_names(), p_path.is_absolute());
+	property.set_names(p_path.get_subnames());
+	from = ObjectID();
+	target = ObjectID();
+}
+
+Node *NodePathAccessor::get_target(Node *p_from) {
+	ERR_FAIL_NULL_V(p_from, nullptr);
+
+	if (path.get_name_count() == 0) {
+		return p_from;
+	}
+
+	SceneTree *tree = p_from->is_inside_tree() ? p_from->get_tree() : nullptr;
+	if (tree && from == p_from->get_instance_id() && tree_version == tree->get_tree_version()) {
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(target));
+		if (node) {
+			return node;
+		}
+	}
+
+	Node *node = p_from->get_node_or_null(node_path);
+	if (tree) {
+		from = p_from->get_instance_id();
+		target = node ? node->get_instance_id() : ObjectID();
+		tree_version = tree->get_tree_version();
+	}
+	return node;
+}
+
+NodePathAccessor::NodePathAccessor(const NodePath &p_path) {
+	set_path(p_path);
+}
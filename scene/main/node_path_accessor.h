@@ -0,0 +1,65 @@
+/**************************************************************************/
+/*  node_path_accessor.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NODE_PATH_ACCESSOR_H
+#define NODE_PATH_ACCESSOR_H
+
+#include "core/object/property_accessor.h"
+#include "core/string/node_path.h"
+
+class Node;
+
+// A node path with property subnames (like "Sprite2D:position:x"), relative to a node, for
+// repeated access. While the nodes are inside the tree, the target node is only looked up again
+// after the scene tree changed.
+class NodePathAccessor {
+	NodePath path;
+	NodePath node_path; // Without the subnames.
+	PropertyAccessor property;
+
+	ObjectID from;
+	ObjectID target;
+	uint64_t tree_version = 0;
+
+public:
+	void set_path(const NodePath &p_path);
+	_FORCE_INLINE_ const NodePath &get_path() const { return path; }
+
+	Node *get_target(Node *p_from);
+
+	// p_target is the object returned by get_target().
+	_FORCE_INLINE_ Variant get(Object *p_target, bool *r_valid = nullptr) { return property.get(p_target, r_valid); }
+	_FORCE_INLINE_ void set(Object *p_target, const Variant &p_value, bool *r_valid = nullptr) { property.set(p_target, p_value, r_valid); }
+
+	NodePathAccessor() {}
+	NodePathAccessor(const NodePath &p_path);
+};
+
+#endif // NODE_PATH_ACCESSOR_H
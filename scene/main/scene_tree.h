@@ -379,6 +379,8 @@ public:
 	int64_t get_frame() const;
 
 	int get_node_count() const;
+	// Changes whenever nodes are added, removed, moved or renamed.
+	uint64_t get_tree_version() const { return tree_version; }
 
 	void queue_delete(Object *p_object);
 
@@ -156,6 +156,7 @@ void PhysicsServer2DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_space_get_param, "space", "param");
 
 	GDVIRTUAL_BIND(_space_get_direct_state, "space");
+	GDVIRTUAL_BIND(_space_get_state_hash, "space");
 
 	GDVIRTUAL_BIND(_space_set_debug_contacts, "space", "max_contacts");
 	GDVIRTUAL_BIND(_space_get_contacts, "space");
@@ -232,6 +232,7 @@ public:
 	EXBIND2RC(real_t, space_get_param, RID, SpaceParameter)
 
 	EXBIND1R(PhysicsDirectSpaceState2D *, space_get_direct_state, RID)
+	EXBIND1RC(uint32_t, space_get_state_hash, RID)
 
 	EXBIND2(space_set_debug_contacts, RID, int)
 	EXBIND1RC(Vector<Vector2>, space_get_contacts, RID)
@@ -167,6 +167,8 @@ void PhysicsServer3DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_space_get_contacts, "space");
 	GDVIRTUAL_BIND(_space_get_contact_count, "space");
 
+	GDVIRTUAL_BIND(_space_rebuild_static_broadphase, "space", "layout");
+
 	/* AREA API */
 
 	GDVIRTUAL_BIND(_area_create);
@@ -50,6 +50,15 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual SortKey get_sort_key() const override {
+		SortKey key;
+		key.ids[0] = area->get_self().get_id();
+		key.ids[1] = body->get_self().get_id();
+		key.subindices[0] = area_shape;
+		key.subindices[1] = body_shape;
+		return key;
+	}
+
 	GodotAreaPair2D(GodotBody2D *p_body, int p_body_shape, GodotArea2D *p_area, int p_area_shape);
 	~GodotAreaPair2D();
 };
@@ -71,6 +80,15 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual SortKey get_sort_key() const override {
+		SortKey key;
+		key.ids[0] = area_a->get_self().get_id();
+		key.ids[1] = area_b->get_self().get_id();
+		key.subindices[0] = shape_a;
+		key.subindices[1] = shape_b;
+		return key;
+	}
+
 	GodotArea2Pair2D(GodotArea2D *p_area_a, int p_shape_a, GodotArea2D *p_area_b, int p_shape_b);
 	~GodotArea2Pair2D();
 };
@@ -34,6 +34,28 @@
 #include "godot_body_direct_state_2d.h"
 #include "godot_space_2d.h"
 
+// Fixed-point integration of deterministic spaces works on a 16.16 grid.
+#define FIXED_POINT_FRACTION_BITS 16
+
+static _FORCE_INLINE_ int64_t _to_fixed(real_t p_value) {
+	return (int64_t)Math::round((double)p_value * (1 << FIXED_POINT_FRACTION_BITS));
+}
+
+static _FORCE_INLINE_ real_t _from_fixed(int64_t p_value) {
+	return (real_t)((double)p_value / (1 << FIXED_POINT_FRACTION_BITS));
+}
+
+static _FORCE_INLINE_ int64_t _mul_fixed(int64_t p_a, int64_t p_b) {
+	// Round half away from zero. A plain shift rounds toward negative infinity, which would bias motion toward -x and -y.
+	const int64_t product = p_a * p_b;
+	const int64_t half = int64_t(1) << (FIXED_POINT_FRACTION_BITS - 1);
+	return product >= 0 ? (product + half) >> FIXED_POINT_FRACTION_BITS : -((half - product) >> FIXED_POINT_FRACTION_BITS);
+}
+
+static _FORCE_INLINE_ real_t _snap_fixed(real_t p_value) {
+	return _from_fixed(_to_fixed(p_value));
+}
+
 void GodotBody2D::_mass_properties_changed() {
 	if (get_space() && !mass_properties_update_list.in_list()) {
 		get_space()->body_add_to_mass_properties_update_list(&mass_properties_update_list);
@@ -590,6 +612,11 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 
 			linear_velocity += _inv_mass * force * p_step;
 			angular_velocity += _inv_inertia * torque * p_step;
+
+			if (get_space()->is_fixed_point_integration_enabled()) {
+				linear_velocity = Vector2(_snap_fixed(linear_velocity.x), _snap_fixed(linear_velocity.y));
+				angular_velocity = _snap_fixed(angular_velocity);
+			}
 		}
 
 		if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
@@ -632,13 +659,32 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	real_t total_angular_velocity = angular_velocity + biased_angular_velocity;
 	Vector2 total_linear_velocity = linear_velocity + biased_linear_velocity;
 
-	real_t angle_delta = total_angular_velocity * p_step;
-	real_t angle = get_transform().get_rotation() + angle_delta;
-	Vector2 pos = get_transform().get_origin() + total_linear_velocity * p_step;
+	real_t angle_delta;
+	real_t angle;
+	Vector2 pos;
+	const bool fixed_point = get_space()->is_fixed_point_integration_enabled();
+
+	if (fixed_point) {
+		// Advance on the fixed-point grid with integer arithmetic, so rounding can't make runs drift apart.
+		const int64_t step = _to_fixed(p_step);
+		const int64_t fixed_angle_delta = _mul_fixed(_to_fixed(total_angular_velocity), step);
+		const Vector2 origin = get_transform().get_origin();
+		angle_delta = _from_fixed(fixed_angle_delta);
+		angle = _from_fixed(_to_fixed(get_transform().get_rotation()) + fixed_angle_delta);
+		pos.x = _from_fixed(_to_fixed(origin.x) + _mul_fixed(_to_fixed(total_linear_velocity.x), step));
+		pos.y = _from_fixed(_to_fixed(origin.y) + _mul_fixed(_to_fixed(total_linear_velocity.y), step));
+	} else {
+		angle_delta = total_angular_velocity * p_step;
+		angle = get_transform().get_rotation() + angle_delta;
+		pos = get_transform().get_origin() + total_linear_velocity * p_step;
+	}
 
 	if (center_of_mass.length_squared() > CMP_EPSILON2) {
 		// Calculate displacement due to center of mass offset.
 		pos += center_of_mass - center_of_mass.rotated(angle_delta);
+		if (fixed_point) {
+			pos = Vector2(_snap_fixed(pos.x), _snap_fixed(pos.y));
+		}
 	}
 
 	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
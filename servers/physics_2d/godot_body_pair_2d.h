@@ -94,6 +94,15 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual SortKey get_sort_key() const override {
+		SortKey key;
+		key.ids[0] = A->get_self().get_id();
+		key.ids[1] = B->get_self().get_id();
+		key.subindices[0] = shape_A;
+		key.subindices[1] = shape_B;
+		return key;
+	}
+
 	GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B);
 	~GodotBodyPair2D();
 };
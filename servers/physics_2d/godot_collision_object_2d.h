@@ -52,6 +52,7 @@ private:
 	ObjectID instance_id;
 	ObjectID canvas_instance_id;
 	bool pickable = true;
+	uint64_t space_order = 0; // When this object was added to its space, relative to the others.
 
 	struct Shape {
 		Transform2D xform;
@@ -105,6 +106,9 @@ public:
 	_FORCE_INLINE_ void set_canvas_instance_id(const ObjectID &p_canvas_instance_id) { canvas_instance_id = p_canvas_instance_id; }
 	_FORCE_INLINE_ ObjectID get_canvas_instance_id() const { return canvas_instance_id; }
 
+	_FORCE_INLINE_ void set_space_order(uint64_t p_order) { space_order = p_order; }
+	_FORCE_INLINE_ uint64_t get_space_order() const { return space_order; }
+
 	void _shape_changed() override;
 
 	_FORCE_INLINE_ Type get_type() const { return type; }
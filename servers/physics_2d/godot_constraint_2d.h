@@ -48,6 +48,32 @@ protected:
 	}
 
 public:
+	// Identifies a constraint independently of when it was created, the deterministic mode solves islands in this order.
+	struct SortKey {
+		uint64_t ids[2] = {};
+		int subindices[2] = {};
+
+		bool operator<(const SortKey &p_other) const {
+			for (int i = 0; i < 2; i++) {
+				if (ids[i] != p_other.ids[i]) {
+					return ids[i] < p_other.ids[i];
+				}
+			}
+			for (int i = 0; i < 2; i++) {
+				if (subindices[i] != p_other.subindices[i]) {
+					return subindices[i] < p_other.subindices[i];
+				}
+			}
+			return false;
+		}
+	};
+
+	virtual SortKey get_sort_key() const {
+		SortKey key;
+		key.ids[0] = self.get_id();
+		return key;
+	}
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
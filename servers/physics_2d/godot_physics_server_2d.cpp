@@ -284,6 +284,13 @@ PhysicsDirectSpaceState2D *GodotPhysicsServer2D::space_get_direct_state(RID p_sp
 	return space->get_direct_state();
 }
 
+uint32_t GodotPhysicsServer2D::space_get_state_hash(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, 0);
+
+	return space->get_state_hash();
+}
+
 RID GodotPhysicsServer2D::area_create() {
 	GodotArea2D *area = memnew(GodotArea2D);
 	RID rid = area_owner.make_rid(area);
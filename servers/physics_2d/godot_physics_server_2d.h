@@ -119,6 +119,8 @@ public:
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override;
 
+	virtual uint32_t space_get_state_hash(RID p_space) const override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
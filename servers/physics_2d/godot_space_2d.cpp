@@ -1077,6 +1077,7 @@ GodotBroadPhase2D *GodotSpace2D::get_broadphase() {
 void GodotSpace2D::add_object(GodotCollisionObject2D *p_object) {
 	ERR_FAIL_COND(objects.has(p_object));
 	objects.insert(p_object);
+	p_object->set_space_order(next_object_order++);
 }
 
 void GodotSpace2D::remove_object(GodotCollisionObject2D *p_object) {
@@ -1211,6 +1212,38 @@ bool GodotSpace2D::is_locked() const {
 	return locked;
 }
 
+uint32_t GodotSpace2D::get_state_hash() const {
+	// RIDs differ between processes, so bodies are identified by the order they were added to the space.
+	struct BodySort {
+		bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const {
+			return p_a->get_space_order() < p_b->get_space_order();
+		}
+	};
+
+	LocalVector<GodotBody2D *> bodies;
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.push_back(static_cast<GodotBody2D *>(E));
+		}
+	}
+	bodies.sort_custom<BodySort>();
+
+	uint32_t hash = HASH_MURMUR3_SEED;
+	for (const GodotBody2D *body : bodies) {
+		const Transform2D &transform = body->get_transform();
+		for (int i = 0; i < 3; i++) {
+			hash = hash_murmur3_one_real(transform.columns[i].x, hash);
+			hash = hash_murmur3_one_real(transform.columns[i].y, hash);
+		}
+		const Vector2 linear_velocity = body->get_linear_velocity();
+		hash = hash_murmur3_one_real(linear_velocity.x, hash);
+		hash = hash_murmur3_one_real(linear_velocity.y, hash);
+		hash = hash_murmur3_one_real(body->get_angular_velocity(), hash);
+		hash = hash_murmur3_one_32(body->is_active(), hash);
+	}
+	return hash_fmix32(hash);
+}
+
 GodotPhysicsDirectSpaceState2D *GodotSpace2D::get_direct_state() {
 	return direct_access;
 }
@@ -1225,6 +1258,8 @@ GodotSpace2D::GodotSpace2D() {
 	contact_max_allowed_penetration = GLOBAL_GET("physics/2d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/2d/solver/default_contact_bias");
 	constraint_bias = GLOBAL_GET("physics/2d/solver/default_constraint_bias");
+	deterministic = GLOBAL_GET("physics/2d/solver/deterministic");
+	fixed_point_integration = deterministic && bool(GLOBAL_GET("physics/2d/solver/fixed_point_integration"));
 
 	broadphase = GodotBroadPhase2D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
@@ -93,6 +93,7 @@ private:
 	static void _broadphase_unpair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_data, void *p_self);
 
 	HashSet<GodotCollisionObject2D *> objects;
+	uint64_t next_object_order = 0;
 
 	GodotArea2D *area = nullptr;
 
@@ -115,6 +116,9 @@ private:
 	real_t body_angular_velocity_sleep_threshold = 0.0;
 	real_t body_time_to_sleep = 0.0;
 
+	bool deterministic = false;
+	bool fixed_point_integration = false;
+
 	bool locked = false;
 
 	real_t last_step = 0.001;
@@ -167,6 +171,8 @@ public:
 	_FORCE_INLINE_ real_t get_body_linear_velocity_sleep_threshold() const { return body_linear_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
+	_FORCE_INLINE_ bool is_fixed_point_integration_enabled() const { return fixed_point_integration; }
 
 	void update();
 	void setup();
@@ -190,6 +196,8 @@ public:
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	uint32_t get_state_hash() const;
+
 	bool test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::MotionParameters &p_parameters, PhysicsServer2D::MotionResult *r_result);
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
@@ -39,6 +39,18 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+struct _BodySort {
+	bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const {
+		return p_a->get_self().get_id() < p_b->get_self().get_id();
+	}
+};
+
+struct _ConstraintSort {
+	bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const {
+		return p_a->get_sort_key() < p_b->get_sort_key();
+	}
+};
+
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -137,21 +149,31 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	const SelfList<GodotBody2D>::List *body_list = &p_space->get_active_body_list();
 
+	// In deterministic mode, bodies are processed in RID order instead of activation order and constraints
+	// are solved in a fixed order on this thread, so the result doesn't depend on the history of the space
+	// or on the number of worker threads.
+	const bool deterministic = p_space->is_deterministic();
+
+	active_bodies.clear();
+	const SelfList<GodotBody2D> *b = body_list->first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+	if (deterministic) {
+		active_bodies.sort_custom<_BodySort>();
+	}
+
 	/* INTEGRATE FORCES */
 
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
-
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	for (GodotBody2D *body : active_bodies) {
+		body->integrate_forces(p_delta);
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects(active_bodies.size());
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -192,13 +214,9 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
-
 	uint32_t body_island_count = 0;
 
-	while (b) {
-		GodotBody2D *body = b->self();
-
+	for (GodotBody2D *body : active_bodies) {
 		if (body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -224,9 +242,10 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 			if (constraint_island.is_empty()) {
 				--island_count;
+			} else if (deterministic) {
+				constraint_island.sort_custom<_ConstraintSort>();
 			}
 		}
-		b = b->next();
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -239,9 +258,17 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
-	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (deterministic) {
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			for (GodotConstraint2D *constraint : constraint_islands[island_index]) {
+				constraint->setup(delta);
+			}
+		}
+	} else {
+		uint32_t total_constraint_count = all_constraints.size();
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -260,8 +287,14 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (deterministic) {
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_solve_island(island_index);
+		}
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -271,11 +304,9 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	// Iterated from the array, bodies can leave the active list here.
+	for (GodotBody2D *body : active_bodies) {
+		body->integrate_velocities(p_delta);
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -291,6 +322,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	}
 
 	all_constraints.clear();
+	active_bodies.clear();
 
 	p_space->unlock();
 	_step++;
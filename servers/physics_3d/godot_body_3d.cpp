@@ -187,6 +187,11 @@ void GodotBody3D::set_active(bool p_active) {
 	} else if (get_space()) {
 		get_space()->body_remove_from_active_list(&active_list);
 	}
+
+	// Kinematic bodies are inactive whenever nothing touches them, but can be moved at any time.
+	if (mode >= PhysicsServer3D::BODY_MODE_RIGID) {
+		_set_sleeping(!active);
+	}
 }
 
 void GodotBody3D::set_param(PhysicsServer3D::BodyParameter p_param, const Variant &p_value) {
@@ -307,6 +312,9 @@ void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 			_inv_inertia = Vector3();
 			_set_static(p_mode == PhysicsServer3D::BODY_MODE_STATIC);
 			set_active(p_mode == PhysicsServer3D::BODY_MODE_KINEMATIC && contacts.size());
+			if (p_mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				_set_sleeping(false); // In case it was a sleeping rigid body.
+			}
 			linear_velocity = Vector3();
 			angular_velocity = Vector3();
 			if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC && prev != mode) {
@@ -664,7 +672,8 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector3();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_update_shapes_with_motion(motion, false);
+		deferred_updates |= DEFERRED_UPDATE_BROADPHASE;
 	}
 
 	contact_count = 0;
@@ -676,7 +685,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	}
 
 	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		deferred_updates |= DEFERRED_UPDATE_STATE_QUERY;
 	}
 
 	//apply axis lock linear
@@ -699,7 +708,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
+			deferred_updates |= DEFERRED_UPDATE_DEACTIVATE; //stopped moving, deactivate
 		}
 
 		return;
@@ -728,12 +737,27 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, false);
 	_set_inv_transform(get_transform().inverse());
+	_update_shapes(false);
+	deferred_updates |= DEFERRED_UPDATE_BROADPHASE;
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::apply_deferred_updates(LocalVector<GodotBroadPhase3D::ID> &r_moved_ids, LocalVector<AABB> &r_moved_aabbs) {
+	if (deferred_updates & DEFERRED_UPDATE_STATE_QUERY) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+	if (deferred_updates & DEFERRED_UPDATE_BROADPHASE) {
+		_get_broadphase_moves(r_moved_ids, r_moved_aabbs);
+	}
+	if (deferred_updates & DEFERRED_UPDATE_DEACTIVATE) {
+		set_active(false);
+	}
+	deferred_updates = 0;
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
@@ -145,6 +145,15 @@ class GodotBody3D : public GodotCollisionObject3D {
 	GodotPhysicsDirectBodyState3D *direct_state = nullptr;
 
 	uint64_t island_step = 0;
+	uint32_t island_index = 0;
+
+	enum DeferredUpdate {
+		DEFERRED_UPDATE_BROADPHASE = 1 << 0,
+		DEFERRED_UPDATE_STATE_QUERY = 1 << 1,
+		DEFERRED_UPDATE_DEACTIVATE = 1 << 2,
+	};
+
+	uint32_t deferred_updates = 0;
 
 	void _update_transform_dependent();
 
@@ -194,6 +203,8 @@ public:
 
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
+	_FORCE_INLINE_ uint32_t get_island_index() const { return island_index; }
+	_FORCE_INLINE_ void set_island_index(uint32_t p_index) { island_index = p_index; }
 
 	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
 	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraint_map.erase(p_constraint); }
@@ -316,8 +327,11 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// These can run for different bodies in parallel. Changes to the broadphase and to the lists of the
+	// space are deferred until apply_deferred_updates() is called.
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void apply_deferred_updates(LocalVector<GodotBroadPhase3D::ID> &r_moved_ids, LocalVector<AABB> &r_moved_aabbs);
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -132,8 +132,8 @@ void GodotBodyPair3D::validate_contacts() {
 		Contact &c = contacts[i];
 
 		bool erase = false;
-		if (!c.used) {
-			// Was left behind in previous frame.
+		if (!c.used || c.speculative) {
+			// Was left behind in previous frame, or only applied to it.
 			erase = true;
 		} else {
 			c.used = false;
@@ -250,6 +250,71 @@ bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A,
 	return true;
 }
 
+// _add_speculative_contact prevents tunneling by adding a contact between the closest points of the shapes when they are apart,
+// but close enough that the relative motion of the bodies can close the gap during this step.
+// Process: the solver only lets the bodies approach each other along the contact normal by the size of the gap,
+// so at most they end up slightly overlapping next step, where regular contacts take over.
+// Unlike _test_ccd, this works for any convex shape and doesn't depend on where a cast segment lands, but angular motion is ignored.
+bool GodotBodyPair3D::_add_speculative_contact(real_t p_step) {
+	// Motion of A relative to B.
+	Vector3 motion = (A->get_linear_velocity() - B->get_linear_velocity()) * p_step;
+	if (motion.length_squared() < CMP_EPSILON2) {
+		return false;
+	}
+
+	const Vector3 &offset_A = A->get_transform().get_origin();
+	Transform3D xform_Au = Transform3D(A->get_transform().basis, Vector3());
+	Transform3D xform_A = xform_Au * A->get_shape_transform(shape_A);
+
+	Transform3D xform_Bu = B->get_transform();
+	xform_Bu.origin -= offset_A;
+	Transform3D xform_B = xform_Bu * B->get_shape_transform(shape_B);
+
+	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
+	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
+
+	Vector3 point_A, point_B;
+	bool separated;
+	if (shape_A_ptr->is_concave() || shape_A_ptr->get_type() == PhysicsServer3D::SHAPE_WORLD_BOUNDARY) {
+		// solve_distance() expects these as the second shape, the hint is the region swept by the other one.
+		AABB hint = xform_B.xform(shape_B_ptr->get_aabb());
+		hint = hint.merge(AABB(hint.position - motion, hint.size));
+		separated = GodotCollisionSolver3D::solve_distance(shape_B_ptr, xform_B, shape_A_ptr, xform_A, point_B, point_A, hint);
+	} else {
+		AABB hint = xform_A.xform(shape_A_ptr->get_aabb());
+		hint = hint.merge(AABB(hint.position + motion, hint.size));
+		separated = GodotCollisionSolver3D::solve_distance(shape_A_ptr, xform_A, shape_B_ptr, xform_B, point_A, point_B, hint);
+	}
+
+	if (!separated) {
+		return false;
+	}
+
+	Vector3 gap = point_B - point_A;
+	real_t gap_length = gap.length();
+	if (gap_length < CMP_EPSILON) {
+		return false;
+	}
+
+	Vector3 normal = gap / gap_length;
+	if (motion.dot(normal) < gap_length) {
+		return false; // Won't reach B during this step.
+	}
+
+	Contact contact;
+	contact.local_A = A->get_inv_transform().basis.xform(point_A);
+	contact.local_B = B->get_inv_transform().basis.xform(point_B - offset_B);
+	contact.normal = normal;
+	contact.used = true;
+	contact.speculative = true;
+
+	// The shapes are apart, so any contacts left from previous steps are stale.
+	contacts[0] = contact;
+	contact_count = 1;
+
+	return true;
+}
+
 real_t combine_bounce(GodotBody3D *A, GodotBody3D *B) {
 	return CLAMP(A->get_bounce() + B->get_bounce(), 0, 1);
 }
@@ -260,6 +325,11 @@ real_t combine_friction(GodotBody3D *A, GodotBody3D *B) {
 
 bool GodotBodyPair3D::setup(real_t p_step) {
 	check_ccd = false;
+	narrowphase_batch_count = 0;
+
+	// Invalidated on every early return, only a full run of collision detection makes it valid again.
+	bool cache_valid = contact_cache_valid;
+	contact_cache_valid = false;
 
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
@@ -294,25 +364,130 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
-	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	if (cache_valid && cached_shape_A == shape_A_ptr && cached_shape_B == shape_B_ptr &&
+			cached_shape_version_A == shape_A_ptr->get_version() && cached_shape_version_B == shape_B_ptr->get_version() &&
+			cached_basis_A == A->get_transform().basis && cached_xform_A == xform_A && cached_xform_B == xform_B) {
+		// Nothing moved relative to each other, the contacts from the last step are still the right ones.
+		for (int i = 0; i < contact_count; i++) {
+			contacts[i].used = true;
+		}
+		collided = cached_collided;
+		contact_cache_valid = true;
+		return _finish_setup(p_step);
+	}
 
-	if (!collided) {
-		if (A->is_continuous_collision_detection_enabled() && collide_A) {
-			check_ccd = true;
+	if (GodotCollisionSolver3D::gather_concave_faces(shape_A_ptr, xform_A, shape_B_ptr, xform_B, narrowphase_faces, narrowphase_swap)) {
+		uint32_t face_cost = GodotCollisionSolver3D::get_face_test_cost(narrowphase_swap ? shape_B_ptr : shape_A_ptr);
+		if (narrowphase_faces.size() * face_cost >= NARROWPHASE_MIN_DEFERRED_COST) {
+			// Leave the faces to solve_narrowphase_batch(), setup is completed in finish_narrowphase().
+			narrowphase_xform_A = xform_A;
+			narrowphase_xform_B = xform_B;
+			narrowphase_step = p_step;
+			narrowphase_faces_per_batch = MAX(1u, (uint32_t)NARROWPHASE_BATCH_COST / face_cost);
+			narrowphase_batch_count = (narrowphase_faces.size() + narrowphase_faces_per_batch - 1) / narrowphase_faces_per_batch;
+			if (narrowphase_batches.size() < narrowphase_batch_count) {
+				narrowphase_batches.resize(narrowphase_batch_count);
+			}
+			collided = false;
 			return true;
 		}
 
-		if (B->is_continuous_collision_detection_enabled() && collide_B) {
-			check_ccd = true;
-			return true;
+		if (narrowphase_swap) {
+			collided = GodotCollisionSolver3D::solve_concave_faces(shape_B_ptr, xform_B, narrowphase_faces.ptr(), narrowphase_faces.size(), xform_A, _contact_added_callback, this, true);
+		} else {
+			collided = GodotCollisionSolver3D::solve_concave_faces(shape_A_ptr, xform_A, narrowphase_faces.ptr(), narrowphase_faces.size(), xform_B, _contact_added_callback, this, false);
 		}
+	} else {
+		collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	}
 
-		return false;
+	_update_contact_cache(xform_A, xform_B, shape_A_ptr, shape_B_ptr);
+
+	return _finish_setup(p_step);
+}
+
+bool GodotBodyPair3D::_finish_setup(real_t p_step) {
+	if (!collided) {
+		if (!(A->is_continuous_collision_detection_enabled() && collide_A) && !(B->is_continuous_collision_detection_enabled() && collide_B)) {
+			return false;
+		}
+
+		if (space->is_using_speculative_contacts()) {
+			collided = _add_speculative_contact(p_step);
+			return collided;
+		}
+
+		check_ccd = true;
+		return true;
 	}
 
 	return true;
 }
 
+void GodotBodyPair3D::_update_contact_cache(const Transform3D &p_xform_A, const Transform3D &p_xform_B, const GodotShape3D *p_shape_A, const GodotShape3D *p_shape_B) {
+	cached_basis_A = A->get_transform().basis;
+	cached_xform_A = p_xform_A;
+	cached_xform_B = p_xform_B;
+	cached_shape_A = p_shape_A;
+	cached_shape_B = p_shape_B;
+	cached_shape_version_A = p_shape_A->get_version();
+	cached_shape_version_B = p_shape_B->get_version();
+	cached_collided = collided;
+	contact_cache_valid = true;
+}
+
+void GodotBodyPair3D::_narrowphase_contact_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
+	NarrowphaseBatch *batch = static_cast<NarrowphaseBatch *>(p_userdata);
+
+	NarrowphaseContact contact;
+	contact.point_A = p_point_A;
+	contact.point_B = p_point_B;
+	contact.normal = normal;
+	contact.index_A = p_index_A;
+	contact.index_B = p_index_B;
+	batch->contacts.push_back(contact);
+}
+
+void GodotBodyPair3D::solve_narrowphase_batch(uint32_t p_batch_index) {
+	ERR_FAIL_UNSIGNED_INDEX(p_batch_index, narrowphase_batch_count);
+
+	NarrowphaseBatch &batch = narrowphase_batches[p_batch_index];
+	batch.contacts.clear();
+
+	uint32_t first = p_batch_index * narrowphase_faces_per_batch;
+	uint32_t count = MIN(narrowphase_faces_per_batch, narrowphase_faces.size() - first);
+	const GodotCollisionSolver3D::ConcaveFace *faces = narrowphase_faces.ptr() + first;
+
+	// Only the batch is written to, so batches can be solved at the same time.
+	if (narrowphase_swap) {
+		batch.collided = GodotCollisionSolver3D::solve_concave_faces(B->get_shape(shape_B), narrowphase_xform_B, faces, count, narrowphase_xform_A, _narrowphase_contact_callback, &batch, true);
+	} else {
+		batch.collided = GodotCollisionSolver3D::solve_concave_faces(A->get_shape(shape_A), narrowphase_xform_A, faces, count, narrowphase_xform_B, _narrowphase_contact_callback, &batch, false);
+	}
+}
+
+void GodotBodyPair3D::finish_narrowphase() {
+	if (!narrowphase_batch_count) {
+		return;
+	}
+
+	collided = false;
+	for (uint32_t i = 0; i < narrowphase_batch_count; i++) {
+		const NarrowphaseBatch &batch = narrowphase_batches[i];
+		for (const NarrowphaseContact &contact : batch.contacts) {
+			contact_added_callback(contact.point_A, contact.index_A, contact.point_B, contact.index_B, contact.normal);
+		}
+		if (batch.collided) {
+			collided = true;
+		}
+	}
+	narrowphase_batch_count = 0;
+
+	_update_contact_cache(narrowphase_xform_A, narrowphase_xform_B, A->get_shape(shape_A), B->get_shape(shape_B));
+
+	_finish_setup(narrowphase_step);
+}
+
 bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	if (!collided) {
 		if (check_ccd) {
@@ -381,7 +556,7 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 		Vector3 axis = global_A - global_B;
 		real_t depth = axis.dot(c.normal);
 
-		if (depth <= 0.0) {
+		if (depth <= 0.0 && !c.speculative) {
 			continue;
 		}
 
@@ -402,6 +577,18 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 		kNormal += c.normal.dot(inertia_A.cross(c.rA)) + c.normal.dot(inertia_B.cross(c.rB));
 		c.mass_normal = 1.0f / kNormal;
 
+		if (c.speculative) {
+			// No position correction and nothing to report, the normal impulse only has to keep
+			// the approaching velocity below what closes the gap (-depth) during the step.
+			// Half the allowed penetration is added, so the shapes end up overlapping and regular contacts take over.
+			c.bias = 0.0;
+			c.bounce = (max_penetration * 0.5 - depth) * inv_dt;
+			c.depth = depth;
+			c.active = true;
+			do_process = true;
+			continue;
+		}
+
 		c.bias = -bias * inv_dt * MIN(0.0f, -depth + max_penetration);
 		c.depth = depth;
 
@@ -483,7 +670,7 @@ void GodotBodyPair3D::solve(real_t p_step) {
 
 		real_t vbn = dbv.dot(c.normal);
 
-		if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
+		if (!c.speculative && Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
 			real_t jbn = (-vbn + c.bias) * c.mass_normal;
 			real_t jbnOld = c.acc_bias_impulse;
 			c.acc_bias_impulse = MAX(jbnOld + jbn, 0.0f);
@@ -546,6 +733,10 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			c.active = true;
 		}
 
+		if (c.speculative) {
+			continue; // Not touching, so no friction.
+		}
+
 		//friction impulse
 
 		real_t friction = combine_friction(A, B);
@@ -32,6 +32,7 @@
 #define GODOT_BODY_PAIR_3D_H
 
 #include "godot_body_3d.h"
+#include "godot_collision_solver_3d.h"
 #include "godot_constraint_3d.h"
 #include "godot_soft_body_3d.h"
 
@@ -56,6 +57,7 @@ protected:
 		real_t depth = 0.0;
 		bool active = false;
 		bool used = false;
+		bool speculative = false; // Not touching yet, only keeps the bodies from going past each other during the step.
 		Vector3 rA, rB; // Offset in world orientation with respect to center of mass
 	};
 
@@ -72,7 +74,12 @@ protected:
 
 class GodotBodyPair3D : public GodotBodyContact3D {
 	enum {
-		MAX_CONTACTS = 4
+		MAX_CONTACTS = 4,
+		// Face tests are weighed with GodotCollisionSolver3D::get_face_test_cost(), so batches take about as long
+		// whether the convex shape is a sphere or a detailed convex polygon.
+		// Pairs costing less than this are collided in setup(), the batches aren't worth it.
+		NARROWPHASE_MIN_DEFERRED_COST = 32 * 13, // 32 faces against a box.
+		NARROWPHASE_BATCH_COST = 16 * 13,
 	};
 
 	union {
@@ -97,18 +104,65 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	// Faces of a concave shape left by setup() to be collided in batches.
+	// Contacts are recorded per batch, and added in order once all batches are done,
+	// so the result is the same as colliding them in setup().
+	struct NarrowphaseContact {
+		Vector3 point_A;
+		Vector3 point_B;
+		Vector3 normal;
+		int index_A = 0;
+		int index_B = 0;
+	};
+
+	struct NarrowphaseBatch {
+		LocalVector<NarrowphaseContact> contacts;
+		bool collided = false;
+	};
+
+	LocalVector<GodotCollisionSolver3D::ConcaveFace> narrowphase_faces;
+	LocalVector<NarrowphaseBatch> narrowphase_batches;
+	uint32_t narrowphase_batch_count = 0;
+	uint32_t narrowphase_faces_per_batch = 1;
+	bool narrowphase_swap = false;
+	Transform3D narrowphase_xform_A;
+	Transform3D narrowphase_xform_B;
+	real_t narrowphase_step = 0.0;
+
+	static void _narrowphase_contact_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
+
+	// The shapes and their relative placement when contacts were last generated.
+	// If none of it changed the contacts are still valid, and collision detection is skipped.
+	bool contact_cache_valid = false;
+	Basis cached_basis_A;
+	Transform3D cached_xform_A;
+	Transform3D cached_xform_B;
+	const GodotShape3D *cached_shape_A = nullptr;
+	const GodotShape3D *cached_shape_B = nullptr;
+	uint64_t cached_shape_version_A = 0;
+	uint64_t cached_shape_version_B = 0;
+	bool cached_collided = false;
+
+	void _update_contact_cache(const Transform3D &p_xform_A, const Transform3D &p_xform_B, const GodotShape3D *p_shape_A, const GodotShape3D *p_shape_B);
+	bool _finish_setup(real_t p_step);
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
 	void validate_contacts();
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
+	bool _add_speculative_contact(real_t p_step);
 
 public:
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual uint32_t get_narrowphase_batch_count() const override { return narrowphase_batch_count; }
+	virtual void solve_narrowphase_batch(uint32_t p_batch_index) override;
+	virtual void finish_narrowphase() override;
+
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
 };
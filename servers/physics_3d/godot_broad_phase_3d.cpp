@@ -32,5 +32,33 @@
 
 GodotBroadPhase3D::CreateFunction GodotBroadPhase3D::create_func = nullptr;
 
+void GodotBroadPhase3D::move_batch(const ID *p_ids, const AABB *p_aabbs, int p_count) {
+	for (int i = 0; i < p_count; i++) {
+		move(p_ids[i], p_aabbs[i]);
+	}
+}
+
+void GodotBroadPhase3D::set_sleeping(ID p_id, bool p_sleeping) {
+}
+
+void GodotBroadPhase3D::cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_count, GodotCollisionObject3D **p_results, int p_max_results, int *r_result_counts, int *p_result_indices) {
+	for (int i = 0; i < p_count; i++) {
+		int ofs = i * p_max_results;
+		r_result_counts[i] = cull_segment(p_from[i], p_to[i], p_results + ofs, p_max_results, p_result_indices ? p_result_indices + ofs : nullptr);
+	}
+}
+
+int GodotBroadPhase3D::cull_aabb_unlocked(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices) {
+	return cull_aabb(p_aabb, p_results, p_max_results, p_result_indices);
+}
+
+void GodotBroadPhase3D::cull_segments_unlocked(const Vector3 *p_from, const Vector3 *p_to, int p_count, GodotCollisionObject3D **p_results, int p_max_results, int *r_result_counts, int *p_result_indices) {
+	cull_segments(p_from, p_to, p_count, p_results, p_max_results, r_result_counts, p_result_indices);
+}
+
+Vector<uint8_t> GodotBroadPhase3D::rebuild_static(const Vector<uint8_t> &p_layout) {
+	return Vector<uint8_t>();
+}
+
 GodotBroadPhase3D::~GodotBroadPhase3D() {
 }
@@ -33,6 +33,7 @@
 
 #include "core/math/aabb.h"
 #include "core/math/math_funcs.h"
+#include "core/templates/vector.h"
 
 class GodotCollisionObject3D;
 
@@ -50,7 +51,10 @@ public:
 	// 0 is an invalid ID
 	virtual ID create(GodotCollisionObject3D *p_object_, int p_subindex = 0, const AABB &p_aabb = AABB(), bool p_static = false) = 0;
 	virtual void move(ID p_id, const AABB &p_aabb) = 0;
+	virtual void move_batch(const ID *p_ids, const AABB *p_aabbs, int p_count);
 	virtual void set_static(ID p_id, bool p_static) = 0;
+	// Hint that the object has stopped (or started) moving. Static objects ignore it.
+	virtual void set_sleeping(ID p_id, bool p_sleeping);
 	virtual void remove(ID p_id) = 0;
 
 	virtual GodotCollisionObject3D *get_object(ID p_id) const = 0;
@@ -60,12 +64,25 @@ public:
 	virtual int cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
+	// Segment n writes its results starting at p_results[n * p_max_results].
+	virtual void cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_count, GodotCollisionObject3D **p_results, int p_max_results, int *r_result_counts, int *p_result_indices = nullptr);
+	// Same as cull_aabb() and cull_segments(), but can be called from several threads at once.
+	// Only valid between begin_unlocked_culls() and end_unlocked_culls(), which block changes to the
+	// broadphase from other threads meanwhile.
+	virtual void begin_unlocked_culls() {}
+	virtual void end_unlocked_culls() {}
+	virtual int cull_aabb_unlocked(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr);
+	virtual void cull_segments_unlocked(const Vector3 *p_from, const Vector3 *p_to, int p_count, GodotCollisionObject3D **p_results, int p_max_results, int *r_result_counts, int *p_result_indices = nullptr);
 
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
 
 	virtual void update() = 0;
 
+	// Rebuilds the static objects for faster queries, replaying p_layout where it still fits.
+	// Returns the layout that was built, which can be passed in again (e.g. on level load).
+	virtual Vector<uint8_t> rebuild_static(const Vector<uint8_t> &p_layout);
+
 	virtual ~GodotBroadPhase3D();
 };
 
@@ -32,10 +32,34 @@
 
 #include "godot_collision_object_3d.h"
 
+#include "core/config/project_settings.h"
+#include "core/io/marshalls.h"
+
+// Static layouts are stored as a version, a split count, then an axis and a position for each split.
+// Positions are stored as real_t, so layouts of single and double precision builds have their own version.
+#ifdef REAL_T_IS_DOUBLE
+#define STATIC_LAYOUT_VERSION 2
+#define STATIC_LAYOUT_SPLIT_SIZE 12
+#else
+#define STATIC_LAYOUT_VERSION 1
+#define STATIC_LAYOUT_SPLIT_SIZE 8
+#endif
+#define STATIC_LAYOUT_HEADER_SIZE 8
+
+uint32_t GodotBroadPhase3DBVH::_get_tree_collision_mask(uint32_t p_tree_id) {
+	// Keeping sleeping bodies in their own tree doesn't change which pairs are tested, they still
+	// pair with static, moving and other sleeping bodies. It only keeps them out of the moving tree.
+	switch (p_tree_id) {
+		case TREE_STATIC:
+			return TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING;
+		default:
+			return TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING;
+	}
+}
+
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
-	ID oid = bvh.create(p_object, true, tree_id, tree_collision_mask, p_aabb, p_subindex); // Pair everything, don't care?
+	ID oid = bvh.create(p_object, true, tree_id, _get_tree_collision_mask(tree_id), p_aabb, p_subindex); // Pair everything, don't care?
 	return oid + 1;
 }
 
@@ -44,15 +68,32 @@ void GodotBroadPhase3DBVH::move(ID p_id, const AABB &p_aabb) {
 	bvh.move(p_id - 1, p_aabb);
 }
 
+void GodotBroadPhase3DBVH::move_batch(const ID *p_ids, const AABB *p_aabbs, int p_count) {
+	move_batch_handles.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		ERR_FAIL_COND(!p_ids[i]);
+		move_batch_handles[i] = p_ids[i] - 1;
+	}
+	bvh.move_batch(move_batch_handles.ptr(), p_aabbs, p_count);
+}
+
 void GodotBroadPhase3DBVH::set_static(ID p_id, bool p_static) {
 	ERR_FAIL_COND(!p_id);
+	pending_sleeping.erase(p_id);
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
-	bvh.set_tree(p_id - 1, tree_id, tree_collision_mask, false);
+	bvh.set_tree(p_id - 1, tree_id, _get_tree_collision_mask(tree_id), false);
+}
+
+void GodotBroadPhase3DBVH::set_sleeping(ID p_id, bool p_sleeping) {
+	ERR_FAIL_COND(!p_id);
+	if (separate_sleeping) {
+		pending_sleeping[p_id] = p_sleeping;
+	}
 }
 
 void GodotBroadPhase3DBVH::remove(ID p_id) {
 	ERR_FAIL_COND(!p_id);
+	pending_sleeping.erase(p_id);
 	bvh.erase(p_id - 1);
 }
 
@@ -69,6 +110,11 @@ bool GodotBroadPhase3DBVH::is_static(ID p_id) const {
 	return tree_id == 0;
 }
 
+bool GodotBroadPhase3DBVH::is_sleeping(ID p_id) const {
+	ERR_FAIL_COND_V(!p_id, false);
+	return bvh.get_tree_id(p_id - 1) == TREE_SLEEPING;
+}
+
 int GodotBroadPhase3DBVH::get_subindex(ID p_id) const {
 	ERR_FAIL_COND_V(!p_id, 0);
 	return bvh.get_subindex(p_id - 1);
@@ -86,6 +132,49 @@ int GodotBroadPhase3DBVH::cull_aabb(const AABB &p_aabb, GodotCollisionObject3D *
 	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
 }
 
+void GodotBroadPhase3DBVH::cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_count, GodotCollisionObject3D **p_results, int p_max_results, int *r_result_counts, int *p_result_indices) {
+	_cull_segments(p_from, p_to, p_count, p_results, p_max_results, r_result_counts, p_result_indices, false);
+}
+
+void GodotBroadPhase3DBVH::begin_unlocked_culls() {
+	bvh.lock();
+}
+
+void GodotBroadPhase3DBVH::end_unlocked_culls() {
+	bvh.unlock();
+}
+
+int GodotBroadPhase3DBVH::cull_aabb_unlocked(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices) {
+	// The tree's own hit buffer is shared, so every thread gathers hits in its own.
+	static thread_local LocalVector<uint32_t, uint32_t, true> hits;
+	return bvh.cull_aabb_unlocked(p_aabb, p_results, p_max_results, hits, nullptr, 0xFFFFFFFF, p_result_indices);
+}
+
+void GodotBroadPhase3DBVH::cull_segments_unlocked(const Vector3 *p_from, const Vector3 *p_to, int p_count, GodotCollisionObject3D **p_results, int p_max_results, int *r_result_counts, int *p_result_indices) {
+	_cull_segments(p_from, p_to, p_count, p_results, p_max_results, r_result_counts, p_result_indices, true);
+}
+
+void GodotBroadPhase3DBVH::_cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_count, GodotCollisionObject3D **p_results, int p_max_results, int *r_result_counts, int *p_result_indices, bool p_unlocked) {
+	const int packet_size = BVH_ABB<AABB, Vector3>::SegmentPacket::MAX_SIZE;
+
+	GodotCollisionObject3D **result_arrays[packet_size];
+	int *index_arrays[packet_size];
+
+	for (int from = 0; from < p_count; from += packet_size) {
+		int count = MIN(packet_size, p_count - from);
+		for (int i = 0; i < count; i++) {
+			int ofs = (from + i) * p_max_results;
+			result_arrays[i] = p_results + ofs;
+			index_arrays[i] = p_result_indices ? p_result_indices + ofs : nullptr;
+		}
+		if (p_unlocked) {
+			bvh.cull_segment_packet_unlocked(p_from + from, p_to + from, count, result_arrays, p_max_results, r_result_counts + from, nullptr, 0xFFFFFFFF, index_arrays);
+		} else {
+			bvh.cull_segment_packet(p_from + from, p_to + from, count, result_arrays, p_max_results, r_result_counts + from, nullptr, 0xFFFFFFFF, index_arrays);
+		}
+	}
+}
+
 void *GodotBroadPhase3DBVH::_pair_callback(void *self, uint32_t p_A, GodotCollisionObject3D *p_object_A, int subindex_A, uint32_t p_B, GodotCollisionObject3D *p_object_B, int subindex_B) {
 	GodotBroadPhase3DBVH *bpo = static_cast<GodotBroadPhase3DBVH *>(self);
 	if (!bpo->pair_callback) {
@@ -115,9 +204,67 @@ void GodotBroadPhase3DBVH::set_unpair_callback(UnpairCallback p_unpair_callback,
 }
 
 void GodotBroadPhase3DBVH::update() {
+	for (const KeyValue<ID, bool> &E : pending_sleeping) {
+		uint32_t tree_id = bvh.get_tree_id(E.key - 1);
+		if (tree_id == TREE_STATIC) {
+			continue;
+		}
+		uint32_t new_tree_id = E.value ? TREE_SLEEPING : TREE_DYNAMIC;
+		if (new_tree_id != tree_id) {
+			bvh.set_tree(E.key - 1, new_tree_id, _get_tree_collision_mask(new_tree_id), false);
+		}
+	}
+	pending_sleeping.clear();
+
 	bvh.update();
 }
 
+Vector<uint8_t> GodotBroadPhase3DBVH::rebuild_static(const Vector<uint8_t> &p_layout) {
+	LocalVector<BVHBuildSplit> splits;
+
+	if (p_layout.size()) {
+		const uint8_t *r = p_layout.ptr();
+		int size = p_layout.size();
+		ERR_FAIL_COND_V_MSG(size < STATIC_LAYOUT_HEADER_SIZE || decode_uint32(r) != STATIC_LAYOUT_VERSION, Vector<uint8_t>(), "Invalid static broadphase layout.");
+		uint32_t split_count = decode_uint32(r + 4);
+		ERR_FAIL_COND_V_MSG((uint64_t)size != STATIC_LAYOUT_HEADER_SIZE + (uint64_t)split_count * STATIC_LAYOUT_SPLIT_SIZE, Vector<uint8_t>(), "Invalid static broadphase layout.");
+
+		splits.resize(split_count);
+		for (uint32_t i = 0; i < split_count; i++) {
+			const uint8_t *split_data = r + STATIC_LAYOUT_HEADER_SIZE + i * STATIC_LAYOUT_SPLIT_SIZE;
+			splits[i].axis = (int32_t)decode_uint32(split_data);
+#ifdef REAL_T_IS_DOUBLE
+			splits[i].position = decode_double(split_data + 4);
+#else
+			splits[i].position = decode_float(split_data + 4);
+#endif
+		}
+	}
+
+	LocalVector<BVHBuildSplit> built_splits;
+	bvh.rebuild_tree(TREE_STATIC, splits.size() ? &splits : nullptr, &built_splits);
+
+	// Incremental reinsertion would only make the new layout worse.
+	bvh.set_tree_frozen(TREE_STATIC, true);
+
+	Vector<uint8_t> layout;
+	layout.resize(STATIC_LAYOUT_HEADER_SIZE + built_splits.size() * STATIC_LAYOUT_SPLIT_SIZE);
+	uint8_t *w = layout.ptrw();
+	encode_uint32(STATIC_LAYOUT_VERSION, w);
+	encode_uint32(built_splits.size(), w + 4);
+	for (uint32_t i = 0; i < built_splits.size(); i++) {
+		uint8_t *split_data = w + STATIC_LAYOUT_HEADER_SIZE + i * STATIC_LAYOUT_SPLIT_SIZE;
+		encode_uint32((uint32_t)built_splits[i].axis, split_data);
+#ifdef REAL_T_IS_DOUBLE
+		encode_double(built_splits[i].position, split_data + 4);
+#else
+		encode_float(built_splits[i].position, split_data + 4);
+#endif
+	}
+
+	return layout;
+}
+
 GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
 	return memnew(GodotBroadPhase3DBVH);
 }
@@ -125,4 +272,7 @@ GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
 GodotBroadPhase3DBVH::GodotBroadPhase3DBVH() {
 	bvh.set_pair_callback(_pair_callback, this);
 	bvh.set_unpair_callback(_unpair_callback, this);
+
+	separate_sleeping = GLOBAL_GET("physics/3d/broadphase/separate_sleeping_bodies");
+	bvh.set_tree_frozen(TREE_SLEEPING, true);
 }
@@ -34,6 +34,7 @@
 #include "godot_broad_phase_3d.h"
 
 #include "core/math/bvh.h"
+#include "core/templates/hash_map.h"
 
 class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 	template <class T>
@@ -56,43 +57,66 @@ class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 	enum Tree {
 		TREE_STATIC = 0,
 		TREE_DYNAMIC = 1,
+		// Only used when sleeping bodies are kept separate. This tree is frozen, as sleeping bodies don't move.
+		TREE_SLEEPING = 2,
 	};
 
 	enum TreeFlag {
 		TREE_FLAG_STATIC = 1 << TREE_STATIC,
 		TREE_FLAG_DYNAMIC = 1 << TREE_DYNAMIC,
+		TREE_FLAG_SLEEPING = 1 << TREE_SLEEPING,
 	};
 
-	BVH_Manager<GodotCollisionObject3D, 2, true, 128, UserPairTestFunction<GodotCollisionObject3D>, UserCullTestFunction<GodotCollisionObject3D>> bvh;
+	BVH_Manager<GodotCollisionObject3D, 3, true, 128, UserPairTestFunction<GodotCollisionObject3D>, UserCullTestFunction<GodotCollisionObject3D>> bvh;
+
+	static uint32_t _get_tree_collision_mask(uint32_t p_tree_id);
 
 	static void *_pair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int);
 	static void _unpair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int, void *);
 
+	void _cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_count, GodotCollisionObject3D **p_results, int p_max_results, int *r_result_counts, int *p_result_indices, bool p_unlocked);
+
 	PairCallback pair_callback = nullptr;
 	void *pair_userdata = nullptr;
 	UnpairCallback unpair_callback = nullptr;
 	void *unpair_userdata = nullptr;
 
+	LocalVector<uint32_t> move_batch_handles;
+
+	// Bodies change trees when the broadphase is next updated, rather than in the middle of a step.
+	bool separate_sleeping = false;
+	HashMap<ID, bool> pending_sleeping;
+
 public:
 	// 0 is an invalid ID
 	virtual ID create(GodotCollisionObject3D *p_object, int p_subindex = 0, const AABB &p_aabb = AABB(), bool p_static = false) override;
 	virtual void move(ID p_id, const AABB &p_aabb) override;
+	virtual void move_batch(const ID *p_ids, const AABB *p_aabbs, int p_count) override;
 	virtual void set_static(ID p_id, bool p_static) override;
+	virtual void set_sleeping(ID p_id, bool p_sleeping) override;
 	virtual void remove(ID p_id) override;
 
 	virtual GodotCollisionObject3D *get_object(ID p_id) const override;
 	virtual bool is_static(ID p_id) const override;
+	bool is_sleeping(ID p_id) const;
 	virtual int get_subindex(ID p_id) const override;
 
 	virtual int cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+	virtual void cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_count, GodotCollisionObject3D **p_results, int p_max_results, int *r_result_counts, int *p_result_indices = nullptr) override;
+	virtual void begin_unlocked_culls() override;
+	virtual void end_unlocked_culls() override;
+	virtual int cull_aabb_unlocked(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+	virtual void cull_segments_unlocked(const Vector3 *p_from, const Vector3 *p_to, int p_count, GodotCollisionObject3D **p_results, int p_max_results, int *r_result_counts, int *p_result_indices = nullptr) override;
 
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) override;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) override;
 
 	virtual void update() override;
 
+	virtual Vector<uint8_t> rebuild_static(const Vector<uint8_t> &p_layout) override;
+
 	static GodotBroadPhase3D *_create();
 	GodotBroadPhase3DBVH();
 };
@@ -142,6 +142,18 @@ void GodotCollisionObject3D::_set_static(bool p_static) {
 	}
 }
 
+void GodotCollisionObject3D::_set_sleeping(bool p_sleeping) {
+	if (!space) {
+		return;
+	}
+	for (int i = 0; i < get_shape_count(); i++) {
+		const Shape &s = shapes[i];
+		if (s.bpid > 0) {
+			space->get_broadphase()->set_sleeping(s.bpid, p_sleeping);
+		}
+	}
+}
+
 void GodotCollisionObject3D::_unregister_shapes() {
 	for (int i = 0; i < shapes.size(); i++) {
 		Shape &s = shapes.write[i];
@@ -152,7 +164,7 @@ void GodotCollisionObject3D::_unregister_shapes() {
 	}
 }
 
-void GodotCollisionObject3D::_update_shapes() {
+void GodotCollisionObject3D::_update_shapes(bool p_update_broadphase) {
 	if (!space) {
 		return;
 	}
@@ -173,6 +185,10 @@ void GodotCollisionObject3D::_update_shapes() {
 		Vector3 scale = xform.get_basis().get_scale();
 		s.area_cache = s.shape->get_volume() * scale.x * scale.y * scale.z;
 
+		if (!p_update_broadphase) {
+			continue;
+		}
+
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
@@ -182,7 +198,7 @@ void GodotCollisionObject3D::_update_shapes() {
 	}
 }
 
-void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion) {
+void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion, bool p_update_broadphase) {
 	if (!space) {
 		return;
 	}
@@ -200,6 +216,10 @@ void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion)
 		shape_aabb.merge_with(AABB(shape_aabb.position + p_motion, shape_aabb.size)); //use motion
 		s.aabb_cache = shape_aabb;
 
+		if (!p_update_broadphase) {
+			continue;
+		}
+
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
@@ -209,6 +229,27 @@ void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion)
 	}
 }
 
+void GodotCollisionObject3D::_get_broadphase_moves(LocalVector<GodotBroadPhase3D::ID> &r_ids, LocalVector<AABB> &r_aabbs) {
+	if (!space) {
+		return;
+	}
+
+	for (int i = 0; i < shapes.size(); i++) {
+		Shape &s = shapes.write[i];
+		if (s.disabled) {
+			continue;
+		}
+
+		if (s.bpid == 0) {
+			s.bpid = space->get_broadphase()->create(this, i, s.aabb_cache, _static);
+			space->get_broadphase()->set_static(s.bpid, _static);
+		}
+
+		r_ids.push_back(s.bpid);
+		r_aabbs.push_back(s.aabb_cache);
+	}
+}
+
 void GodotCollisionObject3D::_set_space(GodotSpace3D *p_space) {
 	GodotSpace3D *old_space = space;
 	space = p_space;
@@ -34,6 +34,7 @@
 #include "godot_broad_phase_3d.h"
 #include "godot_shape_3d.h"
 
+#include "core/templates/local_vector.h"
 #include "core/templates/self_list.h"
 #include "servers/physics_server_3d.h"
 
@@ -79,10 +80,12 @@ private:
 
 	SelfList<GodotCollisionObject3D> pending_shape_update_list;
 
-	void _update_shapes();
-
 protected:
-	void _update_shapes_with_motion(const Vector3 &p_motion);
+	// Passing false for p_update_broadphase only refreshes the cached shape AABBs, which is safe to do for
+	// different objects in parallel. The broadphase must then be updated with _get_broadphase_moves().
+	void _update_shapes(bool p_update_broadphase = true);
+	void _update_shapes_with_motion(const Vector3 &p_motion, bool p_update_broadphase = true);
+	void _get_broadphase_moves(LocalVector<GodotBroadPhase3D::ID> &r_ids, LocalVector<AABB> &r_aabbs);
 	void _unregister_shapes();
 
 	_FORCE_INLINE_ void _set_transform(const Transform3D &p_transform, bool p_update_shapes = true) {
@@ -98,6 +101,7 @@ protected:
 	}
 	_FORCE_INLINE_ void _set_inv_transform(const Transform3D &p_transform) { inv_transform = p_transform; }
 	void _set_static(bool p_static);
+	void _set_sleeping(bool p_sleeping);
 
 	virtual void _shapes_changed() = 0;
 	void _set_space(GodotSpace3D *p_space);
@@ -140,6 +144,10 @@ public:
 		CRASH_BAD_INDEX(p_index, shapes.size());
 		return shapes[p_index].area_cache;
 	}
+	_FORCE_INLINE_ GodotBroadPhase3D::ID get_shape_broadphase_id(int p_index) const {
+		CRASH_BAD_INDEX(p_index, shapes.size());
+		return shapes[p_index].bpid;
+	}
 
 	_FORCE_INLINE_ const Transform3D &get_transform() const { return transform; }
 	_FORCE_INLINE_ const Transform3D &get_inv_transform() const { return inv_transform; }
@@ -331,6 +331,14 @@ bool GodotCollisionSolver3D::solve_concave(const GodotShape3D *p_shape_A, const
 
 	cinfo.aabb_tests = 0;
 
+	AABB local_aabb = concave_get_local_aabb(p_shape_A, p_transform_A, p_transform_B, p_margin_A);
+
+	concave_B->cull(local_aabb, concave_callback, &cinfo, false);
+
+	return cinfo.collided;
+}
+
+AABB GodotCollisionSolver3D::concave_get_local_aabb(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const Transform3D &p_transform_B, real_t p_margin_A) {
 	Transform3D rel_transform = p_transform_A;
 	rel_transform.origin -= p_transform_B.origin;
 
@@ -353,9 +361,99 @@ bool GodotCollisionSolver3D::solve_concave(const GodotShape3D *p_shape_A, const
 		local_aabb.size[i] = smax - smin;
 	}
 
-	concave_B->cull(local_aabb, concave_callback, &cinfo, false);
+	return local_aabb;
+}
 
-	return cinfo.collided;
+bool GodotCollisionSolver3D::concave_gather_callback(void *p_userdata, GodotShape3D *p_convex) {
+	LocalVector<ConcaveFace> &faces = *(static_cast<LocalVector<ConcaveFace> *>(p_userdata));
+	const GodotFaceShape3D *face_shape = static_cast<const GodotFaceShape3D *>(p_convex);
+
+	ConcaveFace face;
+	face.normal = face_shape->normal;
+	face.vertex[0] = face_shape->vertex[0];
+	face.vertex[1] = face_shape->vertex[1];
+	face.vertex[2] = face_shape->vertex[2];
+	face.backface_collision = face_shape->backface_collision;
+	face.invert_backface_collision = face_shape->invert_backface_collision;
+	faces.push_back(face);
+
+	return false;
+}
+
+bool GodotCollisionSolver3D::gather_concave_faces(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, LocalVector<ConcaveFace> &r_faces, bool &r_swap) {
+	r_faces.clear();
+
+	bool concave_A = p_shape_A->is_concave();
+	bool concave_B = p_shape_B->is_concave();
+	if (concave_A == concave_B) {
+		return false;
+	}
+
+	r_swap = concave_A;
+	const GodotShape3D *convex = r_swap ? p_shape_B : p_shape_A;
+	const GodotConcaveShape3D *concave = static_cast<const GodotConcaveShape3D *>(r_swap ? p_shape_A : p_shape_B);
+
+	// These are handled separately by solve_static().
+	PhysicsServer3D::ShapeType convex_type = convex->get_type();
+	if (convex_type == PhysicsServer3D::SHAPE_WORLD_BOUNDARY || convex_type == PhysicsServer3D::SHAPE_SEPARATION_RAY || convex_type == PhysicsServer3D::SHAPE_SOFT_BODY) {
+		return false;
+	}
+
+	const Transform3D &transform_convex = r_swap ? p_transform_B : p_transform_A;
+	const Transform3D &transform_concave = r_swap ? p_transform_A : p_transform_B;
+
+	AABB local_aabb = concave_get_local_aabb(convex, transform_convex, transform_concave, 0);
+	concave->cull(local_aabb, concave_gather_callback, &r_faces, false);
+
+	return true;
+}
+
+bool GodotCollisionSolver3D::solve_concave_faces(const GodotShape3D *p_convex, const Transform3D &p_transform_convex, const ConcaveFace *p_faces, int p_face_count, const Transform3D &p_transform_concave, CallbackResult p_result_callback, void *p_userdata, bool p_swap_result) {
+	GodotFaceShape3D face_shape;
+
+	bool collided = false;
+	for (int i = 0; i < p_face_count; i++) {
+		const ConcaveFace &face = p_faces[i];
+		face_shape.normal = face.normal;
+		face_shape.vertex[0] = face.vertex[0];
+		face_shape.vertex[1] = face.vertex[1];
+		face_shape.vertex[2] = face.vertex[2];
+		face_shape.backface_collision = face.backface_collision;
+		face_shape.invert_backface_collision = face.invert_backface_collision;
+
+		if (collision_solver(p_convex, p_transform_convex, &face_shape, p_transform_concave, p_result_callback, p_userdata, p_swap_result, nullptr, 0, 0)) {
+			collided = true;
+		}
+	}
+
+	return collided;
+}
+
+uint32_t GodotCollisionSolver3D::get_face_test_cost(const GodotShape3D *p_convex) {
+	// Follows the axes tested by the _collision_*_face() functions in godot_collision_solver_3d_sat.cpp.
+	switch (p_convex->get_type()) {
+		case PhysicsServer3D::SHAPE_SPHERE: {
+			return 7; // Face normal, edges and vertices of the face.
+		} break;
+		case PhysicsServer3D::SHAPE_CAPSULE: {
+			return 10;
+		} break;
+		case PhysicsServer3D::SHAPE_BOX: {
+			return 13; // Face normal, box axes and edge pairs.
+		} break;
+		case PhysicsServer3D::SHAPE_CYLINDER: {
+			return 14;
+		} break;
+		case PhysicsServer3D::SHAPE_CONVEX_POLYGON: {
+			// Every axis projects all the vertices, where a box projects the equivalent of 8.
+			const Geometry3D::MeshData &mesh = static_cast<const GodotConvexPolygonShape3D *>(p_convex)->get_mesh();
+			uint32_t axes = 1 + mesh.faces.size() + mesh.edges.size() * 3;
+			return axes * MAX(1u, (uint32_t)mesh.vertices.size() / 8);
+		} break;
+		default: {
+			return 13;
+		}
+	}
 }
 
 bool GodotCollisionSolver3D::solve_static(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, Vector3 *r_sep_axis, real_t p_margin_A, real_t p_margin_B) {
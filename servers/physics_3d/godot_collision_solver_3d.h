@@ -33,15 +33,27 @@
 
 #include "godot_shape_3d.h"
 
+#include "core/templates/local_vector.h"
+
 class GodotCollisionSolver3D {
 public:
 	typedef void (*CallbackResult)(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
+	// A face of a concave shape, copied so it can be collided later.
+	struct ConcaveFace {
+		Vector3 normal;
+		Vector3 vertex[3];
+		bool backface_collision = false;
+		bool invert_backface_collision = false;
+	};
+
 private:
 	static bool soft_body_query_callback(uint32_t p_node_index, void *p_userdata);
 	static void soft_body_contact_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 	static bool soft_body_concave_callback(void *p_userdata, GodotShape3D *p_convex);
 	static bool concave_callback(void *p_userdata, GodotShape3D *p_convex);
+	static bool concave_gather_callback(void *p_userdata, GodotShape3D *p_convex);
+	static AABB concave_get_local_aabb(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const Transform3D &p_transform_B, real_t p_margin_A);
 	static bool solve_static_world_boundary(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, bool p_swap_result, real_t p_margin = 0);
 	static bool solve_separation_ray(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, bool p_swap_result, real_t p_margin = 0);
 	static bool solve_soft_body(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, bool p_swap_result);
@@ -51,6 +63,15 @@ private:
 
 public:
 	static bool solve_static(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, Vector3 *r_sep_axis = nullptr, real_t p_margin_A = 0, real_t p_margin_B = 0);
+	// solve_static() for a convex and a concave shape can be done in two steps, so the faces can be collided in
+	// batches (e.g. on different threads). Returns false if the shapes are not a convex and a concave shape,
+	// otherwise r_faces holds the faces which may collide, and r_swap is true if the concave shape is A.
+	static bool gather_concave_faces(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, LocalVector<ConcaveFace> &r_faces, bool &r_swap);
+	static bool solve_concave_faces(const GodotShape3D *p_convex, const Transform3D &p_transform_convex, const ConcaveFace *p_faces, int p_face_count, const Transform3D &p_transform_concave, CallbackResult p_result_callback, void *p_userdata, bool p_swap_result);
+	// Rough cost of colliding a convex shape with one face, in separating axes tested against a box.
+	// Faces are copied when gathered, so it doesn't depend on the concave shape they came from.
+	static uint32_t get_face_test_cost(const GodotShape3D *p_convex);
+
 	static bool solve_distance(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B, const AABB &p_concave_hint, Vector3 *r_sep_axis = nullptr);
 };
 
@@ -75,6 +75,12 @@ public:
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
+	// Expensive collision detection that setup() left to be done in batches, which can run on different threads.
+	// finish_narrowphase() is called once all the batches of the constraint are done.
+	virtual uint32_t get_narrowphase_batch_count() const { return 0; }
+	virtual void solve_narrowphase_batch(uint32_t p_batch_index) {}
+	virtual void finish_narrowphase() {}
+
 	virtual ~GodotConstraint3D() {}
 };
 
@@ -214,6 +214,13 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> GodotPhysicsServer3D::space_rebuild_static_broadphase(RID p_space, const Vector<uint8_t> &p_layout) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(space->is_locked(), Vector<uint8_t>(), "The broadphase can't be rebuilt while the space is being stepped.");
+	return space->get_broadphase()->rebuild_static(p_layout);
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -1640,11 +1647,17 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
+		step_time[i] = 0;
+	}
 	for (const GodotSpace3D *E : active_spaces) {
 		stepper->step(const_cast<GodotSpace3D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
+			step_time[i] += (int)E->get_elapsed_time(GodotSpace3D::ElapsedTime(i));
+		}
 	}
 #endif
 }
@@ -1675,6 +1688,7 @@ void GodotPhysicsServer3D::flush_queries() {
 		uint64_t total_time[GodotSpace3D::ELAPSED_TIME_MAX];
 		static const char *time_name[GodotSpace3D::ELAPSED_TIME_MAX] = {
 			"integrate_forces",
+			"update_broadphase",
 			"generate_islands",
 			"setup_constraints",
 			"solve_constraints",
@@ -1725,6 +1739,24 @@ int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_INTEGRATE_FORCES_TIME: {
+			return step_time[GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES];
+		} break;
+		case INFO_UPDATE_BROADPHASE_TIME: {
+			return step_time[GodotSpace3D::ELAPSED_TIME_UPDATE_BROADPHASE];
+		} break;
+		case INFO_GENERATE_ISLANDS_TIME: {
+			return step_time[GodotSpace3D::ELAPSED_TIME_GENERATE_ISLANDS];
+		} break;
+		case INFO_SETUP_CONSTRAINTS_TIME: {
+			return step_time[GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS];
+		} break;
+		case INFO_SOLVE_CONSTRAINTS_TIME: {
+			return step_time[GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS];
+		} break;
+		case INFO_INTEGRATE_VELOCITIES_TIME: {
+			return step_time[GodotSpace3D::ELAPSED_TIME_INTEGRATE_VELOCITIES];
+		} break;
 	}
 
 	return 0;
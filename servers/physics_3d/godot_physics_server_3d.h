@@ -48,6 +48,8 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	// Time spent in each phase of the last step, in microseconds.
+	int step_time[GodotSpace3D::ELAPSED_TIME_MAX] = {};
 
 	bool using_threads = false;
 	bool doing_sync = false;
@@ -117,6 +119,8 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual Vector<uint8_t> space_rebuild_static_broadphase(RID p_space, const Vector<uint8_t> &p_layout) override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
@@ -50,6 +50,7 @@ class GodotShape3D {
 	AABB aabb;
 	bool configured = false;
 	real_t custom_bias = 0.0;
+	uint64_t version = 0; // Incremented whenever the shape data changes.
 
 	HashMap<GodotShapeOwner3D *, int> owners;
 
@@ -73,6 +74,7 @@ public:
 
 	_FORCE_INLINE_ const AABB &get_aabb() const { return aabb; }
 	_FORCE_INLINE_ bool is_configured() const { return configured; }
+	_FORCE_INLINE_ uint64_t get_version() const { return version; }
 
 	virtual bool is_concave() const { return false; }
 
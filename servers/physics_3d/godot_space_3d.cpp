@@ -34,6 +34,7 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
@@ -105,16 +106,10 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
-	Vector3 begin, end;
-	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
-	normal = (end - begin).normalized();
-
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray_candidates(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_candidates, const int *p_subindices, int p_candidate_count, RayResult &r_result) const {
+	Vector3 begin = p_from;
+	Vector3 end = p_to;
+	Vector3 normal = (end - begin).normalized();
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -125,22 +120,22 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_candidate_count; i++) {
+		if (!_can_collide_with(p_candidates[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_candidates[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_candidates[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_candidates[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_subindices[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -205,41 +200,38 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	if (p_result_max <= 0) {
-		return 0;
-	}
-
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, 0);
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	return _intersect_ray_candidates(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
 
+int GodotPhysicsDirectSpaceState3D::_intersect_shape_candidates(const GodotShape3D *p_shape, const ShapeParameters &p_parameters, const Transform3D &p_transform, GodotCollisionObject3D *const *p_candidates, const int *p_subindices, int p_candidate_count, ShapeResult *r_results, int p_result_max) const {
 	int cc = 0;
 
 	//Transform3D ai = p_xform.affine_inverse();
 
-	for (int i = 0; i < amount; i++) {
+	for (int i = 0; i < p_candidate_count; i++) {
 		if (cc >= p_result_max) {
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(p_candidates[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_candidates[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = p_candidates[i];
+		int shape_idx = p_subindices[i];
 
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		if (!GodotCollisionSolver3D::solve_static(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
 			continue;
 		}
 
@@ -260,6 +252,128 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
+int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, 0);
+
+	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_shape_candidates(shape, p_parameters, p_parameters.transform, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_results, p_result_max);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_chunk(uint32_t p_chunk, RayBatch *p_batch) {
+	// Each chunk has its own candidate buffers, and the calling thread blocks changes to the
+	// broadphase until all chunks are done, so they can cull without locking and run concurrently.
+	MemoryArenaScope scratch;
+	GodotCollisionObject3D **candidates = scratch.get_arena().alloc_array<GodotCollisionObject3D *>(RAY_BATCH_CULL_SIZE * GodotSpace3D::INTERSECTION_QUERY_MAX);
+	int *subindices = scratch.get_arena().alloc_array<int>(RAY_BATCH_CULL_SIZE * GodotSpace3D::INTERSECTION_QUERY_MAX);
+	int candidate_counts[RAY_BATCH_CULL_SIZE];
+
+	int begin = p_chunk * RAY_BATCH_CHUNK_SIZE;
+	int end = MIN(begin + (int)RAY_BATCH_CHUNK_SIZE, p_batch->count);
+
+	for (int from = begin; from < end; from += RAY_BATCH_CULL_SIZE) {
+		int count = MIN((int)RAY_BATCH_CULL_SIZE, end - from);
+		space->broadphase->cull_segments_unlocked(p_batch->from + from, p_batch->to + from, count, candidates, GodotSpace3D::INTERSECTION_QUERY_MAX, candidate_counts, subindices);
+
+		for (int i = 0; i < count; i++) {
+			int ofs = i * GodotSpace3D::INTERSECTION_QUERY_MAX;
+			int ray = from + i;
+			p_batch->hits[ray] = _intersect_ray_candidates(*p_batch->parameters, p_batch->from[ray], p_batch->to[ray], candidates + ofs, subindices + ofs, candidate_counts[i], p_batch->results[ray]);
+		}
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.count = p_count;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	space->broadphase->begin_unlocked_culls();
+
+	uint32_t chunk_count = (p_count + RAY_BATCH_CHUNK_SIZE - 1) / RAY_BATCH_CHUNK_SIZE;
+	if (chunk_count == 1) {
+		_intersect_ray_chunk(0, &batch);
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectRayBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	space->broadphase->end_unlocked_culls();
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_shape_chunk(uint32_t p_chunk, ShapeBatch *p_batch) {
+	// Each chunk has its own candidate buffers, and the calling thread blocks changes to the
+	// broadphase until all chunks are done, so they can cull without locking and run concurrently.
+	MemoryArenaScope scratch;
+	GodotCollisionObject3D **candidates = scratch.get_arena().alloc_array<GodotCollisionObject3D *>(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	int *subindices = scratch.get_arena().alloc_array<int>(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	int begin = p_chunk * SHAPE_BATCH_CHUNK_SIZE;
+	int end = MIN(begin + (int)SHAPE_BATCH_CHUNK_SIZE, p_batch->count);
+
+	for (int i = begin; i < end; i++) {
+		const Transform3D &transform = p_batch->transforms[i];
+		AABB aabb = transform.xform(p_batch->shape->get_aabb());
+
+		int amount = space->broadphase->cull_aabb_unlocked(aabb, candidates, GodotSpace3D::INTERSECTION_QUERY_MAX, subindices);
+
+		p_batch->result_counts[i] = _intersect_shape_candidates(p_batch->shape, *p_batch->parameters, transform, candidates, subindices, amount, p_batch->results + i * p_batch->result_max, p_batch->result_max);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_shape_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+	if (p_result_max <= 0) {
+		for (int i = 0; i < p_count; i++) {
+			r_result_counts[i] = 0;
+		}
+		return;
+	}
+
+	const GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.count = p_count;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+
+	space->broadphase->begin_unlocked_culls();
+
+	uint32_t chunk_count = (p_count + SHAPE_BATCH_CHUNK_SIZE - 1) / SHAPE_BATCH_CHUNK_SIZE;
+	if (chunk_count == 1) {
+		_intersect_shape_chunk(0, &batch);
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_shape_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectShapeBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	space->broadphase->end_unlocked_culls();
+}
+
 bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
@@ -1262,6 +1376,7 @@ GodotSpace3D::GodotSpace3D() {
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/3d/solver/default_contact_bias");
+	speculative_contacts = GLOBAL_GET("physics/3d/solver/speculative_contacts");
 
 	broadphase = GodotBroadPhase3D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
@@ -46,6 +46,37 @@
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	enum {
+		RAY_BATCH_CHUNK_SIZE = 64, // Rays per worker task.
+		RAY_BATCH_CULL_SIZE = 4, // Rays culled per broadphase traversal.
+		SHAPE_BATCH_CHUNK_SIZE = 16, // Shapes per worker task.
+	};
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		int count = 0;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+	};
+
+	struct ShapeBatch {
+		const ShapeParameters *parameters = nullptr;
+		const GodotShape3D *shape = nullptr;
+		const Transform3D *transforms = nullptr;
+		int count = 0;
+		ShapeResult *results = nullptr;
+		int result_max = 0;
+		int *result_counts = nullptr;
+	};
+
+	bool _intersect_ray_candidates(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_candidates, const int *p_subindices, int p_candidate_count, RayResult &r_result) const;
+	int _intersect_shape_candidates(const GodotShape3D *p_shape, const ShapeParameters &p_parameters, const Transform3D &p_transform, GodotCollisionObject3D *const *p_candidates, const int *p_subindices, int p_candidate_count, ShapeResult *r_results, int p_result_max) const;
+
+	void _intersect_ray_chunk(uint32_t p_chunk, RayBatch *p_batch);
+	void _intersect_shape_chunk(uint32_t p_chunk, ShapeBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
@@ -57,6 +88,9 @@ public:
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
 
+	virtual void intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) override;
+	virtual void intersect_shape_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) override;
+
 	GodotPhysicsDirectSpaceState3D();
 };
 
@@ -64,6 +98,7 @@ class GodotSpace3D {
 public:
 	enum ElapsedTime {
 		ELAPSED_TIME_INTEGRATE_FORCES,
+		ELAPSED_TIME_UPDATE_BROADPHASE,
 		ELAPSED_TIME_GENERATE_ISLANDS,
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
@@ -99,6 +134,7 @@ private:
 	real_t contact_max_separation = 0.0;
 	real_t contact_max_allowed_penetration = 0.0;
 	real_t contact_bias = 0.0;
+	bool speculative_contacts = false;
 
 	enum {
 		INTERSECTION_QUERY_MAX = 2048
@@ -165,6 +201,7 @@ public:
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
 	_FORCE_INLINE_ real_t get_contact_bias() const { return contact_bias; }
+	_FORCE_INLINE_ bool is_using_speculative_contacts() const { return speculative_contacts; }
 	_FORCE_INLINE_ real_t get_body_linear_velocity_sleep_threshold() const { return body_linear_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
@@ -40,75 +40,118 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define BODY_BATCH_SIZE 64
 
-void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
-	p_body->set_island_step(_step);
+void GodotStep3D::_integrate_forces(uint32_t p_batch_index, void *p_userdata) {
+	uint32_t from = p_batch_index * BODY_BATCH_SIZE;
+	uint32_t to = MIN(from + BODY_BATCH_SIZE, active_bodies.size());
+	for (uint32_t body_index = from; body_index < to; ++body_index) {
+		active_bodies[body_index]->integrate_forces(delta);
+	}
+}
+
+void GodotStep3D::_integrate_velocities(uint32_t p_batch_index, void *p_userdata) {
+	uint32_t from = p_batch_index * BODY_BATCH_SIZE;
+	uint32_t to = MIN(from + BODY_BATCH_SIZE, active_bodies.size());
+	for (uint32_t body_index = from; body_index < to; ++body_index) {
+		active_bodies[body_index]->integrate_velocities(delta);
+	}
+}
+
+void GodotStep3D::_apply_deferred_body_updates(GodotSpace3D *p_space) {
+	moved_shape_ids.clear();
+	moved_shape_aabbs.clear();
+
+	// Bodies may leave the active list here, which is why they are iterated from the array.
+	for (GodotBody3D *body : active_bodies) {
+		body->apply_deferred_updates(moved_shape_ids, moved_shape_aabbs);
+	}
+
+	p_space->get_broadphase()->move_batch(moved_shape_ids.ptr(), moved_shape_aabbs.ptr(), moved_shape_ids.size());
+}
 
-	if (p_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
-		// Only rigid bodies are tested for activation.
-		p_body_island.push_back(p_body);
+void GodotStep3D::_add_island_node(GodotBody3D *p_body, GodotSoftBody3D *p_soft_body) {
+	uint32_t node_index = island_nodes.size();
+	if (p_body) {
+		p_body->set_island_step(_step);
+		p_body->set_island_index(node_index);
+	} else {
+		p_soft_body->set_island_step(_step);
+		p_soft_body->set_island_index(node_index);
 	}
 
-	for (const KeyValue<GodotConstraint3D *, int> &E : p_body->get_constraint_map()) {
-		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E.key);
-		if (constraint->get_island_step() == _step) {
+	IslandNode node;
+	node.body = p_body;
+	node.soft_body = p_soft_body;
+	island_nodes.push_back(node);
+}
+
+void GodotStep3D::_add_island_constraint(GodotConstraint3D *p_constraint, uint32_t p_node_index) {
+	p_constraint->set_island_step(_step);
+	island_constraints.push_back(p_constraint);
+	island_constraint_nodes.push_back(p_node_index);
+
+	all_constraints.push_back(p_constraint);
+
+	// Find connected rigid bodies.
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		GodotBody3D *other_body = p_constraint->get_body_ptr()[i];
+		if (other_body->get_island_step() == _step) {
 			continue; // Already processed.
 		}
-		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
+		if (other_body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
+			continue; // Static bodies don't connect islands.
+		}
+		_add_island_node(other_body, nullptr);
+	}
 
-		all_constraints.push_back(constraint);
+	// Find connected soft bodies.
+	for (int i = 0; i < p_constraint->get_soft_body_count(); i++) {
+		GodotSoftBody3D *soft_body = p_constraint->get_soft_body_ptr(i);
+		if (soft_body->get_island_step() == _step) {
+			continue; // Already processed.
+		}
+		_add_island_node(nullptr, soft_body);
+	}
+}
 
-		// Find connected rigid bodies.
-		for (int i = 0; i < constraint->get_body_count(); i++) {
-			if (i == E.value) {
-				continue;
-			}
-			GodotBody3D *other_body = constraint->get_body_ptr()[i];
-			if (other_body->get_island_step() == _step) {
+void GodotStep3D::_expand_island_node(uint32_t p_node_index) {
+	// Copied, adding nodes can reallocate the array.
+	IslandNode node = island_nodes[p_node_index];
+
+	if (node.body) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : node.body->get_constraint_map()) {
+			GodotConstraint3D *constraint = E.key;
+			if (constraint->get_island_step() == _step) {
 				continue; // Already processed.
 			}
-			if (other_body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
-				continue; // Static bodies don't connect islands.
-			}
-			_populate_island(other_body, p_body_island, p_constraint_island);
+			_add_island_constraint(constraint, p_node_index);
 		}
-
-		// Find connected soft bodies.
-		for (int i = 0; i < constraint->get_soft_body_count(); i++) {
-			GodotSoftBody3D *soft_body = constraint->get_soft_body_ptr(i);
-			if (soft_body->get_island_step() == _step) {
+	} else {
+		for (const GodotConstraint3D *E : node.soft_body->get_constraints()) {
+			GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E);
+			if (constraint->get_island_step() == _step) {
 				continue; // Already processed.
 			}
-			_populate_island_soft_body(soft_body, p_body_island, p_constraint_island);
+			_add_island_constraint(constraint, p_node_index);
 		}
 	}
 }
 
-void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
-	p_soft_body->set_island_step(_step);
+void GodotStep3D::_union_island_constraint(uint32_t p_constraint_index, void *p_userdata) {
+	GodotConstraint3D *constraint = island_constraints[p_constraint_index];
+	uint32_t node_index = island_constraint_nodes[p_constraint_index];
 
-	for (const GodotConstraint3D *E : p_soft_body->get_constraints()) {
-		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E);
-		if (constraint->get_island_step() == _step) {
-			continue; // Already processed.
+	for (int i = 0; i < constraint->get_body_count(); i++) {
+		GodotBody3D *body = constraint->get_body_ptr()[i];
+		if (body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
+			continue; // Static bodies don't connect islands.
 		}
-		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
-
-		all_constraints.push_back(constraint);
+		island_sets.create_union(node_index, body->get_island_index());
+	}
 
-		// Find connected rigid bodies.
-		for (int i = 0; i < constraint->get_body_count(); i++) {
-			GodotBody3D *body = constraint->get_body_ptr()[i];
-			if (body->get_island_step() == _step) {
-				continue; // Already processed.
-			}
-			if (body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
-				continue; // Static bodies don't connect islands.
-			}
-			_populate_island(body, p_body_island, p_constraint_island);
-		}
+	for (int i = 0; i < constraint->get_soft_body_count(); i++) {
+		island_sets.create_union(node_index, constraint->get_soft_body_ptr(i)->get_island_index());
 	}
 }
 
@@ -117,6 +160,15 @@ void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdat
 	constraint->setup(delta);
 }
 
+void GodotStep3D::_solve_narrowphase_batch(uint32_t p_batch_index, void *p_userdata) {
+	const NarrowphaseBatch &batch = narrowphase_batches[p_batch_index];
+	batch.constraint->solve_narrowphase_batch(batch.batch_index);
+}
+
+void GodotStep3D::_finish_narrowphase(uint32_t p_constraint_index, void *p_userdata) {
+	narrowphase_constraints[p_constraint_index]->finish_narrowphase();
+}
+
 void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
 	uint32_t constraint_count = p_constraint_island.size();
 	uint32_t valid_constraint_count = 0;
@@ -201,15 +253,19 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
-
+	active_bodies.clear();
 	const SelfList<GodotBody3D> *b = body_list->first();
 	while (b) {
-		b->self()->integrate_forces(p_delta);
+		active_bodies.push_back(b->self());
 		b = b->next();
-		active_count++;
 	}
 
+	int active_count = active_bodies.size();
+
+	uint32_t body_batch_count = (active_bodies.size() + BODY_BATCH_SIZE - 1) / BODY_BATCH_SIZE;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, body_batch_count, -1, true, SNAME("Physics3DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
 	/* UPDATE SOFT BODY MOTION */
 
 	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
@@ -221,12 +277,22 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	p_space->set_active_objects(active_count);
 
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
+	/* UPDATE BROADPHASE */
+
+	_apply_deferred_body_updates(p_space);
+
 	// Update the broadphase to register collision pairs.
 	p_space->update();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_UPDATE_BROADPHASE, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -258,79 +324,79 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
-
-	b = body_list->first();
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE BODIES */
 
-	uint32_t body_island_count = 0;
-
-	while (b) {
-		GodotBody3D *body = b->self();
+	// Gather the bodies reachable from the active ones through constraints.
+	island_nodes.clear();
+	island_constraints.clear();
+	island_constraint_nodes.clear();
 
+	for (GodotBody3D *body : active_bodies) {
 		if (body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+			_add_island_node(body, nullptr);
+		}
+	}
 
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
+	sb = soft_body_list->first();
+	while (sb) {
+		if (sb->self()->get_island_step() != _step) {
+			_add_island_node(nullptr, sb->self());
+		}
+		sb = sb->next();
+	}
 
-			_populate_island(body, body_island, constraint_island);
+	for (uint32_t node_index = 0; node_index < island_nodes.size(); ++node_index) {
+		_expand_island_node(node_index);
+	}
 
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
+	// Join the nodes of each constraint.
+	uint32_t node_count = island_nodes.size();
+	island_sets.reset(node_count);
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_union_island_constraint, nullptr, island_constraints.size(), -1, true, SNAME("Physics3DGenerateIslands"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
+	// Every set is represented by its first node, so islands are numbered the same way whatever the order of the unions.
+	uint32_t body_island_count = 0;
+	node_body_islands.resize(node_count);
+	node_constraint_islands.resize(node_count);
+
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		uint32_t root = island_sets.find(node_index);
+		if (root == node_index) {
+			node_body_islands[root] = UINT32_MAX;
+			node_constraint_islands[root] = UINT32_MAX;
 		}
-		b = b->next();
-	}
-
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
 
-	sb = soft_body_list->first();
-	while (sb) {
-		GodotSoftBody3D *soft_body = sb->self();
+		GodotBody3D *body = island_nodes[node_index].body;
+		if (!body || body->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC) {
+			continue; // Only rigid bodies are tested for activation.
+		}
 
-		if (soft_body->get_island_step() != _step) {
-			++body_island_count;
+		uint32_t &body_island_index = node_body_islands[root];
+		if (body_island_index == UINT32_MAX) {
+			body_island_index = body_island_count++;
 			if (body_islands.size() < body_island_count) {
 				body_islands.resize(body_island_count);
 			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+			body_islands[body_island_index].clear();
+			body_islands[body_island_index].reserve(BODY_ISLAND_SIZE_RESERVE);
+		}
+		body_islands[body_island_index].push_back(body);
+	}
 
-			++island_count;
+	for (uint32_t constraint_index = 0; constraint_index < island_constraints.size(); ++constraint_index) {
+		uint32_t root = island_sets.find(island_constraint_nodes[constraint_index]);
+
+		uint32_t &constraint_island_index = node_constraint_islands[root];
+		if (constraint_island_index == UINT32_MAX) {
+			constraint_island_index = island_count++;
 			if (constraint_islands.size() < island_count) {
 				constraint_islands.resize(island_count);
 			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island_soft_body(soft_body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
+			constraint_islands[constraint_island_index].clear();
+			constraint_islands[constraint_island_index].reserve(ISLAND_SIZE_RESERVE);
 		}
-		sb = sb->next();
+		constraint_islands[constraint_island_index].push_back(island_constraints[constraint_index]);
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -344,9 +410,35 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
+	// Pairs with a lot of collision detection to do (e.g. against large concave shapes) split it in batches,
+	// so the work is spread over the threads instead of being done by whichever one ran the pair's setup.
+	narrowphase_batches.clear();
+	narrowphase_constraints.clear();
+	for (GodotConstraint3D *constraint : all_constraints) {
+		uint32_t batch_count = constraint->get_narrowphase_batch_count();
+		if (!batch_count) {
+			continue;
+		}
+		narrowphase_constraints.push_back(constraint);
+		for (uint32_t batch_index = 0; batch_index < batch_count; ++batch_index) {
+			NarrowphaseBatch batch;
+			batch.constraint = constraint;
+			batch.batch_index = batch_index;
+			narrowphase_batches.push_back(batch);
+		}
+	}
+
+	if (narrowphase_batches.size()) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_narrowphase_batch, nullptr, narrowphase_batches.size(), -1, true, SNAME("Physics3DNarrowphase"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_finish_narrowphase, nullptr, narrowphase_constraints.size(), -1, true, SNAME("Physics3DNarrowphaseFinish"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
@@ -375,12 +467,10 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
-	}
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, body_batch_count, -1, true, SNAME("Physics3DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	_apply_deferred_body_updates(p_space);
 
 	/* SLEEP / WAKE UP ISLANDS */
 
@@ -403,6 +493,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	}
 
 	all_constraints.clear();
+	active_bodies.clear();
 
 	p_space->unlock();
 	_step++;
@@ -33,6 +33,7 @@
 
 #include "godot_space_3d.h"
 
+#include "core/math/disjoint_set.h"
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
@@ -41,13 +42,46 @@ class GodotStep3D {
 	int iterations = 0;
 	real_t delta = 0.0;
 
+	LocalVector<GodotBody3D *> active_bodies;
+	LocalVector<GodotBroadPhase3D::ID> moved_shape_ids;
+	LocalVector<AABB> moved_shape_aabbs;
+
+	// Bodies and soft bodies connected to the active ones, islands are the connected sets among them.
+	struct IslandNode {
+		GodotBody3D *body = nullptr;
+		GodotSoftBody3D *soft_body = nullptr;
+	};
+
+	LocalVector<IslandNode> island_nodes;
+	LocalVector<GodotConstraint3D *> island_constraints;
+	LocalVector<uint32_t> island_constraint_nodes;
+	SafeDisjointSet island_sets;
+	LocalVector<uint32_t> node_body_islands;
+	LocalVector<uint32_t> node_constraint_islands;
+
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
-	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	// Collision detection that constraint setup left to be done in batches.
+	struct NarrowphaseBatch {
+		GodotConstraint3D *constraint = nullptr;
+		uint32_t batch_index = 0;
+	};
+
+	LocalVector<NarrowphaseBatch> narrowphase_batches;
+	LocalVector<GodotConstraint3D *> narrowphase_constraints;
+
+	void _integrate_forces(uint32_t p_batch_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_batch_index, void *p_userdata = nullptr);
+	void _apply_deferred_body_updates(GodotSpace3D *p_space);
+	void _add_island_node(GodotBody3D *p_body, GodotSoftBody3D *p_soft_body);
+	void _expand_island_node(uint32_t p_node_index);
+	void _add_island_constraint(GodotConstraint3D *p_constraint, uint32_t p_node_index);
+	void _union_island_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _solve_narrowphase_batch(uint32_t p_batch_index, void *p_userdata = nullptr);
+	void _finish_narrowphase(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
@@ -113,6 +113,8 @@ public:
 		return physics_server_2d->space_get_direct_state(p_space);
 	}
 
+	FUNC1RC(uint32_t, space_get_state_hash, RID);
+
 	FUNC2(space_set_debug_contacts, RID, int);
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override {
 		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), Vector<Vector2>());
@@ -474,6 +474,135 @@ Dictionary PhysicsDirectSpaceState3D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_ray_batch(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The 'from' and 'to' arrays must have the same size.");
+
+	int count = p_from.size();
+
+	Vector<RayResult> results;
+	results.resize(count);
+	Vector<bool> hits;
+	hits.resize(count);
+
+	intersect_ray_batch(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptrw(), hits.ptrw());
+
+	PackedVector3Array positions;
+	positions.resize(count);
+	PackedVector3Array normals;
+	normals.resize(count);
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	PackedInt32Array shapes;
+	shapes.resize(count);
+	PackedInt32Array face_indices;
+	face_indices.resize(count);
+
+	Vector3 *positions_ptrw = positions.ptrw();
+	Vector3 *normals_ptrw = normals.ptrw();
+	int64_t *collider_ids_ptrw = collider_ids.ptrw();
+	int32_t *shapes_ptrw = shapes.ptrw();
+	int32_t *face_indices_ptrw = face_indices.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		if (hits[i]) {
+			const RayResult &result = results[i];
+			positions_ptrw[i] = result.position;
+			normals_ptrw[i] = result.normal;
+			collider_ids_ptrw[i] = (int64_t)(uint64_t)result.collider_id;
+			shapes_ptrw[i] = result.shape;
+			face_indices_ptrw[i] = result.face_index;
+		} else {
+			positions_ptrw[i] = Vector3();
+			normals_ptrw[i] = Vector3();
+			collider_ids_ptrw[i] = 0;
+			shapes_ptrw[i] = -1;
+			face_indices_ptrw[i] = -1;
+		}
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+	d["face_index"] = face_indices;
+
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState3D::_intersect_shape_batch(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_positions, int p_max_results) {
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(p_max_results <= 0, Dictionary());
+
+	const ShapeParameters &parameters = p_shape_query->get_parameters();
+	int count = p_positions.size();
+
+	Vector<Transform3D> transforms;
+	transforms.resize(count);
+	for (int i = 0; i < count; i++) {
+		transforms.write[i] = Transform3D(parameters.transform.basis, p_positions[i]);
+	}
+
+	Vector<ShapeResult> results;
+	results.resize(count * p_max_results);
+	Vector<int> result_counts;
+	result_counts.resize(count);
+
+	intersect_shape_batch(parameters, transforms.ptr(), count, results.ptrw(), p_max_results, result_counts.ptrw());
+
+	int total = 0;
+	for (int i = 0; i < count; i++) {
+		total += result_counts[i];
+	}
+
+	PackedInt32Array queries;
+	queries.resize(total);
+	PackedInt64Array collider_ids;
+	collider_ids.resize(total);
+	PackedInt32Array shapes;
+	shapes.resize(total);
+
+	int32_t *queries_ptrw = queries.ptrw();
+	int64_t *collider_ids_ptrw = collider_ids.ptrw();
+	int32_t *shapes_ptrw = shapes.ptrw();
+
+	int out = 0;
+	for (int i = 0; i < count; i++) {
+		const ShapeResult *query_results = results.ptr() + i * p_max_results;
+		for (int j = 0; j < result_counts[i]; j++) {
+			queries_ptrw[out] = i;
+			collider_ids_ptrw[out] = (int64_t)(uint64_t)query_results[j].collider_id;
+			shapes_ptrw[out] = query_results[j].shape;
+			out++;
+		}
+	}
+
+	Dictionary d;
+	d["query"] = queries;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+
+	return d;
+}
+
+void PhysicsDirectSpaceState3D::intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+	}
+}
+
+void PhysicsDirectSpaceState3D::intersect_shape_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		r_result_counts[i] = intersect_shape(parameters, r_results + i * p_result_max, p_result_max);
+	}
+}
+
 PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 }
 
@@ -484,6 +613,8 @@ void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
+	ClassDB::bind_method(D_METHOD("intersect_ray_batch", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_ray_batch);
+	ClassDB::bind_method(D_METHOD("intersect_shape_batch", "parameters", "positions", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape_batch, DEFVAL(32));
 }
 
 ///////////////////////////////
@@ -712,6 +843,7 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_rebuild_static_broadphase", "space", "layout"), &PhysicsServer3D::space_rebuild_static_broadphase, DEFVAL(Vector<uint8_t>()));
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer3D::area_set_space);
@@ -1033,6 +1165,12 @@ void PhysicsServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_INTEGRATE_FORCES_TIME);
+	BIND_ENUM_CONSTANT(INFO_UPDATE_BROADPHASE_TIME);
+	BIND_ENUM_CONSTANT(INFO_GENERATE_ISLANDS_TIME);
+	BIND_ENUM_CONSTANT(INFO_SETUP_CONSTRAINTS_TIME);
+	BIND_ENUM_CONSTANT(INFO_SOLVE_CONSTRAINTS_TIME);
+	BIND_ENUM_CONSTANT(INFO_INTEGRATE_VELOCITIES_TIME);
 
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_RECYCLE_RADIUS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_MAX_SEPARATION);
@@ -1071,6 +1209,8 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
+	GLOBAL_DEF("physics/3d/solver/speculative_contacts", false);
+	GLOBAL_DEF("physics/3d/broadphase/separate_sleeping_bodies", false);
 }
 
 PhysicsServer3D::~PhysicsServer3D() {
@@ -127,6 +127,8 @@ private:
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
 	TypedArray<Vector3> _collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
+	Dictionary _intersect_ray_batch(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
+	Dictionary _intersect_shape_batch(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_positions, int p_max_results = 32);
 
 protected:
 	static void _bind_methods();
@@ -205,6 +207,12 @@ public:
 
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const = 0;
 
+	// Batched versions of intersect_ray and intersect_shape. Every query shares p_parameters,
+	// except for its segment or transform. The defaults run the queries one by one.
+	virtual void intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits);
+	// Query n writes up to p_result_max results starting at r_results[n * p_result_max].
+	virtual void intersect_shape_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts);
+
 	PhysicsDirectSpaceState3D();
 };
 
@@ -306,6 +314,8 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual Vector<uint8_t> space_rebuild_static_broadphase(RID p_space, const Vector<uint8_t> &p_layout) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -805,7 +815,13 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_INTEGRATE_FORCES_TIME,
+		INFO_UPDATE_BROADPHASE_TIME,
+		INFO_GENERATE_ISLANDS_TIME,
+		INFO_SETUP_CONSTRAINTS_TIME,
+		INFO_SOLVE_CONSTRAINTS_TIME,
+		INFO_INTEGRATE_VELOCITIES_TIME,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
@@ -128,6 +128,8 @@ public:
 		return physics_server_3d->space_get_contact_count(p_space);
 	}
 
+	FUNC2R(Vector<uint8_t>, space_rebuild_static_broadphase, RID, const Vector<uint8_t> &);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
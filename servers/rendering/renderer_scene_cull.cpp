@@ -4033,7 +4033,7 @@ void RendererSceneCull::update() {
 
 	uint32_t rid_count = scenario_owner.get_rid_count();
 	RID *rids = (RID *)alloca(sizeof(RID) * rid_count);
-	scenario_owner.fill_owned_buffer(rids);
+	rid_count = scenario_owner.fill_owned_buffer(rids, rid_count);
 	for (uint32_t i = 0; i < rid_count; i++) {
 		Scenario *s = scenario_owner.get_or_null(rids[i]);
 		s->indexers[Scenario::INDEXER_GEOMETRY].optimize_incremental(indexer_update_iterations);
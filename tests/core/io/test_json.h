@@ -33,7 +33,7 @@
 
 #include "core/io/json.h"
 
-#include "thirdparty/doctest/doctest.h"
+#include "tests/test_macros.h"
 
 namespace TestJSON {
 
@@ -232,6 +232,31 @@ TEST_CASE("[JSON] Parsing escape sequences") {
 		ERR_PRINT_ON
 	}
 }
+
+TEST_CASE("[JSON] Stringify") {
+	Dictionary inner;
+	inner["b"] = Array();
+	inner["a"] = 1.5;
+	Array arr;
+	arr.push_back(1);
+	arr.push_back("two");
+	arr.push_back(Variant());
+	arr.push_back(true);
+	arr.push_back(inner);
+
+	CHECK(JSON::stringify(arr) == "[1,\"two\",null,true,{\"b\":[],\"a\":1.5}]");
+	CHECK(JSON::stringify(arr, "", true) == "[1,\"two\",null,true,{\"a\":1.5,\"b\":[]}]");
+	CHECK(JSON::stringify(inner, "\t") == "{\n\t\"b\": [],\n\t\"a\": 1.5\n}");
+	CHECK(JSON::stringify(Array()) == "[]");
+	CHECK(JSON::stringify("say \"hi\"") == "\"say \\\"hi\\\"\"");
+
+	ERR_PRINT_OFF
+	Array circular;
+	circular.push_back(circular);
+	CHECK(JSON::stringify(circular) == "[\"[...]\"]");
+	circular.clear();
+	ERR_PRINT_ON
+}
 } // namespace TestJSON
 
 #endif // TEST_JSON_H
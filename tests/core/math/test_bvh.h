@@ -0,0 +1,379 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/projection.h"
+#include "core/math/random_number_generator.h"
+#include "core/object/worker_thread_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+template <class T>
+class PairTestFunction {
+public:
+	static bool user_pair_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+template <class T>
+class CullTestFunction {
+public:
+	static bool user_cull_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<int, 1, false, 32, PairTestFunction<int>, CullTestFunction<int>> TestBVHManager;
+
+TEST_CASE("[BVH] Segment packets cull the same items as single segments") {
+	const int item_count = 200;
+	const int segment_count = 37; // Not a multiple of the packet size.
+	const int max_results = item_count; // Large enough that no segment is truncated.
+	const int packet_size = BVH_ABB<AABB, Vector3>::SegmentPacket::MAX_SIZE;
+
+	Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+	rng->set_seed(0);
+
+	TestBVHManager bvh;
+	int items[item_count];
+	for (int i = 0; i < item_count; i++) {
+		items[i] = i;
+		Vector3 position(rng->randf_range(-50, 50), rng->randf_range(-50, 50), rng->randf_range(-50, 50));
+		Vector3 size(rng->randf_range(0.5, 5), rng->randf_range(0.5, 5), rng->randf_range(0.5, 5));
+		bvh.create(&items[i], true, 0, 1, AABB(position, size));
+	}
+	bvh.update();
+
+	Vector3 from[segment_count];
+	Vector3 to[segment_count];
+	for (int i = 0; i < segment_count; i++) {
+		from[i] = Vector3(rng->randf_range(-60, 60), rng->randf_range(-60, 60), rng->randf_range(-60, 60));
+		to[i] = Vector3(rng->randf_range(-60, 60), rng->randf_range(-60, 60), rng->randf_range(-60, 60));
+	}
+	// Axis aligned segments have a zero direction on the other axes.
+	from[0] = Vector3(-60, 0, 0);
+	to[0] = Vector3(60, 0, 0);
+	from[1] = Vector3(0, 0, -60);
+	to[1] = Vector3(0, 0, 60);
+
+	int *packet_results[packet_size][max_results];
+	int **packet_result_arrays[packet_size];
+	for (int lane = 0; lane < packet_size; lane++) {
+		packet_result_arrays[lane] = packet_results[lane];
+	}
+	int packet_counts[packet_size];
+
+	for (int first = 0; first < segment_count; first += packet_size) {
+		int count = MIN(packet_size, segment_count - first);
+		bvh.cull_segment_packet(from + first, to + first, count, packet_result_arrays, max_results, packet_counts, nullptr);
+
+		for (int lane = 0; lane < count; lane++) {
+			int *single_results[max_results];
+			int single_count = bvh.cull_segment(from[first + lane], to[first + lane], single_results, max_results, nullptr);
+
+			CHECK_MESSAGE(packet_counts[lane] == single_count, vformat("Segment %d should have the same number of hits.", first + lane));
+			HashSet<int> expected;
+			for (int n = 0; n < single_count; n++) {
+				expected.insert(*single_results[n]);
+			}
+			for (int n = 0; n < packet_counts[lane]; n++) {
+				CHECK(expected.has(*packet_results[lane][n]));
+			}
+		}
+	}
+}
+
+TEST_CASE("[BVH] Segment packets respect the result limit per segment") {
+	TestBVHManager bvh;
+	int items[8];
+	for (int i = 0; i < 8; i++) {
+		items[i] = i;
+		bvh.create(&items[i], true, 0, 1, AABB(Vector3(i * 2, -1, -1), Vector3(1, 2, 2)));
+	}
+	bvh.update();
+
+	Vector3 from[2] = { Vector3(-1, 0, 0), Vector3(-1, 5, 0) };
+	Vector3 to[2] = { Vector3(20, 0, 0), Vector3(20, 5, 0) };
+
+	int *results[2][3];
+	int **result_arrays[2] = { results[0], results[1] };
+	int counts[2];
+	bvh.cull_segment_packet(from, to, 2, result_arrays, 3, counts, nullptr);
+
+	CHECK(counts[0] == 3);
+	CHECK(counts[1] == 0);
+}
+
+struct UnlockedCulls {
+	static const int QUERY_COUNT = 64;
+	static const int MAX_RESULTS = 64;
+
+	TestBVHManager *bvh = nullptr;
+	AABB aabbs[QUERY_COUNT];
+	int *results[QUERY_COUNT][MAX_RESULTS];
+	int counts[QUERY_COUNT];
+};
+
+static void cull_unlocked(void *p_userdata, uint32_t p_index) {
+	UnlockedCulls *culls = static_cast<UnlockedCulls *>(p_userdata);
+	LocalVector<uint32_t, uint32_t, true> hits;
+	culls->counts[p_index] = culls->bvh->cull_aabb_unlocked(culls->aabbs[p_index], culls->results[p_index], UnlockedCulls::MAX_RESULTS, hits, nullptr);
+}
+
+TEST_CASE("[BVH] Unlocked culls from several threads match locked culls") {
+	const int item_count = 500;
+
+	Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+	rng->set_seed(0);
+
+	TestBVHManager bvh;
+	int items[item_count];
+	for (int i = 0; i < item_count; i++) {
+		items[i] = i;
+		Vector3 position(rng->randf_range(-50, 50), rng->randf_range(-50, 50), rng->randf_range(-50, 50));
+		bvh.create(&items[i], true, 0, 1, AABB(position, Vector3(2, 2, 2)));
+	}
+	bvh.update();
+
+	UnlockedCulls culls;
+	culls.bvh = &bvh;
+	for (int i = 0; i < UnlockedCulls::QUERY_COUNT; i++) {
+		Vector3 position(rng->randf_range(-50, 50), rng->randf_range(-50, 50), rng->randf_range(-50, 50));
+		culls.aabbs[i] = AABB(position, Vector3(10, 10, 10));
+	}
+
+	bvh.lock();
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(cull_unlocked, &culls, UnlockedCulls::QUERY_COUNT, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	bvh.unlock();
+
+	int mismatched = 0;
+	for (int i = 0; i < UnlockedCulls::QUERY_COUNT; i++) {
+		int *locked_results[UnlockedCulls::MAX_RESULTS];
+		int locked_count = bvh.cull_aabb(culls.aabbs[i], locked_results, UnlockedCulls::MAX_RESULTS, nullptr);
+		if (locked_count != culls.counts[i]) {
+			mismatched++;
+			continue;
+		}
+		HashSet<int> expected;
+		for (int n = 0; n < locked_count; n++) {
+			expected.insert(*locked_results[n]);
+		}
+		for (int n = 0; n < culls.counts[i]; n++) {
+			if (!expected.has(*culls.results[i][n])) {
+				mismatched++;
+				break;
+			}
+		}
+	}
+	CHECK_MESSAGE(mismatched == 0, "Every unlocked cull should find the same items as a locked cull.");
+}
+
+TEST_CASE("[BVH] Culling a large tree matches brute force") {
+	// Large enough to give deep trees and full leaves, so the block tests
+	// see both whole and partial blocks.
+	const int item_count = 100000;
+
+	Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+	rng->set_seed(1);
+
+	TestBVHManager bvh;
+	LocalVector<int> items;
+	items.resize(item_count);
+	LocalVector<AABB> bounds;
+	bounds.resize(item_count);
+	for (int i = 0; i < item_count; i++) {
+		items[i] = i;
+		Vector3 position(rng->randf_range(-500, 500), rng->randf_range(-500, 500), rng->randf_range(-500, 500));
+		Vector3 size(rng->randf_range(0.1, 4), rng->randf_range(0.1, 4), rng->randf_range(0.1, 4));
+		bounds[i] = AABB(position, size);
+		bvh.create(&items[i], true, 0, 1, bounds[i]);
+	}
+	bvh.update();
+
+	LocalVector<int *> results;
+	results.resize(item_count);
+
+	SUBCASE("AABB") {
+		for (int q = 0; q < 8; q++) {
+			AABB query(Vector3(rng->randf_range(-500, 400), rng->randf_range(-500, 400), rng->randf_range(-500, 400)), Vector3(100, 60, 80));
+
+			int count = bvh.cull_aabb(query, results.ptr(), item_count, nullptr);
+
+			HashSet<int> found;
+			for (int n = 0; n < count; n++) {
+				found.insert(*results[n]);
+			}
+			CHECK_MESSAGE(found.size() == (uint32_t)count, "Each item should only be returned once.");
+
+			// Checked once per query, a check per item makes the test very slow.
+			int expected = 0;
+			int missing = 0;
+			for (int i = 0; i < item_count; i++) {
+				if (bounds[i].intersects(query)) {
+					expected++;
+					missing += found.has(i) ? 0 : 1;
+				}
+			}
+			CHECK(missing == 0);
+			CHECK(count == expected);
+		}
+	}
+
+	SUBCASE("Frustum") {
+		Projection projection;
+		projection.set_perspective(60, 1.5, 0.1, 400);
+		Transform3D camera = Transform3D().looking_at(Vector3(1, -0.2, 0.3));
+		Vector<Plane> planes = projection.get_projection_planes(camera);
+
+		int count = bvh.cull_convex(planes, results.ptr(), item_count, nullptr);
+		CHECK(count > 0);
+
+		HashSet<int> found;
+		for (int n = 0; n < count; n++) {
+			found.insert(*results[n]);
+		}
+
+		// Culling is conservative, but every item whose center is inside must be found.
+		int missing = 0;
+		for (int i = 0; i < item_count; i++) {
+			Vector3 center = bounds[i].get_center();
+			bool inside = true;
+			for (const Plane &plane : planes) {
+				if (plane.is_point_over(center)) {
+					inside = false;
+					break;
+				}
+			}
+			if (inside && !found.has(i)) {
+				missing++;
+			}
+		}
+		CHECK(missing == 0);
+	}
+}
+
+TEST_CASE("[BVH] Rebuilt trees cull the same items, and recorded layouts can be replayed") {
+	const int item_count = 5000;
+
+	Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+	rng->set_seed(2);
+
+	TestBVHManager bvh;
+	LocalVector<int> items;
+	items.resize(item_count);
+	LocalVector<AABB> bounds;
+	bounds.resize(item_count);
+	LocalVector<BVHHandle> handles;
+	handles.resize(item_count);
+	for (int i = 0; i < item_count; i++) {
+		items[i] = i;
+		Vector3 position(rng->randf_range(-200, 200), rng->randf_range(-20, 20), rng->randf_range(-200, 200));
+		Vector3 size(rng->randf_range(0.1, 8), rng->randf_range(0.1, 8), rng->randf_range(0.1, 8));
+		bounds[i] = AABB(position, size);
+		handles[i] = bvh.create(&items[i], true, 0, 1, bounds[i]);
+	}
+	// A pile of identical items can't be split by position.
+	for (int i = 0; i < 100; i++) {
+		bounds[i] = AABB(Vector3(10, 0, 10), Vector3(1, 1, 1));
+		bvh.move(handles[i], bounds[i]);
+	}
+	bvh.update();
+
+	LocalVector<int *> results;
+	results.resize(item_count);
+	LocalVector<AABB> queries;
+	for (int q = 0; q < 16; q++) {
+		queries.push_back(AABB(Vector3(rng->randf_range(-200, 180), rng->randf_range(-20, 10), rng->randf_range(-200, 180)), Vector3(20, 10, 20)));
+	}
+
+	auto cull_results = [&](const AABB &p_query) {
+		HashSet<int> found;
+		int count = bvh.cull_aabb(p_query, results.ptr(), item_count, nullptr);
+		for (int n = 0; n < count; n++) {
+			found.insert(*results[n]);
+		}
+		CHECK_MESSAGE(found.size() == (uint32_t)count, "Each item should only be returned once.");
+		return found;
+	};
+
+	LocalVector<HashSet<int>> expected;
+	for (const AABB &query : queries) {
+		expected.push_back(cull_results(query));
+	}
+
+	LocalVector<BVHBuildSplit> splits;
+	bvh.rebuild_tree(0, nullptr, &splits);
+	CHECK(splits.size() > 1);
+
+	for (uint32_t q = 0; q < queries.size(); q++) {
+		HashSet<int> found = cull_results(queries[q]);
+		CHECK(found.size() == expected[q].size());
+		for (int i : expected[q]) {
+			CHECK(found.has(i));
+		}
+	}
+
+	LocalVector<BVHBuildSplit> replayed;
+	bvh.rebuild_tree(0, &splits, &replayed);
+	CHECK_MESSAGE(replayed.size() == splits.size(), "Replaying onto the same items should give the same layout.");
+	for (uint32_t n = 0; n < MIN(replayed.size(), splits.size()); n++) {
+		CHECK(replayed[n].axis == splits[n].axis);
+		CHECK(replayed[n].position == splits[n].position);
+	}
+
+	// Replaying onto a changed set of items must still give a valid tree.
+	for (int i = 0; i < item_count; i += 3) {
+		bvh.erase(handles[i]);
+	}
+	bvh.rebuild_tree(0, &splits);
+
+	for (const AABB &query : queries) {
+		HashSet<int> found = cull_results(query);
+		for (int i = 0; i < item_count; i++) {
+			if ((i % 3) && bounds[i].intersects(query)) {
+				CHECK(found.has(i));
+			}
+		}
+		for (int i : found) {
+			CHECK(i % 3 != 0);
+		}
+	}
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
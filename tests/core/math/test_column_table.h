@@ -0,0 +1,183 @@
+/**************************************************************************/
+/*  test_column_table.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COLUMN_TABLE_H
+#define TEST_COLUMN_TABLE_H
+
+#include "core/math/column_table.h"
+#include "tests/test_macros.h"
+
+namespace TestColumnTable {
+
+TEST_CASE("[ColumnTable] Schema and rows") {
+	Ref<ColumnTable> table = memnew(ColumnTable);
+	const int id = table->add_column("id", Variant::INT);
+	const int weight = table->add_column("weight", Variant::FLOAT);
+	CHECK(id == 0);
+	CHECK(weight == 1);
+	CHECK(table->get_column_count() == 2);
+	CHECK(table->find_column("weight") == weight);
+	CHECK(table->find_column("missing") == -1);
+	CHECK(table->get_column_type(weight) == Variant::FLOAT);
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(table->add_column("id", Variant::FLOAT) == -1, "Column names should be unique.");
+	CHECK_MESSAGE(table->add_column("name", Variant::STRING) == -1, "Only numeric column types should be supported.");
+	ERR_PRINT_ON;
+
+	for (int i = 0; i < 4; i++) {
+		const int row = table->add_row();
+		table->set_int(row, id, i);
+		table->set_float(row, weight, i * 0.5);
+	}
+	CHECK(table->get_row_count() == 4);
+
+	// Columns added later are filled with default values.
+	const int offset = table->add_column("offset", Variant::VECTOR3);
+	CHECK(table->get_vector3(3, offset) == Vector3());
+
+	table->remove_row(1);
+	CHECK(table->get_row_count() == 3);
+	CHECK_MESSAGE(table->get_int(1, id) == 3, "The last row should be moved into the removed one.");
+	CHECK(table->get_float(1, weight) == doctest::Approx(1.5));
+
+	table->set_row_count(5);
+	CHECK(table->get_int(4, id) == 0);
+	CHECK(table->get_float(4, weight) == 0.0);
+}
+
+TEST_CASE("[ColumnTable] Values and column data") {
+	Ref<ColumnTable> table = memnew(ColumnTable);
+	const int count = table->add_column("count", Variant::INT);
+	const int tint = table->add_column("tint", Variant::COLOR);
+	table->set_row_count(3);
+
+	table->set_value(2, count, 7);
+	table->set_value(1, tint, Color(1, 0, 0));
+	CHECK(table->get_value(2, count) == Variant(7));
+	CHECK(table->get_color(1, tint) == Color(1, 0, 0));
+
+	ERR_PRINT_OFF;
+	table->set_value(0, count, "text");
+	CHECK(table->get_int(0, count) == 0);
+	CHECK_MESSAGE(table->get_float(0, count) == 0.0, "Typed getters should reject columns of another type.");
+	CHECK(table->get_int(3, count) == 0);
+	ERR_PRINT_ON;
+
+	PackedInt64Array data = table->get_column_data(count);
+	CHECK(data.size() == 3);
+	CHECK(data[2] == 7);
+	data.set(0, 5);
+	CHECK_MESSAGE(table->get_int(0, count) == 0, "Column data should be returned as a copy.");
+
+	table->set_column_data(count, data);
+	CHECK(table->get_int(0, count) == 5);
+
+	ERR_PRINT_OFF;
+	data.push_back(1);
+	table->set_column_data(count, data);
+	CHECK_MESSAGE(table->get_int(0, count) == 5, "Column data with the wrong size should be rejected.");
+	table->set_column_data(count, PackedFloat64Array());
+	CHECK(table->get_int(0, count) == 5);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[ColumnTable] Bulk operations") {
+	// An odd row count, so both the vector loops and their scalar tails are used.
+	const int rows = 37;
+	Ref<ColumnTable> table = memnew(ColumnTable);
+	const int position = table->add_column("position", Variant::VECTOR3);
+	const int velocity = table->add_column("velocity", Variant::VECTOR3);
+	const int mass = table->add_column("mass", Variant::FLOAT);
+	const int score = table->add_column("score", Variant::INT);
+	const int tint = table->add_column("tint", Variant::COLOR);
+	const int uv = table->add_column("uv", Variant::VECTOR2);
+	table->set_row_count(rows);
+	for (int i = 0; i < rows; i++) {
+		table->set_vector3(i, position, Vector3(i, -i, 2 * i));
+		table->set_vector3(i, velocity, Vector3(1, 2, -3));
+		table->set_float(i, mass, i - 10.0);
+		table->set_int(i, score, i);
+		table->set_color(i, tint, Color(i * 0.1, 0.5, 1.0 - i * 0.1, 1.0));
+		table->set_vector2(i, uv, Vector2(i * 0.05, -i * 0.05));
+	}
+
+	SUBCASE("Add") {
+		table->add_to_column(position, velocity, 0.5);
+		table->add_to_column(score, score);
+		for (int i = 0; i < rows; i++) {
+			CHECK(table->get_vector3(i, position).is_equal_approx(Vector3(i + 0.5, -i + 1.0, 2 * i - 1.5)));
+			CHECK(table->get_int(i, score) == 2 * i);
+		}
+		ERR_PRINT_OFF;
+		table->add_to_column(position, mass);
+		ERR_PRINT_ON;
+		CHECK_MESSAGE(table->get_vector3(0, position).is_equal_approx(Vector3(0.5, 1.0, -1.5)), "Columns of different types shouldn't be added.");
+	}
+
+	SUBCASE("Scale") {
+		table->scale_column(mass, 2.0);
+		table->scale_column(tint, 0.5);
+		table->scale_column(score, 1.5);
+		for (int i = 0; i < rows; i++) {
+			CHECK(table->get_float(i, mass) == doctest::Approx(2.0 * (i - 10.0)));
+			CHECK(table->get_color(i, tint).is_equal_approx(Color(i * 0.05, 0.25, 0.5 - i * 0.05, 0.5)));
+			CHECK(table->get_int(i, score) == int64_t(i * 1.5));
+		}
+	}
+
+	SUBCASE("Clamp") {
+		table->clamp_column(position, Vector3(0, -5, 1), Vector3(10, 0, 20));
+		table->clamp_column(mass, -1.0, 1.0);
+		table->clamp_column(score, 3, 30);
+		table->clamp_column(tint, Color(0.2, 0, 0.2, 0), Color(0.8, 0.4, 1, 0.5));
+		table->clamp_column(uv, Vector2(0, -1), Vector2(1, -0.5));
+		for (int i = 0; i < rows; i++) {
+			CHECK(table->get_vector3(i, position) == Vector3(MIN(i, 10), MAX(-i, -5), CLAMP(2 * i, 1, 20)));
+			CHECK(table->get_float(i, mass) == CLAMP(i - 10.0, -1.0, 1.0));
+			CHECK(table->get_int(i, score) == CLAMP(i, 3, 30));
+			CHECK(table->get_color(i, tint).is_equal_approx(Color(CLAMP(i * 0.1f, 0.2f, 0.8f), 0.4, CLAMP(1.0f - i * 0.1f, 0.2f, 1.0f), 0.5)));
+			CHECK(table->get_vector2(i, uv).is_equal_approx(Vector2(MIN(i * 0.05, 1.0), CLAMP(-i * 0.05, -1.0, -0.5))));
+		}
+	}
+
+	SUBCASE("Fill") {
+		table->fill_column(velocity, Vector3(0, 9.8, 0));
+		table->fill_column(mass, 1);
+		for (int i = 0; i < rows; i++) {
+			CHECK(table->get_vector3(i, velocity) == Vector3(0, 9.8, 0));
+			CHECK(table->get_float(i, mass) == 1.0);
+		}
+	}
+}
+
+} // namespace TestColumnTable
+
+#endif // TEST_COLUMN_TABLE_H
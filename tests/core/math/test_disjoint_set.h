@@ -0,0 +1,95 @@
+/**************************************************************************/
+/*  test_disjoint_set.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_DISJOINT_SET_H
+#define TEST_DISJOINT_SET_H
+
+#include "core/math/disjoint_set.h"
+#include "core/object/worker_thread_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestDisjointSet {
+
+TEST_CASE("[DisjointSet] Safe disjoint set") {
+	SafeDisjointSet set;
+	set.reset(8);
+	set.create_union(5, 7);
+	set.create_union(7, 2);
+	set.create_union(1, 6);
+
+	CHECK_MESSAGE(set.find(5) == 2, "The smallest member should represent the set.");
+	CHECK(set.find(7) == 2);
+	CHECK(set.find(6) == 1);
+	CHECK(set.find(3) == 3);
+
+	set.create_union(6, 7);
+	CHECK(set.find(5) == 1);
+	CHECK(set.find(2) == 1);
+
+	set.reset(8);
+	CHECK_MESSAGE(set.find(5) == 5, "Resetting should split all sets.");
+
+	set.reset(1000);
+	CHECK(set.size() == 1000);
+	set.create_union(999, 500);
+	CHECK_MESSAGE(set.find(999) == 500, "Growing should work like a new set.");
+	CHECK(set.find(5) == 5);
+
+	set.reset(4);
+	CHECK(set.size() == 4);
+	CHECK(set.find(3) == 3);
+}
+
+static void union_neighbors(void *p_set, uint32_t p_index) {
+	// Links every element to the next one with the same parity, so the result is two sets.
+	SafeDisjointSet *set = (SafeDisjointSet *)p_set;
+	if (p_index + 2 < set->size()) {
+		set->create_union(p_index + 2, p_index);
+	}
+}
+
+TEST_CASE("[DisjointSet] Safe disjoint set unions from several threads") {
+	SafeDisjointSet set;
+	set.reset(10000);
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(union_neighbors, &set, set.size(), -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	bool all_joined = true;
+	for (uint32_t i = 0; i < set.size(); i++) {
+		all_joined = all_joined && set.find(i) == i % 2;
+	}
+	CHECK(all_joined);
+}
+
+} // namespace TestDisjointSet
+
+#endif // TEST_DISJOINT_SET_H
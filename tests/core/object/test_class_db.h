@@ -37,6 +37,56 @@
 
 #include "tests/test_macros.h"
 
+// Declared in global namespace because of GDCLASS macro warning (Windows):
+// "Unqualified friend declaration referring to type outside of the nearest enclosing namespace
+// is a Microsoft extension; add a nested name specifier".
+class _TestLookupBase : public Object {
+	GDCLASS(_TestLookupBase, Object);
+
+	int value = 0;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_value", "value"), &_TestLookupBase::set_value);
+		ClassDB::bind_method(D_METHOD("get_value"), &_TestLookupBase::get_value);
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "value"), "set_value", "get_value");
+		ADD_SIGNAL(MethodInfo("value_changed"));
+		BIND_CONSTANT(LOOKUP_CONSTANT);
+	}
+
+public:
+	enum {
+		LOOKUP_CONSTANT = 42,
+	};
+
+	void set_value(int p_value) { value = p_value; }
+	int get_value() const { return value; }
+};
+
+class _TestLookupDerived : public _TestLookupBase {
+	GDCLASS(_TestLookupDerived, _TestLookupBase);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("twice"), &_TestLookupDerived::twice);
+	}
+
+public:
+	int twice() const { return get_value() * 2; }
+};
+
+class _TestLookupLate : public _TestLookupDerived {
+	GDCLASS(_TestLookupLate, _TestLookupDerived);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("thrice"), &_TestLookupLate::thrice);
+	}
+
+public:
+	int thrice() const { return get_value() * 3; }
+};
+
 namespace TestClassDB {
 
 struct TypeReference {
@@ -849,6 +899,124 @@ TEST_SUITE("[ClassDB]") {
 		}
 	}
 }
+
+TEST_CASE("[ClassDB] Lookup tables resolve like the inheritance chain") {
+	_TestLookupDerived *object = memnew(_TestLookupDerived);
+
+	List<StringName> class_list;
+	ClassDB::get_class_list(&class_list);
+
+	struct Resolved {
+		MethodBind *method = nullptr;
+		StringName setter;
+		StringName getter;
+		int index = -1;
+	};
+	LocalVector<Resolved> walked;
+	LocalVector<Pair<StringName, StringName>> names;
+
+	for (const StringName &class_name : class_list) {
+		List<MethodInfo> methods;
+		ClassDB::get_method_list(class_name, &methods);
+		List<PropertyInfo> properties;
+		ClassDB::get_property_list(class_name, &properties);
+
+		for (const MethodInfo &E : methods) {
+			names.push_back(Pair<StringName, StringName>(class_name, E.name));
+		}
+		for (const PropertyInfo &E : properties) {
+			names.push_back(Pair<StringName, StringName>(class_name, E.name));
+		}
+		names.push_back(Pair<StringName, StringName>(class_name, "_not_a_member_of_any_class"));
+	}
+
+	// Walk the inheritance chain here, as the tables may already be in use.
+	for (const Pair<StringName, StringName> &E : names) {
+		Resolved resolved;
+		bool method_found = false;
+		for (ClassDB::ClassInfo *check = ClassDB::classes.getptr(E.first); check; check = check->inherits_ptr) {
+			MethodBind **method = check->method_map.getptr(E.second);
+			if (!method_found && method && *method) {
+				resolved.method = *method;
+				method_found = true;
+			}
+			const ClassDB::PropertySetGet *psg = check->property_setget.getptr(E.second);
+			if (psg) {
+				resolved.setter = psg->setter;
+				resolved.getter = psg->getter;
+				resolved.index = psg->index;
+				break;
+			}
+		}
+		walked.push_back(resolved);
+	}
+
+	ClassDB::build_lookup_tables();
+
+	uint32_t mismatches = 0;
+	for (uint32_t i = 0; i < names.size(); i++) {
+		const Pair<StringName, StringName> &E = names[i];
+		if (ClassDB::get_method(E.first, E.second) != walked[i].method ||
+				ClassDB::get_property_setter(E.first, E.second) != walked[i].setter ||
+				ClassDB::get_property_getter(E.first, E.second) != walked[i].getter ||
+				ClassDB::get_property_index(E.first, E.second) != walked[i].index) {
+			mismatches++;
+		}
+	}
+	CHECK(mismatches == 0);
+
+	// Inherited members and the precedence of get().
+	CHECK(ClassDB::get_method("_TestLookupDerived", "set_value") == ClassDB::get_method("_TestLookupBase", "set_value"));
+	CHECK(ClassDB::get_method("_TestLookupDerived", "twice") != nullptr);
+	CHECK(ClassDB::get_method("_TestLookupBase", "twice") == nullptr);
+
+	object->set("value", 21);
+	CHECK(int(object->get("value")) == 21);
+	CHECK(int(object->call("twice")) == 42);
+	CHECK(int(object->get("LOOKUP_CONSTANT")) == 42);
+	CHECK(object->get("value_changed").get_type() == Variant::SIGNAL);
+	CHECK(object->get("twice").get_type() == Variant::CALLABLE);
+
+	bool valid = true;
+	object->get("_not_a_member_of_any_class", &valid);
+	CHECK_FALSE(valid);
+
+	memdelete(object);
+}
+
+TEST_CASE("[ClassDB] Lookup tables follow members registered after they were built") {
+	_TestLookupDerived *object = memnew(_TestLookupDerived);
+	ClassDB::build_lookup_tables();
+
+	// Built on first use, and reused while nothing changes.
+	CHECK(int(object->get("LOOKUP_CONSTANT")) == 42);
+	CHECK(ClassDB::classes["_TestLookupDerived"].lookup_table.get() != nullptr);
+
+	// New classes don't affect existing tables.
+	uint32_t generation = ClassDB::get_lookup_generation();
+	_TestLookupLate *late = memnew(_TestLookupLate);
+	CHECK(ClassDB::get_lookup_generation() == generation);
+	CHECK(ClassDB::classes["_TestLookupDerived"].lookup_table.get() != nullptr);
+	CHECK(int(late->call("thrice")) == 0);
+	CHECK(ClassDB::get_method("_TestLookupLate", "twice") == ClassDB::get_method("_TestLookupDerived", "twice"));
+	memdelete(late);
+
+	// A member added to a base class makes the tables of the classes inheriting it stale,
+	// and they are built again with the new member on their next lookup.
+	bool valid = true;
+	object->get("LATE_CONSTANT", &valid);
+	CHECK_FALSE(valid);
+
+	ClassDB::bind_integer_constant("_TestLookupBase", StringName(), "LATE_CONSTANT", 7);
+	CHECK(ClassDB::get_lookup_generation() != generation);
+	CHECK(ClassDB::classes["_TestLookupDerived"].lookup_table.get() == nullptr);
+
+	CHECK(int(object->get("LATE_CONSTANT")) == 7);
+	CHECK(ClassDB::classes["_TestLookupDerived"].lookup_table.get() != nullptr);
+	CHECK(int(object->get("LOOKUP_CONSTANT")) == 42);
+
+	memdelete(object);
+}
 } // namespace TestClassDB
 
 #endif // TEST_CLASS_DB_H
@@ -0,0 +1,163 @@
+/**************************************************************************/
+/*  test_property_accessor.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PROPERTY_ACCESSOR_H
+#define TEST_PROPERTY_ACCESSOR_H
+
+#include "core/object/class_db.h"
+#include "core/object/object.h"
+#include "core/object/property_accessor.h"
+
+#include "tests/core/object/test_object.h"
+#include "tests/test_macros.h"
+
+// Declared in global namespace because of GDCLASS macro warning (Windows):
+// "Unqualified friend declaration referring to type outside of the nearest enclosing namespace
+// is a Microsoft extension; add a nested name specifier".
+class _TestAccessorObject : public Object {
+	GDCLASS(_TestAccessorObject, Object);
+
+	int count = 0;
+	Vector2 offset;
+	Transform2D transform;
+	Object *target = nullptr;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_count", "count"), &_TestAccessorObject::set_count);
+		ClassDB::bind_method(D_METHOD("get_count"), &_TestAccessorObject::get_count);
+		ClassDB::bind_method(D_METHOD("set_offset", "offset"), &_TestAccessorObject::set_offset);
+		ClassDB::bind_method(D_METHOD("get_offset"), &_TestAccessorObject::get_offset);
+		ClassDB::bind_method(D_METHOD("set_transform", "transform"), &_TestAccessorObject::set_transform);
+		ClassDB::bind_method(D_METHOD("get_transform"), &_TestAccessorObject::get_transform);
+		ClassDB::bind_method(D_METHOD("set_target", "target"), &_TestAccessorObject::set_target);
+		ClassDB::bind_method(D_METHOD("get_target"), &_TestAccessorObject::get_target);
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "count"), "set_count", "get_count");
+		ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "offset"), "set_offset", "get_offset");
+		ADD_PROPERTY(PropertyInfo(Variant::TRANSFORM2D, "transform"), "set_transform", "get_transform");
+		ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "target"), "set_target", "get_target");
+	}
+
+public:
+	void set_count(int p_count) { count = p_count; }
+	int get_count() const { return count; }
+	void set_offset(const Vector2 &p_offset) { offset = p_offset; }
+	Vector2 get_offset() const { return offset; }
+	void set_transform(const Transform2D &p_transform) { transform = p_transform; }
+	Transform2D get_transform() const { return transform; }
+	void set_target(Object *p_target) { target = p_target; }
+	Object *get_target() const { return target; }
+};
+
+namespace TestPropertyAccessor {
+
+TEST_CASE("[PropertyAccessor] Native properties and members") {
+	_TestAccessorObject *object = memnew(_TestAccessorObject);
+
+	PropertyAccessor count(NodePath("count").get_names());
+	bool valid = false;
+	count.set(object, 7, &valid);
+	CHECK(valid);
+	CHECK(object->get_count() == 7);
+	CHECK(int(count.get(object, &valid)) == 7);
+	CHECK(valid);
+
+	// Converted through the regular call.
+	count.set(object, 3.0, &valid);
+	CHECK(valid);
+	CHECK(object->get_count() == 3);
+
+	PropertyAccessor offset_x(NodePath(":offset:x").get_subnames());
+	offset_x.set(object, 2.5, &valid);
+	CHECK(valid);
+	CHECK(object->get_offset() == Vector2(2.5, 0));
+	CHECK(double(offset_x.get(object, &valid)) == doctest::Approx(2.5));
+	CHECK(valid);
+
+	PropertyAccessor origin_y(NodePath(":transform:origin:y").get_subnames());
+	origin_y.set(object, 4.0, &valid);
+	CHECK(valid);
+	CHECK(object->get_transform().get_origin() == Vector2(0, 4));
+	CHECK(double(origin_y.get(object, &valid)) == doctest::Approx(4.0));
+
+	PropertyAccessor target(NodePath("target").get_names());
+	target.set(object, object, &valid);
+	CHECK(valid);
+	CHECK(object->get_target() == object);
+	CHECK(Object::cast_to<Object>(target.get(object)) == object);
+
+	// Missing names behave like get_indexed() and set_indexed().
+	PropertyAccessor missing(NodePath(":offset:w").get_subnames());
+	missing.set(object, 1.0, &valid);
+	CHECK_FALSE(valid);
+	missing.get(object, &valid);
+	CHECK_FALSE(valid);
+
+	PropertyAccessor not_bound(NodePath("not_a_property").get_names());
+	not_bound.get(object, &valid);
+	CHECK_FALSE(valid);
+
+	PropertyAccessor empty;
+	CHECK(empty.is_empty());
+	empty.get(object, &valid);
+	CHECK_FALSE(valid);
+
+	memdelete(object);
+}
+
+TEST_CASE("[PropertyAccessor] Rebinds for other classes and script instances") {
+	_TestAccessorObject *object = memnew(_TestAccessorObject);
+	Object *plain = memnew(Object);
+
+	PropertyAccessor count(NodePath("count").get_names());
+	bool valid = false;
+	count.set(object, 5, &valid);
+	CHECK(valid);
+
+	// Same accessor, a class without the property.
+	count.set(plain, 5, &valid);
+	CHECK_FALSE(valid);
+	CHECK(int(count.get(object)) == 5);
+
+	// A script instance is asked first, like in Object::set().
+	TestObject::_MockScriptInstance *script_instance = memnew(TestObject::_MockScriptInstance);
+	object->set_script_instance(script_instance);
+	count.set(object, 9, &valid);
+	CHECK(valid);
+	CHECK(object->get_count() == 5);
+	CHECK(int(count.get(object)) == 9);
+
+	memdelete(plain);
+	memdelete(object);
+}
+
+} // namespace TestPropertyAccessor
+
+#endif // TEST_PROPERTY_ACCESSOR_H
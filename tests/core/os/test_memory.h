@@ -0,0 +1,158 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MEMORY_H
+#define TEST_MEMORY_H
+
+#include "core/os/memory.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+TEST_CASE("[Memory] Arena allocation and alignment") {
+	MemoryArena arena(256);
+	CHECK(arena.get_used_bytes() == 0);
+	CHECK(arena.get_reserved_bytes() == 0);
+
+	uint8_t *a = (uint8_t *)arena.alloc(3);
+	uint8_t *b = (uint8_t *)arena.alloc(5);
+	uint8_t *c = (uint8_t *)arena.alloc(8, 64);
+	CHECK(((uintptr_t)a & 15) == 0);
+	CHECK(((uintptr_t)b & 15) == 0);
+	CHECK(((uintptr_t)c & 63) == 0);
+	CHECK(b >= a + 3);
+	CHECK(c >= b + 5);
+
+	memset(a, 1, 3);
+	memset(b, 2, 5);
+	memset(c, 3, 8);
+	CHECK(a[2] == 1);
+	CHECK(b[4] == 2);
+	CHECK(c[7] == 3);
+
+	// Larger than a chunk, gets its own.
+	uint8_t *big = (uint8_t *)arena.alloc(1000);
+	memset(big, 4, 1000);
+	CHECK(arena.get_reserved_bytes() >= 1256);
+	CHECK(a[2] == 1);
+
+	arena.reset();
+	CHECK(arena.get_used_bytes() == 0);
+	CHECK_MESSAGE(arena.get_reserved_bytes() >= 1256, "Chunks should be kept for reuse.");
+}
+
+TEST_CASE("[Memory] Arena scopes rewind") {
+	MemoryArena arena(128);
+	int *outer = arena.alloc_array<int>(4);
+	outer[3] = 42;
+	size_t used = arena.get_used_bytes();
+
+	{
+		MemoryArenaScope scope(arena);
+		for (int i = 0; i < 32; i++) {
+			int *values = scope.get_arena().alloc_array<int>(16);
+			values[15] = i;
+		}
+		CHECK(arena.get_used_bytes() > used);
+	}
+
+	CHECK(arena.get_used_bytes() == used);
+	CHECK(outer[3] == 42);
+
+	// Rewound chunks are reused instead of allocating new ones.
+	size_t reserved = arena.get_reserved_bytes();
+	{
+		MemoryArenaScope scope(arena);
+		for (int i = 0; i < 32; i++) {
+			scope.get_arena().alloc_array<int>(16);
+		}
+	}
+	CHECK(arena.get_reserved_bytes() == reserved);
+}
+
+TEST_CASE("[Memory] Scratch typed allocator") {
+	MemoryArenaScope scope;
+	MemoryArena &scratch = MemoryArena::get_thread_scratch();
+	size_t used = scratch.get_used_bytes();
+
+	ScratchTypedAllocator<Vector3> allocator;
+	Vector3 *v = allocator.new_allocation(Vector3(1, 2, 3));
+	CHECK(*v == Vector3(1, 2, 3));
+	CHECK(scratch.get_used_bytes() > used);
+	allocator.delete_allocation(v);
+}
+
+TEST_CASE("[Memory] Thread tags") {
+	CHECK(Memory::get_thread_tag() == Memory::TAG_DEFAULT);
+	{
+		MemoryTagScope physics(Memory::TAG_PHYSICS);
+		CHECK(Memory::get_thread_tag() == Memory::TAG_PHYSICS);
+		{
+			MemoryTagScope audio(Memory::TAG_AUDIO);
+			CHECK(Memory::get_thread_tag() == Memory::TAG_AUDIO);
+		}
+		CHECK(Memory::get_thread_tag() == Memory::TAG_PHYSICS);
+	}
+	CHECK(Memory::get_thread_tag() == Memory::TAG_DEFAULT);
+
+	CHECK(String(Memory::get_tag_name(Memory::TAG_PHYSICS)) == "physics");
+	CHECK(String(Memory::get_tag_name(Memory::TAG_ARENA)) == "arena");
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Memory] Tagged usage accounting") {
+	uint64_t usage = Memory::get_tag_usage(Memory::TAG_NAVIGATION);
+	uint64_t count = Memory::get_tag_alloc_count(Memory::TAG_NAVIGATION);
+
+	void *mem;
+	{
+		MemoryTagScope tag(Memory::TAG_NAVIGATION);
+		mem = Memory::alloc_static(1000);
+	}
+	CHECK(Memory::get_tag_usage(Memory::TAG_NAVIGATION) == usage + 1000);
+	CHECK(Memory::get_tag_alloc_count(Memory::TAG_NAVIGATION) == count + 1);
+
+	// Reallocating from another tag keeps the original one.
+	mem = Memory::realloc_static(mem, 3000);
+	CHECK(Memory::get_tag_usage(Memory::TAG_NAVIGATION) == usage + 3000);
+	mem = Memory::realloc_static(mem, 500);
+	CHECK(Memory::get_tag_usage(Memory::TAG_NAVIGATION) == usage + 500);
+
+	Memory::free_static(mem);
+	CHECK(Memory::get_tag_usage(Memory::TAG_NAVIGATION) == usage);
+	CHECK(Memory::get_tag_alloc_count(Memory::TAG_NAVIGATION) == count);
+}
+#endif
+
+} // namespace TestMemory
+
+#endif // TEST_MEMORY_H
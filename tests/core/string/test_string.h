@@ -31,6 +31,7 @@
 #ifndef TEST_STRING_H
 #define TEST_STRING_H
 
+#include "core/string/string_builder.h"
 #include "core/string/ustring.h"
 
 #include "tests/test_macros.h"
@@ -1877,6 +1878,56 @@ TEST_CASE("[Stress][String] Empty via `is_empty()`") {
 		}
 	}
 }
+
+TEST_CASE("[String] Single ASCII character strings") {
+	String a = "x";
+	String b = String::chr('x');
+	String c = String("axb").substr(1, 1);
+	CHECK(a == "x");
+	CHECK(b == "x");
+	CHECK(c == "x");
+	// They share storage, writing to one must not affect the others.
+	b[0] = 'y';
+	CHECK(a == "x");
+	CHECK(b == "y");
+	CHECK(c == "x");
+	c += "z";
+	CHECK(a == "x");
+	CHECK(c == "xz");
+}
+
+TEST_CASE("[StringBuilder] Append and build") {
+	StringBuilder sb;
+	CHECK(sb.as_string() == "");
+
+	sb.append("Hello");
+	sb.append(String(", "));
+	sb.append(U'W');
+	const char32_t *orld = U"orld!!!";
+	sb.append(orld, 4);
+	sb += String::utf8("\u00e9");
+	CHECK(sb.get_string_length() == 13);
+	CHECK(sb.num_strings_appended() == 5);
+	String first = sb.as_string();
+	CHECK(first == String::utf8("Hello, World\u00e9"));
+	CHECK(first.length() == 13);
+
+	// Appending after building must not modify the previous result.
+	sb.append("!");
+	CHECK(first == String::utf8("Hello, World\u00e9"));
+	CHECK(sb.as_string() == String::utf8("Hello, World\u00e9!"));
+}
+
+TEST_CASE("[StringBuilder] Many appends") {
+	StringBuilder sb;
+	String expected;
+	for (int i = 0; i < 1000; i++) {
+		sb.append(itos(i));
+		expected += itos(i);
+	}
+	CHECK(sb.as_string() == expected);
+	CHECK(sb.get_string_length() == (uint32_t)expected.length());
+}
 } // namespace TestString
 
 #endif // TEST_STRING_H
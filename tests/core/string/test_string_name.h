@@ -0,0 +1,152 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	StringName a = "test_string_name_interning";
+	StringName b = String("test_string_name_interning");
+	StringName c = SNAME("test_string_name_interning");
+	CHECK(a == b);
+	CHECK(a == c);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a == "test_string_name_interning");
+	CHECK(a == String("test_string_name_interning"));
+	CHECK(a != StringName("test_string_name_interning_2"));
+	CHECK(String(a) == "test_string_name_interning");
+
+	CHECK(StringName::search("test_string_name_interning") == a);
+	CHECK(StringName::search(U"test_string_name_interning") == a);
+	CHECK(StringName::search(String("test_string_name_interning")) == a);
+	CHECK(StringName::search("test_string_name_never_created") == StringName());
+}
+
+TEST_CASE("[StringName] Search doesn't find freed names") {
+	{
+		StringName temporary = "test_string_name_temporary";
+		CHECK(StringName::search("test_string_name_temporary") == temporary);
+	}
+	CHECK(StringName::search("test_string_name_temporary") == StringName());
+
+	// The thread cache must not hand out the freed name either.
+	StringName recreated = "test_string_name_temporary";
+	CHECK(String(recreated) == "test_string_name_temporary");
+	CHECK(StringName::search("test_string_name_temporary") == recreated);
+}
+
+TEST_CASE("[StringName] Many names") {
+	// More names than fit in the initial table.
+	const int count = 100000;
+	Vector<StringName> names;
+	names.resize(count);
+	for (int i = 0; i < count; i++) {
+		names.write[i] = StringName("test_string_name_many_" + itos(i));
+	}
+	CHECK(StringName::get_table_load_factor() > 0.0);
+	for (int i = 0; i < count; i++) {
+		const String name = "test_string_name_many_" + itos(i);
+		CHECK(names[i] == StringName(name));
+		CHECK(StringName::search(name) == names[i]);
+	}
+}
+
+struct ThreadedNames {
+	Vector<StringName> names;
+	SafeNumeric<int> mismatches;
+};
+
+static void create_names(void *p_userdata, uint32_t p_index) {
+	ThreadedNames *data = (ThreadedNames *)p_userdata;
+	for (int i = 0; i < data->names.size(); i++) {
+		// Alternate between shared and per-thread names.
+		if (i % 2) {
+			StringName name = "test_string_name_threaded_" + itos(i);
+			if (name != data->names[i]) {
+				data->mismatches.increment();
+			}
+		} else {
+			StringName name = "test_string_name_threaded_" + itos(i) + "_" + itos(p_index);
+			if (name != StringName::search("test_string_name_threaded_" + itos(i) + "_" + itos(p_index))) {
+				data->mismatches.increment();
+			}
+		}
+	}
+}
+
+TEST_CASE("[StringName] Create names from several threads") {
+	ThreadedNames data;
+	data.names.resize(1000);
+	for (int i = 0; i < data.names.size(); i++) {
+		data.names.write[i] = StringName("test_string_name_threaded_" + itos(i));
+	}
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(create_names, &data, 64, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK(data.mismatches.get() == 0);
+	for (int i = 0; i < data.names.size(); i++) {
+		CHECK(StringName::search("test_string_name_threaded_" + itos(i)) == data.names[i]);
+	}
+}
+
+static void churn_names(void *p_userdata, uint32_t p_index) {
+	SafeNumeric<int> *mismatches = (SafeNumeric<int> *)p_userdata;
+	for (int pass = 0; pass < 200; pass++) {
+		for (int i = 0; i < 8; i++) {
+			// Nobody else keeps these alive, so they are freed and created again all the time.
+			const String string = "test_string_name_churn_" + itos(i);
+			StringName name = string;
+			if (String(name) != string) {
+				mismatches->increment();
+			}
+		}
+	}
+}
+
+TEST_CASE("[StringName] Create and free the same names from several threads") {
+	SafeNumeric<int> mismatches;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(churn_names, &mismatches, 64, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK(mismatches.get() == 0);
+	CHECK(StringName::search("test_string_name_churn_0") == StringName());
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
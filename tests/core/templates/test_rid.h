@@ -31,7 +31,9 @@
 #ifndef TEST_RID_H
 #define TEST_RID_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/rid.h"
+#include "core/templates/rid_owner.h"
 
 #include "tests/test_macros.h"
 
@@ -96,6 +98,120 @@ TEST_CASE("[RID] 'get_local_index'") {
 	CHECK(RID::from_uint64(4'294'967'295).get_local_index() == 4'294'967'295);
 	CHECK(RID::from_uint64(4'294'967'297).get_local_index() == 1);
 }
+
+TEST_CASE("[RID_Owner] Allocation, lookup and free") {
+	RID_Owner<int, true> owner(64); // 16 elements per chunk.
+	LocalVector<RID> rids;
+	for (int i = 0; i < 100; i++) {
+		rids.push_back(owner.make_rid(i));
+	}
+	CHECK(owner.get_rid_count() == 100);
+
+	for (int i = 0; i < 100; i++) {
+		CHECK(owner.owns(rids[i]));
+		REQUIRE(owner.get_or_null(rids[i]));
+		CHECK(*owner.get_or_null(rids[i]) == i);
+	}
+
+	for (int i = 0; i < 100; i += 2) {
+		owner.free(rids[i]);
+	}
+	CHECK(owner.get_rid_count() == 50);
+	for (int i = 0; i < 100; i++) {
+		CHECK(owner.owns(rids[i]) == (i % 2 == 1));
+		CHECK((owner.get_or_null(rids[i]) != nullptr) == (i % 2 == 1));
+	}
+
+	List<RID> owned;
+	owner.get_owned_list(&owned);
+	CHECK(owned.size() == 50);
+
+	RID buffer[50];
+	CHECK(owner.fill_owned_buffer(buffer, 50) == 50);
+	CHECK(owner.owns(buffer[0]));
+	CHECK_MESSAGE(owner.fill_owned_buffer(buffer, 10) == 10, "Filling should stop when the buffer is full.");
+
+	// Freed slots are reused with a new validator.
+	RID reused = owner.make_rid(1000);
+	CHECK(*owner.get_or_null(reused) == 1000);
+	CHECK(owner.get_or_null(rids[0]) == nullptr);
+
+	owner.free(reused);
+	for (int i = 1; i < 100; i += 2) {
+		owner.free(rids[i]);
+	}
+	CHECK(owner.get_rid_count() == 0);
+}
+
+TEST_CASE("[RID_Owner] Deferred initialization") {
+	RID_Owner<int, true> owner;
+	RID rid = owner.allocate_rid();
+	CHECK(owner.owns(rid));
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(owner.get_or_null(rid) == nullptr, "Uninitialized RIDs can't be looked up.");
+	ERR_PRINT_ON;
+
+	owner.initialize_rid(rid, 7);
+	CHECK(*owner.get_or_null(rid) == 7);
+
+	ERR_PRINT_OFF;
+	owner.initialize_rid(rid, 8);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(*owner.get_or_null(rid) == 7, "Initializing twice should fail.");
+
+	owner.free(rid);
+	CHECK_FALSE(owner.owns(rid));
+}
+
+struct ThreadedRIDs {
+	RID_Owner<uint64_t, true> owner;
+	SafeNumeric<uint32_t> errors;
+	int iterations = 0;
+};
+
+static void create_query_free_rids(void *p_userdata, uint32_t p_index) {
+	ThreadedRIDs *data = (ThreadedRIDs *)p_userdata;
+	LocalVector<RID> rids;
+	for (int i = 0; i < data->iterations; i++) {
+		uint64_t value = (uint64_t(p_index) << 32) | i;
+		rids.push_back(data->owner.make_rid(value));
+		// Query everything created so far, then free every other one.
+		if (i % 64 == 63) {
+			for (uint32_t j = 0; j < rids.size(); j++) {
+				uint64_t *ptr = data->owner.get_or_null(rids[j]);
+				if (!ptr || (*ptr >> 32) != p_index) {
+					data->errors.increment();
+				}
+			}
+			for (uint32_t j = 0; j < rids.size(); j += 2) {
+				data->owner.free(rids[j]);
+				if (data->owner.get_or_null(rids[j])) {
+					data->errors.increment();
+				}
+			}
+			LocalVector<RID> kept;
+			for (uint32_t j = 1; j < rids.size(); j += 2) {
+				kept.push_back(rids[j]);
+			}
+			rids = kept;
+		}
+	}
+	for (const RID &rid : rids) {
+		data->owner.free(rid);
+	}
+}
+
+TEST_CASE("[RID_Owner] Create, query and free from several threads") {
+	ThreadedRIDs data;
+	data.iterations = 2048;
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(create_query_free_rids, &data, 16, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK(data.errors.get() == 0);
+	CHECK(data.owner.get_rid_count() == 0);
+}
 } // namespace TestRID
 
 #endif // TEST_RID_H
@@ -0,0 +1,162 @@
+/**************************************************************************/
+/*  test_swiss_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SWISS_HASH_MAP_H
+#define TEST_SWISS_HASH_MAP_H
+
+#include "core/templates/hash_map.h"
+#include "core/templates/swiss_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSwissHashMap {
+
+TEST_CASE("[SwissHashMap] Insert element") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Overwrite element") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[SwissHashMap] Erase via element") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Erase via key") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.erase(42);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Replace key") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(0, 12934);
+	CHECK(map.replace_key(0, 1));
+	CHECK(map.has(1));
+	CHECK(!map.has(0));
+	CHECK(map[1] == 12934);
+	CHECK(!map.replace_key(0, 2));
+	CHECK(!map.replace_key(1, 42));
+}
+
+TEST_CASE("[SwissHashMap] Insert, erase and lookup many elements") {
+	const int elem_max = 12343;
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(i, i * 3);
+	}
+
+	// Insertion order should have been kept.
+	int idx = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.key == idx);
+		CHECK(E.value == idx * 3);
+		idx++;
+	}
+	CHECK(idx == elem_max);
+
+	for (int i = 0; i < elem_max; i++) {
+		if ((i % 5) != 0) {
+			map.erase(i);
+		}
+	}
+	CHECK(map.size() == (uint32_t)(elem_max + 4) / 5);
+
+	for (int i = 0; i < elem_max; i++) {
+		CHECK(map.has(i) == ((i % 5) == 0));
+	}
+
+	// Reinserting after erasing reuses the deleted slots.
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(i, i);
+	}
+	CHECK(map.size() == (uint32_t)elem_max);
+	for (int i = 0; i < elem_max; i++) {
+		CHECK(map[i] == i);
+	}
+}
+
+TEST_CASE("[SwissHashMap] String keys") {
+	SwissHashMap<String, int> map;
+	for (int i = 0; i < 1000; i++) {
+		map[itos(i)] = i;
+	}
+	CHECK(map.size() == 1000);
+	for (int i = 0; i < 1000; i++) {
+		CHECK(map.has(itos(i)));
+		CHECK(map[itos(i)] == i);
+	}
+	CHECK(!map.has("1000"));
+}
+
+TEST_CASE("[SwissHashMap] Copy and clear") {
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, i + 1);
+	}
+
+	const SwissHashMap<int, int> copy = map;
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(!map.has(5));
+
+	CHECK(copy.size() == 100);
+	int idx = 0;
+	for (const KeyValue<int, int> &E : copy) {
+		CHECK(E.key == idx);
+		CHECK(E.value == idx + 1);
+		idx++;
+	}
+}
+
+} // namespace TestSwissHashMap
+
+#endif // TEST_SWISS_HASH_MAP_H
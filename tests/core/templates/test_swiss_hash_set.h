@@ -0,0 +1,117 @@
+/**************************************************************************/
+/*  test_swiss_hash_set.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SWISS_HASH_SET_H
+#define TEST_SWISS_HASH_SET_H
+
+#include "core/templates/hash_set.h"
+#include "core/templates/swiss_hash_set.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSwissHashSet {
+
+TEST_CASE("[SwissHashSet] Insert element") {
+	SwissHashSet<int> set;
+	SwissHashSet<int>::Iterator e = set.insert(42);
+
+	CHECK(e);
+	CHECK(*e == 42);
+	CHECK(set.has(42));
+	CHECK(set.find(42));
+	set.reset();
+	CHECK(!set.has(42));
+}
+
+TEST_CASE("[SwissHashSet] Insert existing element") {
+	SwissHashSet<int> set;
+	set.insert(42);
+	set.insert(42);
+
+	CHECK(set.has(42));
+	CHECK(set.size() == 1);
+}
+
+TEST_CASE("[SwissHashSet] Insert, iterate and remove many elements") {
+	const int elem_max = 12343;
+	SwissHashSet<int> set;
+	for (int i = 0; i < elem_max; i++) {
+		set.insert(i);
+	}
+
+	// Insertion order should have been kept.
+	int idx = 0;
+	for (const int &K : set) {
+		CHECK(idx == K);
+		idx++;
+	}
+	CHECK(idx == elem_max);
+
+	for (int i = 0; i < elem_max; i++) {
+		if ((i % 5) == 0) {
+			set.erase(i);
+		}
+	}
+
+	CHECK(set.size() == (uint32_t)(elem_max - (elem_max + 4) / 5));
+	for (int i = 0; i < elem_max; i++) {
+		CHECK(set.has(i) == ((i % 5) != 0));
+	}
+
+	// Erasing moves the last key into the gap, every key must still be reachable.
+	int count = 0;
+	for (const int &K : set) {
+		CHECK(set.find(K));
+		CHECK(*set.find(K) == K);
+		count++;
+	}
+	CHECK(count == (int)set.size());
+}
+
+TEST_CASE("[SwissHashSet] Copy and clear") {
+	SwissHashSet<String> set;
+	for (int i = 0; i < 100; i++) {
+		set.insert(itos(i));
+	}
+
+	const SwissHashSet<String> copy = set;
+	set.clear();
+	CHECK(set.is_empty());
+	CHECK(!set.has("5"));
+
+	CHECK(copy.size() == 100);
+	for (int i = 0; i < 100; i++) {
+		CHECK(copy.has(itos(i)));
+	}
+}
+
+} // namespace TestSwissHashSet
+
+#endif // TEST_SWISS_HASH_SET_H
@@ -106,6 +106,99 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static SafeNumeric<uint32_t> sequence;
+static LocalVector<uint32_t> order;
+
+static void static_sequence_test(void *p_arg) {
+	order[(uintptr_t)p_arg] = sequence.postincrement();
+}
+static void static_sequence_group_test(void *p_arg, uint32_t p_index) {
+	uint32_t seq = sequence.postincrement();
+	if (p_index == 0) {
+		order[(uintptr_t)p_arg] = seq;
+	}
+}
+TEST_CASE("[WorkerThreadPool] Run tasks after their dependencies") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const bool low_priority = Math::rand() % 2;
+		sequence.set(0);
+		order.clear();
+		order.resize(4);
+
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		WorkerThreadPool::TaskID first = pool->add_native_task(static_sequence_test, (void *)0, !low_priority);
+		Vector<WorkerThreadPool::TaskID> deps;
+		deps.push_back(first);
+		WorkerThreadPool::GroupID group = pool->add_native_group_task_with_dependencies(deps, static_sequence_group_test, (void *)1, 16, -1, !low_priority);
+		deps.clear();
+		deps.push_back(group);
+		WorkerThreadPool::TaskID second = pool->add_native_task_with_dependencies(deps, static_sequence_test, (void *)2, !low_priority);
+		deps.push_back(second);
+		WorkerThreadPool::TaskID third = pool->add_native_task_with_dependencies(deps, static_sequence_test, (void *)3, low_priority);
+
+		pool->wait_for_task_completion(third);
+		pool->wait_for_task_completion(second);
+		pool->wait_for_group_task_completion(group);
+		pool->wait_for_task_completion(first);
+
+		CHECK(sequence.get() == 19);
+		CHECK(order[0] == 0);
+		CHECK(order[1] >= 1);
+		CHECK(order[2] == 17);
+		CHECK(order[3] == 18);
+	}
+}
+
+static void static_child_test(void *p_arg) {
+	counter[(uintptr_t)p_arg].increment();
+}
+static void static_parent_test(void *p_arg) {
+	const int count = (intptr_t)p_arg;
+	for (int i = 1; i < count; i++) {
+		WorkerThreadPool::get_singleton()->add_native_child_task(static_child_test, (void *)(uintptr_t)i);
+	}
+}
+TEST_CASE("[WorkerThreadPool] Complete parent tasks after their children") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(1.0f, 6.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(count);
+		WorkerThreadPool::TaskID parent = WorkerThreadPool::get_singleton()->add_native_task(static_parent_test, (void *)(intptr_t)count, !low_priority);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(parent);
+
+		bool all_run_once = true;
+		for (int i = 1; i < count; i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+}
+
+static void static_memory_tag_group_test(void *p_arg, uint32_t p_index) {
+	if (Memory::get_thread_tag() != Memory::TAG_PHYSICS) {
+		((SafeNumeric<uint32_t> *)p_arg)->increment();
+	}
+}
+TEST_CASE("[WorkerThreadPool] Tasks use the memory tag of the thread that added them") {
+	SafeNumeric<uint32_t> mismatches;
+	WorkerThreadPool::GroupID group;
+	{
+		MemoryTagScope tag(Memory::TAG_PHYSICS);
+		group = WorkerThreadPool::get_singleton()->add_native_group_task(static_memory_tag_group_test, &mismatches, 64, -1, true);
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+#ifdef DEBUG_ENABLED
+	CHECK(mismatches.get() == 0);
+#else
+	// Tags are compiled out of release builds.
+	CHECK(mismatches.get() == 64);
+#endif
+	CHECK(Memory::get_thread_tag() == Memory::TAG_DEFAULT);
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
@@ -32,6 +32,7 @@
 #define TEST_NODE_H
 
 #include "scene/main/node.h"
+#include "scene/main/node_path_accessor.h"
 
 #include "tests/test_macros.h"
 
@@ -762,6 +763,40 @@ TEST_CASE("[SceneTree][Node] Test the process priority") {
 	memdelete(node4);
 }
 
+TEST_CASE("[SceneTree][Node] Node path accessors follow tree changes") {
+	Node *node = memnew(Node);
+	Node *child = memnew(Node);
+	child->set_name("Child");
+	node->add_child(child);
+	SceneTree::get_singleton()->get_root()->add_child(node);
+
+	NodePathAccessor accessor(NodePath("Child:process_priority"));
+	CHECK(accessor.get_target(node) == child);
+
+	bool valid = false;
+	accessor.set(child, 3, &valid);
+	CHECK(valid);
+	CHECK(child->get_process_priority() == 3);
+	CHECK(int(accessor.get(accessor.get_target(node))) == 3);
+
+	// Renaming changes the tree version, so the path is resolved again.
+	Node *other = memnew(Node);
+	child->set_name("Previous");
+	other->set_name("Child");
+	node->add_child(other);
+	CHECK(accessor.get_target(node) == other);
+
+	node->remove_child(other);
+	CHECK(accessor.get_target(node) == nullptr);
+	memdelete(other);
+
+	// Empty names point to the node itself.
+	NodePathAccessor own(NodePath(":process_priority"));
+	CHECK(own.get_target(node) == node);
+
+	memdelete(node);
+}
+
 } // namespace TestNode
 
 #endif // TEST_NODE_H
@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "core/config/project_settings.h"
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+struct TestWorld {
+	RID space;
+	RID shape;
+	RID ground_shape;
+	LocalVector<RID> bodies;
+
+	TestWorld(real_t p_offset) {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		shape = ps->circle_shape_create();
+		ps->shape_set_data(shape, 8.0);
+
+		ground_shape = ps->world_boundary_shape_create();
+		Array ground_data;
+		ground_data.push_back(Vector2(0, -1));
+		ground_data.push_back(-100.0);
+		ps->shape_set_data(ground_shape, ground_data);
+		RID ground = ps->body_create();
+		ps->body_set_mode(ground, PhysicsServer2D::BODY_MODE_STATIC);
+		ps->body_add_shape(ground, ground_shape);
+		ps->body_set_space(ground, space);
+		bodies.push_back(ground);
+
+		for (int i = 0; i < 8; i++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+			ps->body_add_shape(body, shape);
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(p_offset + i * 3.0, -i * 20.0)));
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+	}
+
+	~TestWorld() {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		for (const RID &rid : bodies) {
+			ps->free(rid);
+		}
+		ps->free(shape);
+		ps->free(ground_shape);
+		ps->free(space);
+	}
+};
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Deterministic simulation produces matching state hashes") {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	ProjectSettings::get_singleton()->set_setting("physics/2d/solver/deterministic", true);
+	ProjectSettings::get_singleton()->set_setting("physics/2d/solver/fixed_point_integration", true);
+
+	TestWorld world_a(0.0);
+	TestWorld world_b(0.0);
+	TestWorld world_c(1.0);
+
+	CHECK(ps->space_get_state_hash(world_a.space) == ps->space_get_state_hash(world_b.space));
+
+	for (int i = 0; i < 120; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	const uint32_t hash_a = ps->space_get_state_hash(world_a.space);
+	CHECK_MESSAGE(hash_a == ps->space_get_state_hash(world_b.space), "Identical spaces should have identical state after stepping.");
+	CHECK_MESSAGE(hash_a != ps->space_get_state_hash(world_c.space), "Spaces with different initial conditions should have different state.");
+
+	ProjectSettings::get_singleton()->set_setting("physics/2d/solver/deterministic", false);
+	ProjectSettings::get_singleton()->set_setting("physics/2d/solver/fixed_point_integration", false);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer2D] State hash of an invalid space") {
+	ERR_PRINT_OFF;
+	CHECK(PhysicsServer2D::get_singleton()->space_get_state_hash(RID()) == 0);
+	ERR_PRINT_ON;
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
@@ -0,0 +1,509 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/config/project_settings.h"
+#include "servers/physics_3d/godot_broad_phase_3d_bvh.h"
+#include "servers/physics_3d/godot_collision_solver_3d.h"
+#include "servers/physics_3d/godot_space_3d.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// Fast, small bodies of different shapes flying at a wall thinner than the distance they travel in one step.
+struct BulletWorld {
+	enum WallType {
+		WALL_BOX,
+		WALL_CONCAVE,
+		// A heavy box flying at the bullets. Segment casts against where it will be at the end of the step miss
+		// the bullets it crosses in the middle of the step.
+		WALL_MOVING,
+	};
+
+	static constexpr real_t WALL_X = 5.0;
+	static constexpr real_t MOVING_WALL_X = 31.0;
+	static constexpr real_t MOVING_WALL_SPEED = 300.0;
+	static constexpr real_t WALL_HALF_THICKNESS = 0.05;
+	static constexpr real_t SPEED = 600.0; // 10 units per step at 60 ticks per second.
+
+	RID space;
+	RID wall_shape;
+	LocalVector<RID> bullet_shapes;
+	RID wall;
+	LocalVector<RID> bullets;
+
+	BulletWorld(WallType p_wall, int p_bullets_per_shape = 16) {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		if (p_wall == WALL_CONCAVE) {
+			// A single sided sheet of triangles, which has no thickness at all.
+			PackedVector3Array faces;
+			const Vector3 corners[4] = { Vector3(0, -20, -20), Vector3(0, 20, -20), Vector3(0, 20, 20), Vector3(0, -20, 20) };
+			const int indices[6] = { 0, 1, 2, 0, 2, 3 };
+			for (int i = 0; i < 6; i++) {
+				faces.push_back(corners[indices[i]]);
+			}
+			Dictionary wall_data;
+			wall_data["faces"] = faces;
+			wall_data["backface_collision"] = true;
+			wall_shape = ps->concave_polygon_shape_create();
+			ps->shape_set_data(wall_shape, wall_data);
+		} else {
+			wall_shape = ps->box_shape_create();
+			ps->shape_set_data(wall_shape, Vector3(WALL_HALF_THICKNESS, 20, 20));
+		}
+		wall = ps->body_create();
+		ps->body_add_shape(wall, wall_shape);
+		if (p_wall == WALL_MOVING) {
+			ps->body_set_mode(wall, PhysicsServer3D::BODY_MODE_RIGID);
+			ps->body_set_param(wall, PhysicsServer3D::BODY_PARAM_MASS, 1000.0);
+			ps->body_set_param(wall, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+			ps->body_set_enable_continuous_collision_detection(wall, true);
+			ps->body_set_state(wall, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(MOVING_WALL_X, 0, 0)));
+			ps->body_set_state(wall, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(-MOVING_WALL_SPEED, 0, 0));
+		} else {
+			ps->body_set_mode(wall, PhysicsServer3D::BODY_MODE_STATIC);
+			ps->body_set_state(wall, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(WALL_X, 0, 0)));
+		}
+		ps->body_set_space(wall, space);
+
+		RID sphere = ps->sphere_shape_create();
+		ps->shape_set_data(sphere, 0.1);
+		bullet_shapes.push_back(sphere);
+
+		RID box = ps->box_shape_create();
+		ps->shape_set_data(box, Vector3(0.1, 0.1, 0.1));
+		bullet_shapes.push_back(box);
+
+		RID capsule = ps->capsule_shape_create();
+		Dictionary capsule_data;
+		capsule_data["radius"] = 0.05;
+		capsule_data["height"] = 0.4;
+		ps->shape_set_data(capsule, capsule_data);
+		bullet_shapes.push_back(capsule);
+
+		for (uint32_t s = 0; s < bullet_shapes.size(); s++) {
+			for (int i = 0; i < p_bullets_per_shape; i++) {
+				RID bullet = ps->body_create();
+				ps->body_set_mode(bullet, PhysicsServer3D::BODY_MODE_RIGID);
+				ps->body_add_shape(bullet, bullet_shapes[s]);
+				ps->body_set_param(bullet, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+				ps->body_set_enable_continuous_collision_detection(bullet, true);
+				// Spread out along the wall, and at different distances from it.
+				Vector3 position(-0.37 * (i % 16), s * 12.0 - 12.0 + (i / 32) * 0.5, (i % 32) - 16);
+				ps->body_set_state(bullet, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), position));
+				ps->body_set_state(bullet, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(SPEED, 0, 0));
+				ps->body_set_space(bullet, space);
+				bullets.push_back(bullet);
+			}
+		}
+	}
+
+	~BulletWorld() {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		for (const RID &rid : bullets) {
+			ps->free(rid);
+		}
+		ps->free(wall);
+		for (const RID &rid : bullet_shapes) {
+			ps->free(rid);
+		}
+		ps->free(wall_shape);
+		ps->free(space);
+	}
+
+	int count_tunneled() const {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		real_t wall_x = Transform3D(ps->body_get_state(wall, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin.x;
+		int count = 0;
+		for (const RID &bullet : bullets) {
+			Transform3D transform = ps->body_get_state(bullet, PhysicsServer3D::BODY_STATE_TRANSFORM);
+			if (transform.origin.x > wall_x) {
+				count++;
+			}
+		}
+		return count;
+	}
+
+	int run(int p_steps) {
+		int tunneled = 0;
+		for (int i = 0; i < p_steps; i++) {
+			PhysicsServer3D::get_singleton()->step(1.0 / 60.0);
+			tunneled = MAX(tunneled, count_tunneled());
+		}
+		return tunneled;
+	}
+};
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Speculative contacts stop fast bodies at thin walls") {
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/speculative_contacts", true);
+
+	SUBCASE("Box wall") {
+		BulletWorld world(BulletWorld::WALL_BOX);
+		CHECK_MESSAGE(world.run(30) == 0, "No body should pass through the wall.");
+	}
+
+	SUBCASE("Concave wall") {
+		BulletWorld world(BulletWorld::WALL_CONCAVE);
+		CHECK_MESSAGE(world.run(30) == 0, "No body should pass through the wall.");
+	}
+
+	SUBCASE("Moving wall") {
+		BulletWorld world(BulletWorld::WALL_MOVING);
+		CHECK_MESSAGE(world.run(30) == 0, "No body should pass through the wall.");
+	}
+
+	SUBCASE("Moving wall, without speculative contacts") {
+		// The control, the segment casts done otherwise can't stop bodies that cross in the middle of the step.
+		ProjectSettings::get_singleton()->set_setting("physics/3d/solver/speculative_contacts", false);
+		BulletWorld world(BulletWorld::WALL_MOVING);
+		CHECK_MESSAGE(world.run(30) > 0, "Some bodies should pass through the wall.");
+	}
+
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/speculative_contacts", false);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Only inactive rigid bodies move to the sleeping broadphase tree") {
+	ProjectSettings::get_singleton()->set_setting("physics/3d/broadphase/separate_sleeping_bodies", true);
+
+	GodotSpace3D *space = memnew(GodotSpace3D);
+	GodotBroadPhase3DBVH *broadphase = static_cast<GodotBroadPhase3DBVH *>(space->get_broadphase());
+	GodotBoxShape3D shape;
+	shape.set_data(Vector3(0.5, 0.5, 0.5));
+
+	GodotBody3D *body = memnew(GodotBody3D);
+	body->add_shape(&shape);
+	body->set_space(space);
+	body->set_mode(PhysicsServer3D::BODY_MODE_RIGID);
+	const GodotBroadPhase3D::ID id = body->get_shape_broadphase_id(0);
+	REQUIRE(id != 0);
+
+	SUBCASE("Rigid body") {
+		body->set_active(false);
+		CHECK_FALSE_MESSAGE(broadphase->is_sleeping(id), "Trees should only change when the broadphase is updated.");
+		broadphase->update();
+		CHECK(broadphase->is_sleeping(id));
+
+		GodotCollisionObject3D *results[4];
+		CHECK_MESSAGE(broadphase->cull_aabb(AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)), results, 4) == 1, "Sleeping bodies should still be found by queries.");
+
+		body->set_active(true);
+		broadphase->update();
+		CHECK_FALSE(broadphase->is_sleeping(id));
+	}
+
+	SUBCASE("Kinematic body") {
+		body->set_active(false);
+		broadphase->update();
+		REQUIRE(broadphase->is_sleeping(id));
+
+		body->set_mode(PhysicsServer3D::BODY_MODE_KINEMATIC);
+		broadphase->update();
+		CHECK_MESSAGE(!broadphase->is_sleeping(id), "A sleeping rigid body turned kinematic should wake up.");
+
+		// Without contacts, kinematic bodies are inactive, but they can still move at any time.
+		body->set_active(true);
+		body->set_active(false);
+		broadphase->update();
+		CHECK_FALSE(broadphase->is_sleeping(id));
+		CHECK_FALSE(broadphase->is_static(id));
+	}
+
+	SUBCASE("Static body") {
+		body->set_active(false);
+		body->set_mode(PhysicsServer3D::BODY_MODE_STATIC);
+		broadphase->update();
+		CHECK(broadphase->is_static(id));
+		CHECK_FALSE(broadphase->is_sleeping(id));
+	}
+
+	body->set_space(nullptr);
+	body->remove_shape(0);
+	memdelete(body);
+	memdelete(space);
+
+	ProjectSettings::get_singleton()->set_setting("physics/3d/broadphase/separate_sleeping_bodies", false);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Static broadphase layouts can be saved and restored") {
+	const int GRID_SIZE = 8;
+	GodotBody3D owner;
+	GodotBroadPhase3DBVH *broadphases[2] = { memnew(GodotBroadPhase3DBVH), memnew(GodotBroadPhase3DBVH) };
+	LocalVector<GodotBroadPhase3D::ID> ids[2];
+	LocalVector<AABB> aabbs;
+	for (int i = 0; i < GRID_SIZE * GRID_SIZE * GRID_SIZE; i++) {
+		Vector3 position(i % GRID_SIZE, (i / GRID_SIZE) % GRID_SIZE, i / (GRID_SIZE * GRID_SIZE));
+		aabbs.push_back(AABB(position * 2.0 + Vector3(0.1 * (i % 3), 0, 0), Vector3(1, 1, 1)));
+		for (int b = 0; b < 2; b++) {
+			ids[b].push_back(broadphases[b]->create(&owner, i, aabbs[i], true));
+		}
+	}
+	for (int b = 0; b < 2; b++) {
+		broadphases[b]->update();
+	}
+
+	const Vector<uint8_t> layout = broadphases[0]->rebuild_static(Vector<uint8_t>());
+	REQUIRE(layout.size() > 8);
+	CHECK_MESSAGE(broadphases[0]->rebuild_static(layout) == layout, "Rebuilding from a saved layout should give the same layout.");
+	CHECK_MESSAGE(broadphases[1]->rebuild_static(layout) == layout, "Another broadphase with the same items should restore the same layout.");
+
+	// The restored tree still finds every item.
+	int missing = 0;
+	GodotCollisionObject3D *results[32];
+	int subindices[32];
+	for (uint32_t i = 0; i < aabbs.size(); i++) {
+		int count = broadphases[1]->cull_aabb(aabbs[i], results, 32, subindices);
+		bool found = false;
+		for (int j = 0; j < count; j++) {
+			found = found || subindices[j] == (int)i;
+		}
+		missing += found ? 0 : 1;
+	}
+	CHECK(missing == 0);
+
+	Vector<uint8_t> broken = layout;
+	broken.write[0] ^= 0xFF;
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(broadphases[1]->rebuild_static(broken).is_empty(), "A layout with the wrong version should be rejected.");
+	broken = layout;
+	broken.resize(layout.size() - 4);
+	CHECK_MESSAGE(broadphases[1]->rebuild_static(broken).is_empty(), "A truncated layout should be rejected.");
+	ERR_PRINT_ON;
+
+	for (int b = 0; b < 2; b++) {
+		for (GodotBroadPhase3D::ID id : ids[b]) {
+			broadphases[b]->remove(id);
+		}
+		memdelete(broadphases[b]);
+	}
+}
+
+static void _collect_contact(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
+	LocalVector<Vector3> *points = static_cast<LocalVector<Vector3> *>(p_userdata);
+	points->push_back(p_point_A);
+	points->push_back(p_point_B);
+}
+
+// Colliding the gathered faces in small batches should give the same contacts, in the same order, as solve_static().
+static void check_face_batches(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B) {
+	LocalVector<Vector3> expected;
+	bool expected_collided = GodotCollisionSolver3D::solve_static(p_shape_A, p_transform_A, p_shape_B, p_transform_B, _collect_contact, &expected);
+	CHECK(expected_collided);
+
+	LocalVector<GodotCollisionSolver3D::ConcaveFace> faces;
+	bool swap = false;
+	REQUIRE(GodotCollisionSolver3D::gather_concave_faces(p_shape_A, p_transform_A, p_shape_B, p_transform_B, faces, swap));
+	CHECK(swap == p_shape_A->is_concave());
+	CHECK_MESSAGE(faces.size() > 32, "The convex shape should cover enough faces to be split into batches.");
+
+	const GodotShape3D *convex = swap ? p_shape_B : p_shape_A;
+	const Transform3D &transform_convex = swap ? p_transform_B : p_transform_A;
+	const Transform3D &transform_concave = swap ? p_transform_A : p_transform_B;
+
+	LocalVector<Vector3> batched;
+	bool collided = false;
+	const uint32_t faces_per_batch = 7;
+	for (uint32_t first = 0; first < faces.size(); first += faces_per_batch) {
+		uint32_t count = MIN(faces_per_batch, faces.size() - first);
+		if (GodotCollisionSolver3D::solve_concave_faces(convex, transform_convex, faces.ptr() + first, count, transform_concave, _collect_contact, &batched, swap)) {
+			collided = true;
+		}
+	}
+	CHECK(collided == expected_collided);
+
+	REQUIRE(batched.size() == expected.size());
+	int mismatched = 0;
+	for (uint32_t i = 0; i < expected.size(); i++) {
+		if (batched[i] != expected[i]) {
+			mismatched++;
+		}
+	}
+	CHECK_MESSAGE(mismatched == 0, "Batched contacts should match solve_static().");
+}
+
+static real_t _bumpy_height(int p_x, int p_z) {
+	return Math::sin(p_x * 0.7) * Math::cos(p_z * 0.4) * 0.2;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Concave faces collided in batches give the same contacts as solve_static") {
+	const int cells = 16;
+
+	GodotConcavePolygonShape3D trimesh;
+	{
+		PackedVector3Array faces;
+		for (int z = 0; z < cells; z++) {
+			for (int x = 0; x < cells; x++) {
+				Vector3 corners[4];
+				for (int i = 0; i < 4; i++) {
+					int cx = x + (i & 1);
+					int cz = z + (i >> 1);
+					corners[i] = Vector3(cx - cells * 0.5, _bumpy_height(cx, cz), cz - cells * 0.5);
+				}
+				faces.push_back(corners[0]);
+				faces.push_back(corners[1]);
+				faces.push_back(corners[2]);
+				faces.push_back(corners[1]);
+				faces.push_back(corners[3]);
+				faces.push_back(corners[2]);
+			}
+		}
+		Dictionary data;
+		data["faces"] = faces;
+		data["backface_collision"] = false;
+		trimesh.set_data(data);
+	}
+
+	GodotHeightMapShape3D heightmap;
+	{
+		PackedRealArray heights;
+		for (int z = 0; z <= cells; z++) {
+			for (int x = 0; x <= cells; x++) {
+				heights.push_back(_bumpy_height(x, z));
+			}
+		}
+		Dictionary data;
+		data["width"] = cells + 1;
+		data["depth"] = cells + 1;
+		data["heights"] = heights;
+		data["min_height"] = -0.2;
+		data["max_height"] = 0.2;
+		heightmap.set_data(data);
+	}
+
+	GodotBoxShape3D box;
+	box.set_data(Vector3(3, 0.5, 3));
+	GodotSphereShape3D sphere;
+	sphere.set_data(4.0);
+
+	const Transform3D concave_transform;
+	const Transform3D box_transform(Basis(Vector3(0, 1, 0), 0.3), Vector3(0.2, 0.45, -0.3));
+	const Transform3D sphere_transform(Basis(), Vector3(0.2, 3.9, -0.3));
+
+	SUBCASE("Concave polygon") {
+		check_face_batches(&box, box_transform, &trimesh, concave_transform);
+		check_face_batches(&trimesh, concave_transform, &box, box_transform);
+		check_face_batches(&sphere, sphere_transform, &trimesh, concave_transform);
+	}
+
+	SUBCASE("Heightmap") {
+		check_face_batches(&box, box_transform, &heightmap, concave_transform);
+		check_face_batches(&heightmap, concave_transform, &box, box_transform);
+		check_face_batches(&sphere, sphere_transform, &heightmap, concave_transform);
+	}
+
+	SUBCASE("Face test cost") {
+		GodotConvexPolygonShape3D convex;
+		PackedVector3Array points;
+		for (int i = 0; i < 32; i++) {
+			points.push_back(Vector3(Math::cos(i * Math_TAU / 16), (i / 16) * 2 - 1, Math::sin(i * Math_TAU / 16)));
+		}
+		convex.set_data(points);
+		CHECK(GodotCollisionSolver3D::get_face_test_cost(&sphere) < GodotCollisionSolver3D::get_face_test_cost(&box));
+		CHECK_MESSAGE(GodotCollisionSolver3D::get_face_test_cost(&box) < GodotCollisionSolver3D::get_face_test_cost(&convex), "Detailed convex shapes should be split into smaller batches.");
+	}
+}
+
+static PackedVector3Array get_contacts(RID p_body) {
+	PhysicsDirectBodyState3D *state = PhysicsServer3D::get_singleton()->body_get_direct_state(p_body);
+	PackedVector3Array points;
+	for (int i = 0; i < state->get_contact_count(); i++) {
+		points.push_back(state->get_contact_local_position(i));
+		points.push_back(state->get_contact_collider_position(i));
+	}
+	return points;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Cached contacts are refreshed when shapes move or change") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID ground_shape = ps->box_shape_create();
+	ps->shape_set_data(ground_shape, Vector3(10, 1, 10));
+	RID ground = ps->body_create();
+	ps->body_set_mode(ground, PhysicsServer3D::BODY_MODE_STATIC);
+	ps->body_add_shape(ground, ground_shape);
+	ps->body_set_state(ground, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+	ps->body_set_space(ground, space);
+
+	// A body held in place, so nothing moves and the pair keeps its cached contacts from step to step.
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID box = ps->body_create();
+	ps->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+	ps->body_add_shape(box, box_shape);
+	ps->body_set_param(box, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+	ps->body_set_state(box, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+	for (int i = 0; i < 6; i++) {
+		ps->body_set_axis_lock(box, PhysicsServer3D::BodyAxis(1 << i), true);
+	}
+	ps->body_set_max_contacts_reported(box, 8);
+	ps->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 0.45, 0)));
+	ps->body_set_space(box, space);
+
+	for (int i = 0; i < 3; i++) {
+		ps->step(1.0 / 60.0);
+	}
+	PackedVector3Array contacts = get_contacts(box);
+	REQUIRE(contacts.size() > 0);
+	CHECK(Transform3D(ps->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin == Vector3(0, 0.45, 0));
+
+	ps->step(1.0 / 60.0);
+	CHECK_MESSAGE(get_contacts(box) == contacts, "Contacts shouldn't change while nothing moves.");
+
+	// Same shape and transforms, but the shape data changed.
+	ps->shape_set_data(ground_shape, Vector3(10, 1.02, 10));
+	ps->step(1.0 / 60.0);
+	PackedVector3Array grown_contacts = get_contacts(box);
+	REQUIRE(grown_contacts.size() > 0);
+	CHECK_MESSAGE(grown_contacts != contacts, "Changing the shape should invalidate the cached contacts.");
+
+	ps->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 0.4, 0)));
+	ps->step(1.0 / 60.0);
+	PackedVector3Array moved_contacts = get_contacts(box);
+	REQUIRE(moved_contacts.size() > 0);
+	CHECK_MESSAGE(moved_contacts != grown_contacts, "Moving a body should invalidate the cached contacts.");
+
+	ps->free(box);
+	ps->free(ground);
+	ps->free(box_shape);
+	ps->free(ground_shape);
+	ps->free(space);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H